@@ -45,10 +45,31 @@ void App_Hook_TaskIdle(void)
 
 }
 
+/* Print the list items in order by taking them from the head, Then put them back.
+ * This works for both the sorted linked list and the heap (OS_CONFIG_LIST_HEAP_EN). */
+static void
+list_Print(List* list)
+{
+	List_Item* items[20];
+	long count = 0;
+
+	while(list->head)
+	{
+		items[count] = list->head;
+		printf("%d ", items[count]->itemVal);
+		ListItemRemove(items[count++]);
+	}
+
+	while(count > 0)
+	{
+		listItemInsert(list, items[--count]);
+	}
+}
+
 int main()
 {
 	List orderedQueue;
-	List_Item* pListItem, *pListTemp;
+	List_Item* pListItem;
 	List_Item item[20];
 
 	for(long i = 0; i < 20; i++)
@@ -66,13 +87,7 @@ int main()
 
 	printf("List: ");
 
-	pListItem = orderedQueue.head;
-
-	for(;pListItem;)
-	{
-		printf("%d ", pListItem->itemVal);
-		pListItem = pListItem->next;
-	}
+	list_Print(&orderedQueue);
 
 	printf("\n");
 	printf("Removing List[5] = %d\n",item[5].itemVal);
@@ -89,38 +104,22 @@ int main()
 
 	printf("List: ");
 
-	pListItem = orderedQueue.head;
-
-	for(;pListItem;)
-	{
-		printf("%d ", pListItem->itemVal);
-		pListItem = pListItem->next;
-	}
+	list_Print(&orderedQueue);
 
 	printf("\n");
 
 	printf("Remove all\n");
 
-	pListItem = orderedQueue.head;
-
 	for(;orderedQueue.head;)
 	{
-		if(pListItem)
-			printf("Removed %d\n",pListItem->itemVal);
-		pListTemp = pListItem->next;
+		pListItem = orderedQueue.head;
+		printf("Removed %d\n",pListItem->itemVal);
 		ListItemRemove(pListItem);
-		pListItem = pListTemp;
 	}
 
 	printf("List: ");
 
-	pListItem = orderedQueue.head;
-
-	for(;pListItem;)
-	{
-		printf("%d ", pListItem->itemVal);
-		pListItem = pListItem->next;
-	}
+	list_Print(&orderedQueue);
 
 	printf("\n");
 }
@@ -0,0 +1,178 @@
+/*****************************************************************************
+MIT License
+
+Copyright (c) 2020 Yahia Farghaly Ashour
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+/*
+ * Author   : 	Yahia Farghaly Ashour
+ *
+ * Purpose  : 	This example shows the admission test of the EDF scheduler at the task creation.
+ * 				Make sure you set OS_CONFIG_EDF_EN and OS_CONFIG_TASK_ADMISSION_EN to OS_CONFIG_ENABLE.
+ *
+				 +-----------------+
+				 | tsk |  T  |  C  |		T is the period (= the relative deadline) of the task.
+				 +-----+-----+-----|		C is the worst case execution time given to OS_TaskCreate().
+				 | T_1 |  4  |  2  |
+				 | T_2 |  8  |  2  |		The unit of time here is second.
+				 | T_3 |  8  |  3  |
+				 | T_4 | 16  |  4  |
+				 +-----------------+
+ *
+ *				EDF meets all the deadlines as long as U = Sum(C/T) doesn't exceed 1.
+ *				T_3 is refused with OS_ERR_TASK_NOT_SCHEDULABLE, U would be 1.125.
+ *				T_4 is admitted, U = 1.0 and no deadline is missed.
+ *
+ * Language	:  	C
+ */
+
+/*
+*******************************************************************************
+*                               Includes Files                                *
+*******************************************************************************
+*/
+#include <bsp.h>
+#include <pretty_os.h>
+#include <uartstdio.h>
+
+/*
+*******************************************************************************
+*                                   Macros                                    *
+*******************************************************************************
+*/
+#define STACK_SIZE   (40U)
+#define TASKS_COUNT	 (4U)
+
+#define ExecutionLOAD(C)	do { BSP_DelayMilliseconds(C*900/OS_CONFIG_TICKS_PER_SEC); }while(0);	/* Within the WCET.	*/
+
+/*
+*******************************************************************************
+*                              Tasks Stacks                                   *
+*******************************************************************************
+*/
+
+OS_tSTACK stkTask [TASKS_COUNT][STACK_SIZE];
+
+OS_tSTACK stkTask_Idle    [STACK_SIZE];
+
+/*
+*******************************************************************************
+*                                 Globals                                     *
+*******************************************************************************
+*/
+typedef struct Task_Data
+{
+	char*   name;
+	OS_TICK T;		/* Periodicity			*/
+	OS_TICK	C;		/* Computation Power.	*/
+}tskdata;
+
+tskdata tasks[TASKS_COUNT] = {
+	{ "T_1",  4U*OS_CONFIG_TICKS_PER_SEC, 2U*OS_CONFIG_TICKS_PER_SEC },
+	{ "T_2",  8U*OS_CONFIG_TICKS_PER_SEC, 2U*OS_CONFIG_TICKS_PER_SEC },
+	{ "T_3",  8U*OS_CONFIG_TICKS_PER_SEC, 3U*OS_CONFIG_TICKS_PER_SEC },
+	{ "T_4", 16U*OS_CONFIG_TICKS_PER_SEC, 4U*OS_CONFIG_TICKS_PER_SEC },
+};
+
+/*
+*******************************************************************************
+*                              OS Hooks functions                             *
+*******************************************************************************
+*/
+
+void App_Hook_TaskIdle(void)
+{
+
+}
+
+/*
+*******************************************************************************
+*                              Tasks Definitions                              *
+*******************************************************************************
+*/
+
+void
+task_periodic(void* args) {
+
+	tskdata* t = (tskdata*)args;
+
+    while (1) {
+
+    	ExecutionLOAD(t->C);
+
+        printf("[+%05d]: %s completes a job\n",OS_TickTimeGet()/OS_CONFIG_TICKS_PER_SEC,t->name);
+
+        if(OS_Is_CurrentTaskMissedDeadline())
+        {
+        	printf(" %s missed its deadline !\n",t->name);
+        }
+
+        OS_TaskYield();
+    }
+}
+
+int main() {
+
+	CPU_t32U i;
+
+    /* Setup low level connected devices.   */
+    BSP_HardwareSetup();
+
+    /* Clear console terminal.              */
+    BSP_UART_ClearVirtualTerminal();
+
+    /* Initialize the Idle Task stack.      */
+    OS_Init(stkTask_Idle, sizeof(stkTask_Idle));
+
+    printf("[Info]: OS ticks per second: %d \n",OS_CONFIG_TICKS_PER_SEC);
+    printf("[Admission Test]:\n");
+
+    for(i = 0U; i < TASKS_COUNT; ++i)
+    {
+    	OS_TaskCreate(&task_periodic,
+    				  (void*)&tasks[i],
+					  &stkTask[i][0],
+					  sizeof(stkTask[i]),
+					  OS_TASK_PERIODIC,
+					  tasks[i].T,tasks[i].T,tasks[i].C);
+
+    	if(OS_ERRNO == OS_ERR_NONE)
+    	{
+    		printf("	%s is admitted\n", tasks[i].name);
+    	}
+    	else if(OS_ERRNO == OS_ERR_TASK_NOT_SCHEDULABLE)
+    	{
+    		printf("	%s is refused, The utilization would exceed 1\n", tasks[i].name);
+    	}
+    	else
+    	{
+    		printf("	%s is not created (%d)\n", tasks[i].name, (int)OS_ERRNO);
+    	}
+    }
+
+    printf("[Info]: OS Starts !\n\n");
+
+    /*  Transfer control to the RTOS to run the tasks.   */
+    OS_Run(BSP_CPU_FrequencyGet());
+
+    /*       Should never reach here.   */
+    for(;;);
+}
@@ -0,0 +1,189 @@
+/*****************************************************************************
+MIT License
+
+Copyright (c) 2020 Yahia Farghaly Ashour
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+/*
+ * Author   : 	Yahia Farghaly Ashour
+ *
+ * Purpose  : 	This example shows the admission test of the static priority scheduler at the task creation.
+ * 				Make sure you set OS_CONFIG_EDF_EN to OS_CONFIG_DISABLE and OS_CONFIG_TASK_ADMISSION_EN to OS_CONFIG_ENABLE.
+ *
+				 +---------------------------+
+				 | tsk | Prio |  T  |  C  |		T is the period of the task.
+				 +-----+------+-----+-----|		C is the worst case execution time given to OS_TaskCreate().
+				 | T_1 |  5   |  3  |  1  |
+				 | T_2 |  4   |  4  |  1  |		The unit of time here is second.
+				 | T_3 |  3   |  6  |  2  |
+				 | T_4 |  6   | 12  |  1  |
+				 | T_5 |  2   | 24  |  1  |
+				 +-----------------------+
+ *
+ *				T_3 is admitted by the exact response time analysis, U = 0.92 is above the utilization bound of
+ *				the first tasks but its response time is 6 = its period.
+ *				T_4 is refused with OS_ERR_TASK_NOT_SCHEDULABLE, U = 1.0 but it would preempt T_3 which then completes at 7.
+ *				T_5 is admitted at the lowest priority, Its response time is 12.
+ *
+ * Language	:  	C
+ */
+
+/*
+*******************************************************************************
+*                               Includes Files                                *
+*******************************************************************************
+*/
+#include <bsp.h>
+#include <pretty_os.h>
+#include <uartstdio.h>
+
+/*
+*******************************************************************************
+*                                   Macros                                    *
+*******************************************************************************
+*/
+#define STACK_SIZE   (40U)
+#define TASKS_COUNT	 (5U)
+
+#define ExecutionLOAD(C)	do { BSP_DelayMilliseconds(C*900/OS_CONFIG_TICKS_PER_SEC); }while(0);	/* Within the WCET.	*/
+
+/*
+*******************************************************************************
+*                              Tasks Stacks                                   *
+*******************************************************************************
+*/
+
+OS_tSTACK stkTask [TASKS_COUNT][STACK_SIZE];
+
+OS_tSTACK stkTask_Idle    [STACK_SIZE];
+
+/*
+*******************************************************************************
+*                                 Globals                                     *
+*******************************************************************************
+*/
+typedef struct Task_Data
+{
+	char*   name;
+	OS_PRIO prio;
+	OS_TICK T;		/* Periodicity			*/
+	OS_TICK	C;		/* Computation Power.	*/
+}tskdata;
+
+tskdata tasks[TASKS_COUNT] = {
+	{ "T_1", 5U,  3U*OS_CONFIG_TICKS_PER_SEC, 1U*OS_CONFIG_TICKS_PER_SEC },
+	{ "T_2", 4U,  4U*OS_CONFIG_TICKS_PER_SEC, 1U*OS_CONFIG_TICKS_PER_SEC },
+	{ "T_3", 3U,  6U*OS_CONFIG_TICKS_PER_SEC, 2U*OS_CONFIG_TICKS_PER_SEC },
+	{ "T_4", 6U, 12U*OS_CONFIG_TICKS_PER_SEC, 1U*OS_CONFIG_TICKS_PER_SEC },
+	{ "T_5", 2U, 24U*OS_CONFIG_TICKS_PER_SEC, 1U*OS_CONFIG_TICKS_PER_SEC },
+};
+
+/*
+*******************************************************************************
+*                              OS Hooks functions                             *
+*******************************************************************************
+*/
+
+void App_Hook_TaskIdle(void)
+{
+
+}
+
+/*
+*******************************************************************************
+*                              Tasks Definitions                              *
+*******************************************************************************
+*/
+
+void
+task_periodic(void* args) {
+
+	OS_TICK curr_tick = 0;
+	OS_TICK	execution_cnt = 1;
+
+	tskdata* t = (tskdata*)args;
+
+    while (1) {
+
+    	ExecutionLOAD(t->C);
+
+    	curr_tick = OS_TickTimeGet();
+
+        printf("[+%05d]: %s completes a job\n",curr_tick/OS_CONFIG_TICKS_PER_SEC,t->name);
+
+        if(curr_tick > execution_cnt * t->T)
+        {
+        	printf(" %s missed its deadline !\n",t->name);
+        }
+
+        OS_DelayTicks((execution_cnt * t->T) - curr_tick);
+    	++execution_cnt;
+    }
+}
+
+int main() {
+
+	CPU_t32U i;
+	OS_tRet  ret;
+
+    /* Setup low level connected devices.   */
+    BSP_HardwareSetup();
+
+    /* Clear console terminal.              */
+    BSP_UART_ClearVirtualTerminal();
+
+    /* Initialize the Idle Task stack.      */
+    OS_Init(stkTask_Idle, sizeof(stkTask_Idle));
+
+    printf("[Info]: OS ticks per second: %d \n",OS_CONFIG_TICKS_PER_SEC);
+    printf("[Admission Test]:\n");
+
+    for(i = 0U; i < TASKS_COUNT; ++i)
+    {
+    	ret = OS_TaskCreate(&task_periodic,
+    						(void*)&tasks[i],
+							&stkTask[i][0],
+							sizeof(stkTask[i]),
+							tasks[i].prio,
+							tasks[i].C,tasks[i].T);
+
+    	if(ret == OS_ERR_NONE)
+    	{
+    		printf("	%s is admitted\n", tasks[i].name);
+    	}
+    	else if(ret == OS_ERR_TASK_NOT_SCHEDULABLE)
+    	{
+    		printf("	%s is refused, A task would miss its deadline\n", tasks[i].name);
+    	}
+    	else
+    	{
+    		printf("	%s is not created (%d)\n", tasks[i].name, (int)ret);
+    	}
+    }
+
+    printf("[Info]: OS Starts !\n\n");
+
+    /*  Transfer control to the RTOS to run the tasks.   */
+    OS_Run(BSP_CPU_FrequencyGet());
+
+    /*       Should never reach here.   */
+    for(;;);
+}
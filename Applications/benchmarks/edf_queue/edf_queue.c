@@ -0,0 +1,212 @@
+/*****************************************************************************
+MIT License
+
+Copyright (c) 2020 Yahia Farghaly Ashour
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+/*
+ * Author   : Yahia Farghaly Ashour
+ *
+ * Purpose  : Measure the cost of the EDF ready/inactive lists for 16, 128 and 1024 periodic jobs.
+ *
+ *            A meter task replays the kernel job cycle on its own pair of lists:
+ *            The job with the earliest arrival is moved from the inactive list to the ready list by its
+ *            absolute deadline, Then the job with the earliest deadline is dispatched and moved back to the
+ *            inactive list by its next arrival. The number of such cycles per tick is printed for each
+ *            number of jobs.
+ *
+ *            Build it once with OS_CONFIG_LIST_HEAP_EN = OS_CONFIG_ENABLE and once with OS_CONFIG_DISABLE
+ *            to compare the binary heap with the sorted linked list. The heap count per tick should drop
+ *            slowly (log n) as the number of jobs grows, while the sorted list drops linearly.
+ *
+ *            Requires OS_CONFIG_EDF_EN = OS_CONFIG_ENABLE. The sizes above OS_CONFIG_TASK_COUNT are skipped,
+ *            So set OS_CONFIG_TASK_COUNT to 1024 for the largest size.
+ *
+ * Language:  C
+ */
+
+/*
+*******************************************************************************
+*                               Includes Files                                *
+*******************************************************************************
+*/
+#include <bsp.h>
+#include <pretty_os.h>
+#include <pretty_shared.h>
+#include <uartstdio.h>
+
+/*
+*******************************************************************************
+*                                   Macros                                    *
+*******************************************************************************
+*/
+#define STACK_SIZE          (256U)
+#define JOBS_MAX            (1024U)
+#define SAMPLE_TICKS        (OS_CONFIG_TICKS_PER_SEC)   /* Measurement window in ticks.                     */
+#define METER_PERIOD        (0x7FFFFFFFU)               /* The meter never yields during the measurement.   */
+
+/*
+*******************************************************************************
+*                              Tasks Stacks                                   *
+*******************************************************************************
+*/
+
+OS_tSTACK stkTask_Meter   [STACK_SIZE];
+OS_tSTACK stkTask_Idle    [STACK_SIZE];
+
+/*
+*******************************************************************************
+*                                 Globals                                     *
+*******************************************************************************
+*/
+static List         jobs_ready;
+static List         jobs_inactive;
+static List_Item    jobs_item     [JOBS_MAX];
+static OS_TICK      jobs_period   [JOBS_MAX];
+static OS_TICK      jobs_arrive   [JOBS_MAX];
+
+static const CPU_tWORD jobs_count [] = { 16U, 128U, 1024U };
+
+/*
+*******************************************************************************
+*                              OS Hooks functions                             *
+*******************************************************************************
+*/
+
+void App_Hook_TaskIdle(void)
+{
+    /*  Application idle routine.    */
+}
+
+/*
+*******************************************************************************
+*                              Tasks Definitions                              *
+*******************************************************************************
+*/
+
+static void
+jobs_Init(CPU_tWORD count) {
+    CPU_tWORD i;
+
+    list_Init(&jobs_ready);
+    list_Init(&jobs_inactive);
+
+    for (i = 0U; i < count; ++i) {
+        listItem_Init(&jobs_item[i]);
+        jobs_item[i].pOwner = (void*)&jobs_item[i];
+        jobs_period[i]      = 10U + ((i * 7919U) % 90U);        /* Periods between 10 and 99 ticks.     */
+        jobs_arrive[i]      = i % jobs_period[i];
+        jobs_item[i].itemVal = jobs_arrive[i];
+        listItemInsert(&jobs_inactive, &jobs_item[i]);
+    }
+}
+
+static void
+jobs_Cycle(void) {
+    List_Item* pitem;
+    CPU_tWORD  i;
+
+    pitem = jobs_inactive.head;                                 /* Release the earliest arrival ...     */
+    i     = (CPU_tWORD)(pitem - &jobs_item[0]);
+    ListItemRemove(pitem);
+    pitem->itemVal = jobs_arrive[i] + jobs_period[i];           /* ... by its absolute deadline.        */
+    listItemInsert(&jobs_ready, pitem);
+
+    pitem = jobs_ready.head;                                    /* Dispatch the earliest deadline ...   */
+    i     = (CPU_tWORD)(pitem - &jobs_item[0]);
+    ListItemRemove(pitem);
+    jobs_arrive[i] += jobs_period[i];                           /* ... and wait for its next arrival.   */
+    pitem->itemVal  = jobs_arrive[i];
+    listItemInsert(&jobs_inactive, pitem);
+}
+
+static unsigned long
+meter_CountPerTick(void) {
+    unsigned long count = 0U;
+    OS_TICK start;
+
+    start = OS_TickTimeGet();
+    while (OS_TickTimeGet() == start);                          /* Align to a tick edge.                */
+
+    start = OS_TickTimeGet();
+    while ((OS_TickTimeGet() - start) < SAMPLE_TICKS) {
+        jobs_Cycle();
+        ++count;
+    }
+    return (count / SAMPLE_TICKS);
+}
+
+void
+main_meterTask(void* args) {
+    CPU_tWORD idx;
+
+    (void)args;
+
+#if (OS_CONFIG_LIST_HEAP_EN == OS_CONFIG_ENABLE)
+    printf("[Info]: EDF lists are binary heaps.\n\n");
+#else
+    printf("[Info]: EDF lists are sorted linked lists.\n\n");
+#endif
+    printf("#Jobs, Cycles/Tick\n");
+
+    for (idx = 0U; idx < (sizeof(jobs_count) / sizeof(jobs_count[0])); ++idx) {
+        if (jobs_count[idx] > OS_CONFIG_TASK_COUNT) {
+            printf("%5u, skipped (OS_CONFIG_TASK_COUNT = %u)\n", jobs_count[idx], OS_CONFIG_TASK_COUNT);
+            continue;
+        }
+        jobs_Init(jobs_count[idx]);
+        printf("%5u, %10lu\n", jobs_count[idx], meter_CountPerTick());
+    }
+
+    printf("[Info]: Done.\n");
+    while (1) {
+        OS_TaskYield();
+    }
+}
+
+int main() {
+
+    /* Setup low level connected devices.   */
+    BSP_HardwareSetup();
+
+    /* Clear console terminal.              */
+    BSP_UART_ClearVirtualTerminal();
+
+    /* Initialize the Idle Task stack.      */
+    OS_Init(stkTask_Idle, sizeof(stkTask_Idle));
+
+    /* Create the meter task.               */
+    OS_TaskCreate(&main_meterTask,
+                  OS_NULL(void),
+                  stkTask_Meter,
+                  sizeof(stkTask_Meter),
+                  OS_TASK_PERIODIC,
+                  METER_PERIOD, METER_PERIOD);
+
+    printf("[Info]: OS ticks per second: %d \n",OS_CONFIG_TICKS_PER_SEC);
+    printf("[Info]: EDF list cost vs. number of periodic jobs.\n");
+
+    /*  Transfer control to the RTOS to run the tasks.   */
+    OS_Run(BSP_CPU_FrequencyGet());
+
+    /*       Should never reach here.   */
+    for(;;);
+}
@@ -0,0 +1,565 @@
+/*****************************************************************************
+MIT License
+
+Copyright (c) 2020 Yahia Farghaly Ashour
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+/*
+ * Author   : Yahia Farghaly Ashour
+ *
+ * Purpose  : A microbenchmark suite of the kernel services for the POSIX port.
+ *
+ *            A bench task at the lowest application priority drives each benchmark against worker tasks of higher
+ *            priorities, And times every iteration with OS_CPU_TimestampGet() (nanoseconds on the POSIX port):
+ *
+ *              timestamp       Two back to back timestamps, The overhead included in every other sample.
+ *              ctx_switch      OS_TaskResume() of a suspended higher priority task till it runs.
+ *              sem_pingpong    A semaphore post to a higher priority task which posts back, A round trip.
+ *              mailbox         OS_MailBoxPost() to a higher priority consumer, Per message of a batch (param).
+ *              mutex_handoff   OS_MutexPost() till the higher priority waiter owns the mutex.
+ *              flag_fanout     OS_EVENT_FlagPost() till all the N waiters (param) woke up and pend again.
+ *              memory          An OS_MemoryAllocateBlock() and OS_MemoryRestoreBlock() pair, Per pair of a batch (param).
+ *              tick            OS_TimerTick() with N delayed tasks (param), Called at task level as the tick ISR does.
+ *              task_exit       OS_TaskCreate() of a higher priority task which returns at once, Till the bench task runs again.
+ *              task_delete     OS_TaskCreate() of a higher priority task which suspends itself, And its OS_TaskDelete().
+ *              tick_dispatch   From the interrupt of a spinning task by the port tick till a task delayed for one tick runs,
+ *                              Over BENCH_TICK_SAMPLES ticks. It includes the host timer and signal delivery.
+ *                              It's followed by a comment line of the port tick lateness (OS_CPU_TickLatenessGet()).
+ *              idle_wake       The bench task delays for one tick while the other tasks are blocked, So every tick wakes
+ *                              the idle task. The wake up time of each tick less the earliest one, In phase with the tick
+ *                              period, Over BENCH_TICK_SAMPLES ticks. A lost wake up of the idle task shows as a tick period.
+ *
+ *            Each benchmark prints a line of the min/median/p99/max of its samples in nanoseconds,
+ *            As CSV or as JSON lines with BENCH_OUTPUT_JSON = 1. Compare the output of two kernel builds to see
+ *            the effect of a change. Run it on an idle host, The host scheduler noise shows in p99 and max.
+ *
+ *            Requires the POSIX port and OS_CONFIG_EDF_EN = OS_CONFIG_DISABLE.
+ *            See port/posix/README.txt for the build.
+ *
+ * Language:  C
+ */
+
+/*
+*******************************************************************************
+*                               Includes Files                                *
+*******************************************************************************
+*/
+#include <stdlib.h>
+#include <bsp.h>
+#include <pretty_os.h>
+#include <uartstdio.h>
+
+/*
+*******************************************************************************
+*                                   Macros                                    *
+*******************************************************************************
+*/
+#define BENCH_OUTPUT_JSON   (0)                         /* 0: CSV, 1: JSON lines.                           */
+#define BENCH_SAMPLES       (2000U)                     /* Samples of each benchmark.                       */
+#define BENCH_WARMUP        (16U)                       /* Iterations dropped before sampling.              */
+#define BENCH_BATCH         (64U)                       /* Operations per sample of the throughput ones.    */
+#define BENCH_TICK_SAMPLES  (400U)                      /* Samples of tick_dispatch and idle_wake.          */
+
+#define STACK_SIZE          (40U)
+#define PRIO_BENCH          (2U)
+#define PRIO_CTX            (10U)
+#define PRIO_SEM            (11U)
+#define PRIO_MAILBOX        (12U)
+#define PRIO_MUTEX          (13U)
+#define PRIO_TICK           (14U)
+#define PRIO_LIFE           (15U)
+#define PRIO_WAITER_BASE    (20U)
+#define PRIO_DELAYED_BASE   (40U)
+
+#define WAITER_MAX          (16U)                       /* Max. number of the flag waiters.                 */
+#define DELAYED_MAX         (64U)                       /* Max. number of the delayed tasks.                */
+#define DELAYED_TICKS       (0xFFFFFFU)                 /* Long enough to not wake up while measuring.      */
+
+#define BENCH_FLAG          (0x01U)
+#define MEMORY_BLOCKS       (8U)
+
+/*
+*******************************************************************************
+*                              Tasks Stacks                                   *
+*******************************************************************************
+*/
+
+OS_tSTACK stkTask_Bench   [STACK_SIZE];
+OS_tSTACK stkTask_Ctx     [STACK_SIZE];
+OS_tSTACK stkTask_Sem     [STACK_SIZE];
+OS_tSTACK stkTask_Mailbox [STACK_SIZE];
+OS_tSTACK stkTask_Mutex   [STACK_SIZE];
+OS_tSTACK stkTask_Tick    [STACK_SIZE];
+OS_tSTACK stkTask_Life    [STACK_SIZE];
+OS_tSTACK stkTask_Waiter  [WAITER_MAX][STACK_SIZE];
+OS_tSTACK stkTask_Delayed [DELAYED_MAX][STACK_SIZE];
+OS_tSTACK stkTask_Idle    [STACK_SIZE];
+
+/*
+*******************************************************************************
+*                                 Globals                                     *
+*******************************************************************************
+*/
+OS_SEM*             sem_ping;
+OS_SEM*             sem_pong;
+OS_MAILBOX*         mailbox;
+OS_MUTEX*           mutex;
+OS_EVENT_FLAG_GRP*  flags;
+OS_MEMORY*          memory;
+
+CPU_t32U            memory_blocks [MEMORY_BLOCKS][4];
+CPU_t64U            samples [BENCH_SAMPLES];
+CPU_t64U volatile   bench_stamp;                        /* Time stamped by a worker task.                   */
+CPU_t64U volatile   bench_spin_stamp;                   /* Time stamped by the spinning bench task.         */
+CPU_t32U volatile   bench_tick_done;
+
+/*
+*******************************************************************************
+*                              OS Hooks functions                             *
+*******************************************************************************
+*/
+
+void App_Hook_TaskIdle(void)
+{
+    /*  Application idle routine.    */
+}
+
+/*
+*******************************************************************************
+*                              Results Report                                 *
+*******************************************************************************
+*/
+
+static int
+sample_compare(const void* a, const void* b) {
+    CPU_t64U x = *(const CPU_t64U*)a;
+    CPU_t64U y = *(const CPU_t64U*)b;
+
+    return (x > y) - (x < y);
+}
+
+static void
+bench_report_count(const char* name, unsigned param, unsigned count) {
+    CPU_t64U min, median, p99, max;
+
+    qsort(samples, count, sizeof(samples[0]), sample_compare);
+
+    min    = samples[0];
+    median = samples[count / 2U];
+    p99    = samples[((count * 99U) + 99U) / 100U - 1U];
+    max    = samples[count - 1U];
+
+#if (BENCH_OUTPUT_JSON == 1)
+    printf("{\"benchmark\":\"%s\",\"param\":%u,\"unit\":\"ns\",\"samples\":%u,"
+           "\"min\":%llu,\"median\":%llu,\"p99\":%llu,\"max\":%llu}\n",
+           name, param, count, min, median, p99, max);
+#else
+    printf("%s,%u,ns,%u,%llu,%llu,%llu,%llu\n", name, param, count, min, median, p99, max);
+#endif
+}
+
+static void
+bench_report(const char* name, unsigned param) {
+    bench_report_count(name, param, BENCH_SAMPLES);
+}
+
+/*
+*******************************************************************************
+*                              Worker Tasks                                   *
+*******************************************************************************
+*/
+
+void
+task_ctx(void* args) {
+    (void)args;
+    while (1) {
+        OS_TaskSuspend(PRIO_CTX);
+        bench_stamp = OS_CPU_TimestampGet();
+    }
+}
+
+void
+task_sem(void* args) {
+    (void)args;
+    while (1) {
+        OS_SemPend(sem_ping, 0U);
+        OS_SemPost(sem_pong);
+    }
+}
+
+void
+task_mailbox(void* args) {
+    (void)args;
+    while (1) {
+        (void)OS_MailBoxPend(mailbox, 0U);
+    }
+}
+
+void
+task_mutex(void* args) {
+    (void)args;
+    while (1) {
+        OS_TaskSuspend(PRIO_MUTEX);
+        OS_MutexPend(mutex, 0U);
+        bench_stamp = OS_CPU_TimestampGet();
+        OS_MutexPost(mutex);
+    }
+}
+
+void
+task_tick(void* args) {
+    CPU_t32U i;
+
+    (void)args;
+    while (1) {
+        OS_TaskSuspend(PRIO_TICK);
+        for (i = 0U; i < BENCH_WARMUP + BENCH_TICK_SAMPLES; ++i) {
+            OS_DelayTicks(1U);
+            if (i >= BENCH_WARMUP) {                    /* The bench task spun till the tick interrupted it. */
+                samples[i - BENCH_WARMUP] = OS_CPU_TimestampGet() - bench_spin_stamp;
+            }
+        }
+        bench_tick_done = 1U;
+    }
+}
+
+void
+task_exit(void* args) {
+    (void)args;                                         /* Returns, So it's deleted.                        */
+}
+
+void
+task_suspended(void* args) {
+    (void)args;
+    OS_TaskSuspend(PRIO_LIFE);
+}
+
+void
+task_waiter(void* args) {
+    (void)args;
+    while (1) {
+        (void)OS_EVENT_FlagPend(flags, BENCH_FLAG, OS_FLAG_WAIT_SET_ANY, OS_TRUE, 0U);
+    }
+}
+
+void
+task_delayed(void* args) {
+    (void)args;
+    while (1) {
+        OS_DelayTicks(DELAYED_TICKS + OS_TaskRunningPriorityGet());    /* Different expiry time for each task. */
+    }
+}
+
+/*
+*******************************************************************************
+*                              Benchmarks                                     *
+*******************************************************************************
+*/
+
+static void
+bench_timestamp(void) {
+    CPU_t64U t0;
+    CPU_t32U i;
+
+    for (i = 0U; i < BENCH_SAMPLES; ++i) {
+        t0 = OS_CPU_TimestampGet();
+        samples[i] = OS_CPU_TimestampGet() - t0;
+    }
+    bench_report("timestamp", 0U);
+}
+
+static void
+bench_ctx_switch(void) {
+    CPU_t64U t0;
+    CPU_t32U i;
+
+    for (i = 0U; i < BENCH_WARMUP + BENCH_SAMPLES; ++i) {
+        t0 = OS_CPU_TimestampGet();
+        OS_TaskResume(PRIO_CTX);                        /* Runs till it suspends itself again.              */
+        if (i >= BENCH_WARMUP) {
+            samples[i - BENCH_WARMUP] = bench_stamp - t0;
+        }
+    }
+    bench_report("ctx_switch", 0U);
+}
+
+static void
+bench_sem_pingpong(void) {
+    CPU_t64U t0;
+    CPU_t32U i;
+
+    for (i = 0U; i < BENCH_WARMUP + BENCH_SAMPLES; ++i) {
+        t0 = OS_CPU_TimestampGet();
+        OS_SemPost(sem_ping);
+        OS_SemPend(sem_pong, 0U);
+        if (i >= BENCH_WARMUP) {
+            samples[i - BENCH_WARMUP] = OS_CPU_TimestampGet() - t0;
+        }
+    }
+    bench_report("sem_pingpong", 0U);
+}
+
+static void
+bench_mailbox(void) {
+    static CPU_t32U message;
+    CPU_t64U t0;
+    CPU_t32U i;
+    CPU_t32U j;
+
+    for (i = 0U; i < BENCH_WARMUP + BENCH_SAMPLES; ++i) {
+        t0 = OS_CPU_TimestampGet();
+        for (j = 0U; j < BENCH_BATCH; ++j) {
+            OS_MailBoxPost(mailbox, &message);          /* The consumer takes it at once.                   */
+        }
+        if (i >= BENCH_WARMUP) {
+            samples[i - BENCH_WARMUP] = (OS_CPU_TimestampGet() - t0) / BENCH_BATCH;
+        }
+    }
+    bench_report("mailbox", BENCH_BATCH);
+}
+
+static void
+bench_mutex_handoff(void) {
+    CPU_t64U t0;
+    CPU_t32U i;
+
+    for (i = 0U; i < BENCH_WARMUP + BENCH_SAMPLES; ++i) {
+        OS_MutexPend(mutex, 0U);
+        OS_TaskResume(PRIO_MUTEX);                      /* Runs and blocks on the owned mutex.              */
+        t0 = OS_CPU_TimestampGet();
+        OS_MutexPost(mutex);                            /* Hands it off and runs till it suspends itself.   */
+        if (i >= BENCH_WARMUP) {
+            samples[i - BENCH_WARMUP] = bench_stamp - t0;
+        }
+    }
+    bench_report("mutex_handoff", 0U);
+}
+
+static void
+bench_flag_fanout(void) {
+    static const CPU_t32U steps[] = { 1U, 4U, 16U };
+    CPU_t64U t0;
+    CPU_t32U waiters = 0U;
+    CPU_t32U s;
+    CPU_t32U i;
+
+    for (s = 0U; s < sizeof(steps) / sizeof(steps[0]); ++s) {
+        for (; waiters < steps[s]; ++waiters) {
+            OS_TaskCreate(&task_waiter,                 /* Runs and pends on the flag at once.              */
+                          OS_NULL(void),
+                          stkTask_Waiter[waiters],
+                          sizeof(stkTask_Waiter[waiters]),
+                          PRIO_WAITER_BASE + waiters);
+        }
+
+        for (i = 0U; i < BENCH_WARMUP + BENCH_SAMPLES; ++i) {
+            t0 = OS_CPU_TimestampGet();
+            OS_EVENT_FlagPost(flags, BENCH_FLAG, OS_FLAG_SET);  /* All the waiters run and pend again.      */
+            if (i >= BENCH_WARMUP) {
+                samples[i - BENCH_WARMUP] = OS_CPU_TimestampGet() - t0;
+            }
+        }
+        bench_report("flag_fanout", waiters);
+    }
+}
+
+static void
+bench_memory(void) {
+    void*    pblock;
+    CPU_t64U t0;
+    CPU_t32U i;
+    CPU_t32U j;
+
+    for (i = 0U; i < BENCH_WARMUP + BENCH_SAMPLES; ++i) {
+        t0 = OS_CPU_TimestampGet();
+        for (j = 0U; j < BENCH_BATCH; ++j) {
+            pblock = OS_MemoryAllocateBlock(memory);
+            OS_MemoryRestoreBlock(memory, pblock);
+        }
+        if (i >= BENCH_WARMUP) {
+            samples[i - BENCH_WARMUP] = (OS_CPU_TimestampGet() - t0) / BENCH_BATCH;
+        }
+    }
+    bench_report("memory", BENCH_BATCH);
+}
+
+static void
+bench_tick(void) {
+    static const CPU_t32U steps[] = { 0U, 16U, 32U, 64U };
+    CPU_t64U t0;
+    CPU_t32U delayed = 0U;
+    CPU_t32U s;
+    CPU_t32U i;
+    CPU_SR_ALLOC();
+
+    for (s = 0U; s < sizeof(steps) / sizeof(steps[0]); ++s) {
+        for (; delayed < steps[s]; ++delayed) {
+            OS_TaskCreate(&task_delayed,                /* Runs and blocks for a long delay at once.        */
+                          OS_NULL(void),
+                          stkTask_Delayed[delayed],
+                          sizeof(stkTask_Delayed[delayed]),
+                          PRIO_DELAYED_BASE + delayed);
+        }
+
+        OS_SchedLock();                                 /* No context switch on the emulated ISR exit.      */
+        for (i = 0U; i < BENCH_WARMUP + BENCH_SAMPLES; ++i) {
+            t0 = OS_CPU_TimestampGet();
+            OS_CRTICAL_BEGIN();
+            OS_IntEnter();
+            OS_CRTICAL_END();
+            OS_TimerTick();
+            OS_IntExit();
+            if (i >= BENCH_WARMUP) {
+                samples[i - BENCH_WARMUP] = OS_CPU_TimestampGet() - t0;
+            }
+        }
+        OS_SchedUnlock();
+        bench_report("tick", delayed);
+    }
+}
+
+static void
+bench_task_exit(void) {
+    CPU_t64U t0;
+    CPU_t32U i;
+
+    for (i = 0U; i < BENCH_WARMUP + BENCH_SAMPLES; ++i) {
+        t0 = OS_CPU_TimestampGet();
+        OS_TaskCreate(&task_exit, OS_NULL(void), stkTask_Life, sizeof(stkTask_Life), PRIO_LIFE);
+        if (i >= BENCH_WARMUP) {
+            samples[i - BENCH_WARMUP] = OS_CPU_TimestampGet() - t0;
+        }
+    }
+    bench_report("task_exit", 0U);
+}
+
+static void
+bench_task_delete(void) {
+    CPU_t64U t0;
+    CPU_t32U i;
+
+    for (i = 0U; i < BENCH_WARMUP + BENCH_SAMPLES; ++i) {
+        t0 = OS_CPU_TimestampGet();
+        OS_TaskCreate(&task_suspended, OS_NULL(void), stkTask_Life, sizeof(stkTask_Life), PRIO_LIFE);
+        OS_TaskDelete(PRIO_LIFE);
+        if (i >= BENCH_WARMUP) {
+            samples[i - BENCH_WARMUP] = OS_CPU_TimestampGet() - t0;
+        }
+    }
+    bench_report("task_delete", 0U);
+}
+
+static void
+bench_tick_dispatch(void) {
+    CPU_TICK_LATENESS lateness;
+
+    OS_CPU_TickLatenessReset();
+    bench_tick_done = 0U;
+    OS_TaskResume(PRIO_TICK);
+    while (bench_tick_done == 0U) {                     /* Be the interrupted task at every tick.           */
+        bench_spin_stamp = OS_CPU_TimestampGet();
+    }
+    bench_report_count("tick_dispatch", 0U, BENCH_TICK_SAMPLES);
+
+    OS_CPU_TickLatenessGet(&lateness);
+    printf("# tick lateness: ticks=%llu, missed=%llu, min/avg/max=%llu/%llu/%llu ns\n",
+           lateness.ticks, lateness.missed, lateness.min,
+           (lateness.ticks != 0U) ? (lateness.sum / lateness.ticks) : 0ULL, lateness.max);
+}
+
+static void
+bench_idle_wake(void) {
+    CPU_t64U period;
+    CPU_t64U earliest;
+    CPU_t32U i;
+
+    period = 1000000000ULL / OS_CONFIG_TICKS_PER_SEC;
+    OS_DelayTicks(1U);                                  /* Align to a tick.                                 */
+    for (i = 0U; i < BENCH_TICK_SAMPLES; ++i) {
+        OS_DelayTicks(1U);
+        samples[i] = OS_CPU_TimestampGet() - (i * period);
+    }
+
+    earliest = samples[0];
+    for (i = 1U; i < BENCH_TICK_SAMPLES; ++i) {
+        if (samples[i] < earliest) {
+            earliest = samples[i];
+        }
+    }
+    for (i = 0U; i < BENCH_TICK_SAMPLES; ++i) {
+        samples[i] -= earliest;
+    }
+    bench_report_count("idle_wake", 0U, BENCH_TICK_SAMPLES);
+}
+
+void
+task_bench(void* args) {
+    (void)args;
+
+#if (BENCH_OUTPUT_JSON == 0)
+    printf("benchmark,param,unit,samples,min,median,p99,max\n");
+#endif
+
+    bench_timestamp();
+    bench_ctx_switch();
+    bench_sem_pingpong();
+    bench_mailbox();
+    bench_mutex_handoff();
+    bench_flag_fanout();
+    bench_memory();
+    bench_tick();
+    bench_task_exit();
+    bench_task_delete();
+    bench_tick_dispatch();
+    bench_idle_wake();
+
+    printf("# Done.\n");
+    exit(0);                                            /* End the POSIX process, So it can be scripted.    */
+}
+
+int main() {
+
+    /* Setup low level connected devices.   */
+    BSP_HardwareSetup();
+
+    /* Initialize the Idle Task stack.      */
+    OS_Init(stkTask_Idle, sizeof(stkTask_Idle));
+
+    sem_ping = OS_SemCreate(0U);
+    sem_pong = OS_SemCreate(0U);
+    mailbox  = OS_MailBoxCreate(OS_NULL(void));
+    mutex    = OS_MutexCreate(PRIO_MUTEX, OS_MUTEX_PRIO_CEIL_DISABLE);
+    flags    = OS_EVENT_FlagCreate(0U);
+    memory   = OS_MemoryPartitionCreate(memory_blocks, MEMORY_BLOCKS, sizeof(memory_blocks[0]));
+
+    /* The workers run first at OS_Run() and block till the bench task drives them. */
+    OS_TaskCreate(&task_ctx,     OS_NULL(void), stkTask_Ctx,     sizeof(stkTask_Ctx),     PRIO_CTX);
+    OS_TaskCreate(&task_sem,     OS_NULL(void), stkTask_Sem,     sizeof(stkTask_Sem),     PRIO_SEM);
+    OS_TaskCreate(&task_mailbox, OS_NULL(void), stkTask_Mailbox, sizeof(stkTask_Mailbox), PRIO_MAILBOX);
+    OS_TaskCreate(&task_mutex,   OS_NULL(void), stkTask_Mutex,   sizeof(stkTask_Mutex),   PRIO_MUTEX);
+    OS_TaskCreate(&task_tick,    OS_NULL(void), stkTask_Tick,    sizeof(stkTask_Tick),    PRIO_TICK);
+    OS_TaskCreate(&task_bench,   OS_NULL(void), stkTask_Bench,   sizeof(stkTask_Bench),   PRIO_BENCH);
+
+    /*  Transfer control to the RTOS to run the tasks.   */
+    OS_Run(BSP_CPU_FrequencyGet());
+
+    /*       Should never reach here.   */
+    for(;;);
+}
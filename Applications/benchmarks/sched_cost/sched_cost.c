@@ -0,0 +1,192 @@
+/*****************************************************************************
+MIT License
+
+Copyright (c) 2020 Yahia Farghaly Ashour
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+/*
+ * Author   : Yahia Farghaly Ashour
+ *
+ * Purpose  : Measure the scheduling cost against the priority level of the running tasks.
+ *
+ *            Two tasks ping-pong with OS_TaskSuspend()/OS_TaskResume(), So every iteration is two
+ *            scheduler calls and two context switches. A controller task at the highest priority
+ *            moves the pair to a higher priority level after each measurement window and reports
+ *            the number of iterations per tick.
+ *
+ *            The search of the highest ready priority used to walk the ready table from the top entry,
+ *            So a low priority pair was slower with a large OS_CONFIG_TASK_COUNT. With the two-level
+ *            ready table, the iterations per tick should stay flat across the priority levels.
+ *
+ *            Rebuild with OS_CONFIG_TASK_COUNT = 128, 1024 and 4096 to sweep the task count.
+ *
+ *            Requires OS_CONFIG_EDF_EN = OS_CONFIG_DISABLE.
+ *
+ * Language:  C
+ */
+
+/*
+*******************************************************************************
+*                               Includes Files                                *
+*******************************************************************************
+*/
+#include <bsp.h>
+#include <pretty_os.h>
+#include <uartstdio.h>
+
+/*
+*******************************************************************************
+*                                   Macros                                    *
+*******************************************************************************
+*/
+#define STACK_SIZE          (40U)
+#define PRIO_CONTROLLER     (OS_HIGHEST_PRIO_LEVEL)
+#define PRIO_PAIR_FIRST     (2U)                        /* Lowest priority which is not reserved.           */
+
+#define SAMPLE_TICKS        (OS_CONFIG_TICKS_PER_SEC)   /* Measurement window in ticks.                     */
+
+/*
+*******************************************************************************
+*                              Tasks Stacks                                   *
+*******************************************************************************
+*/
+
+OS_tSTACK stkTask_Controller [STACK_SIZE];
+OS_tSTACK stkTask_Ping       [STACK_SIZE];
+OS_tSTACK stkTask_Pong       [STACK_SIZE];
+OS_tSTACK stkTask_Idle       [STACK_SIZE];
+
+/*
+*******************************************************************************
+*                                 Globals                                     *
+*******************************************************************************
+*/
+
+volatile OS_PRIO        prio_ping;                      /* Priority of the ping task (pong is one below).   */
+volatile unsigned long  iterations;
+
+/*
+*******************************************************************************
+*                              OS Hooks functions                             *
+*******************************************************************************
+*/
+
+void App_Hook_TaskIdle(void)
+{
+    /*  Application idle routine.    */
+}
+
+/*
+*******************************************************************************
+*                              Tasks Definitions                              *
+*******************************************************************************
+*/
+
+void
+main_pingTask(void* args) {
+    (void)args;
+    while (1) {
+        ++iterations;
+        OS_TaskSuspend(prio_ping);                      /* Let the pong task run.                           */
+    }
+}
+
+void
+main_pongTask(void* args) {
+    (void)args;
+    while (1) {
+        OS_TaskResume(prio_ping);                       /* Preempted by the ping task at once.              */
+    }
+}
+
+void
+main_controllerTask(void* args) {
+    OS_PRIO         prio_next;
+    unsigned long   count;
+
+    (void)args;
+
+    printf("#Pair Priority, Iterations/Tick\n");
+
+    while (1) {
+        iterations = 0U;
+        OS_DelayTicks(SAMPLE_TICKS);
+        count = iterations;
+
+        printf("%14u, %15lu\n", (unsigned int)prio_ping, count / SAMPLE_TICKS);
+
+        prio_next = (OS_PRIO)(prio_ping * 2U);          /* Double the priority level for the next window.   */
+        if (prio_next >= PRIO_CONTROLLER || prio_next <= prio_ping) {
+            break;
+        }
+                                                        /* Move the ping first since it goes higher.        */
+        OS_TaskChangePriority(prio_ping, prio_next);
+        OS_TaskChangePriority(prio_ping - 1U, prio_next - 1U);
+        prio_ping = prio_next;
+    }
+
+    printf("[Info]: Done.\n");
+    OS_TaskSuspend(prio_ping - 1U);                     /* Stop the pair.                                   */
+    OS_TaskSuspend(prio_ping);
+    OS_TaskSuspend(PRIO_CONTROLLER);
+}
+
+int main() {
+
+    /* Setup low level connected devices.   */
+    BSP_HardwareSetup();
+
+    /* Clear console terminal.              */
+    BSP_UART_ClearVirtualTerminal();
+
+    /* Initialize the Idle Task stack.      */
+    OS_Init(stkTask_Idle, sizeof(stkTask_Idle));
+
+    prio_ping = PRIO_PAIR_FIRST + 1U;
+
+    OS_TaskCreate(&main_controllerTask,
+                  OS_NULL(void),
+                  stkTask_Controller,
+                  sizeof(stkTask_Controller),
+                  PRIO_CONTROLLER);
+
+    OS_TaskCreate(&main_pingTask,
+                  OS_NULL(void),
+                  stkTask_Ping,
+                  sizeof(stkTask_Ping),
+                  prio_ping);
+
+    OS_TaskCreate(&main_pongTask,
+                  OS_NULL(void),
+                  stkTask_Pong,
+                  sizeof(stkTask_Pong),
+                  prio_ping - 1U);
+
+    printf("[Info]: OS ticks per second: %d \n",OS_CONFIG_TICKS_PER_SEC);
+    printf("[Info]: OS task count: %d \n",OS_CONFIG_TASK_COUNT);
+    printf("[Info]: Scheduling cost vs. priority level.\n\n");
+
+    /*  Transfer control to the RTOS to run the tasks.   */
+    OS_Run(BSP_CPU_FrequencyGet());
+
+    /*       Should never reach here.   */
+    for(;;);
+}
@@ -0,0 +1,178 @@
+/*****************************************************************************
+MIT License
+
+Copyright (c) 2020 Yahia Farghaly Ashour
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+/*
+ * Author   : Yahia Farghaly Ashour
+ *
+ * Purpose  : Measure the cost of the OS tick as the number of delayed tasks grows.
+ *
+ *            A low priority meter task spins and counts loop iterations for a fixed number of ticks.
+ *            Every tick ISR steals CPU time from the meter, So the lost iterations per tick (compared
+ *            with the first run with no delayed tasks) is the tick cost.
+ *            Between each run, DELAYED_STEP more tasks are created which block for a long delay and
+ *            stay in the delay list during the measurement.
+ *
+ *            With the delay list, the count per tick should stay flat regardless of the number
+ *            of delayed tasks. The cost moves to the blocking calls, Their sorted insertion in the
+ *            delay list grows linearly with the number of delayed tasks and is not measured here.
+ *
+ *            Requires OS_CONFIG_EDF_EN = OS_CONFIG_DISABLE and OS_CONFIG_SYSTEM_TIME_SET_GET_EN = OS_CONFIG_ENABLE.
+ *
+ * Language:  C
+ */
+
+/*
+*******************************************************************************
+*                               Includes Files                                *
+*******************************************************************************
+*/
+#include <bsp.h>
+#include <pretty_os.h>
+#include <uartstdio.h>
+
+/*
+*******************************************************************************
+*                                   Macros                                    *
+*******************************************************************************
+*/
+#define STACK_SIZE          (40U)
+#define PRIO_METER          (2U)
+#define PRIO_DELAYED_BASE   (3U)
+
+#define DELAYED_MAX         (96U)                       /* Max. number of delayed tasks.                    */
+#define DELAYED_STEP        (16U)                       /* Delayed tasks added between two measurements.    */
+#define DELAYED_TICKS       (0xFFFFFFU)                 /* Long enough to not wake up while measuring.      */
+#define SAMPLE_TICKS        (OS_CONFIG_TICKS_PER_SEC)   /* Measurement window in ticks.                     */
+
+/*
+*******************************************************************************
+*                              Tasks Stacks                                   *
+*******************************************************************************
+*/
+
+OS_tSTACK stkTask_Meter   [STACK_SIZE];
+OS_tSTACK stkTask_Delayed [DELAYED_MAX][STACK_SIZE];
+OS_tSTACK stkTask_Idle    [STACK_SIZE];
+
+/*
+*******************************************************************************
+*                              OS Hooks functions                             *
+*******************************************************************************
+*/
+
+void App_Hook_TaskIdle(void)
+{
+    /*  Application idle routine.    */
+}
+
+/*
+*******************************************************************************
+*                              Tasks Definitions                              *
+*******************************************************************************
+*/
+
+void
+main_delayedTask(void* args) {
+    (void)args;
+    while (1) {
+        OS_DelayTicks(DELAYED_TICKS + OS_TaskRunningPriorityGet());  /* Different expiry time for each task. */
+    }
+}
+
+static unsigned long
+meter_CountPerTick(void) {
+    unsigned long count = 0U;
+    OS_TICK start;
+
+    start = OS_TickTimeGet();
+    while (OS_TickTimeGet() == start);                  /* Align to a tick edge.                            */
+
+    start = OS_TickTimeGet();
+    while ((OS_TickTimeGet() - start) < SAMPLE_TICKS) {
+        ++count;
+    }
+    return (count / SAMPLE_TICKS);
+}
+
+void
+main_meterTask(void* args) {
+    unsigned long base;
+    unsigned long count;
+    unsigned long cost;
+    CPU_tWORD delayed = 0U;
+    CPU_tWORD i;
+
+    (void)args;
+
+    base = meter_CountPerTick();
+    printf("#Delayed Tasks, Count/Tick, Tick Cost (%% of tick period)\n");
+    printf("%14u, %10lu, %3lu.%02lu\n", delayed, base, 0UL, 0UL);
+
+    while (delayed < DELAYED_MAX) {
+        for (i = 0U; i < DELAYED_STEP; ++i, ++delayed) {
+            OS_TaskCreate(&main_delayedTask,            /* Higher priority than the meter, So it runs and blocks at once. */
+                          OS_NULL(void),
+                          stkTask_Delayed[delayed],
+                          sizeof(stkTask_Delayed[delayed]),
+                          PRIO_DELAYED_BASE + delayed);
+        }
+
+        count = meter_CountPerTick();
+        cost  = (count < base) ? (((base - count) * 10000U) / base) : 0U;   /* In 1/100 of percent.   */
+        printf("%14u, %10lu, %3lu.%02lu\n", delayed, count, cost / 100U, cost % 100U);
+    }
+
+    printf("[Info]: Done.\n");
+    while (1) {
+        OS_DelayTicks(DELAYED_TICKS);
+    }
+}
+
+int main() {
+
+    /* Setup low level connected devices.   */
+    BSP_HardwareSetup();
+
+    /* Clear console terminal.              */
+    BSP_UART_ClearVirtualTerminal();
+
+    /* Initialize the Idle Task stack.      */
+    OS_Init(stkTask_Idle, sizeof(stkTask_Idle));
+
+    /* Create the meter task.               */
+    OS_TaskCreate(&main_meterTask,
+                  OS_NULL(void),
+                  stkTask_Meter,
+                  sizeof(stkTask_Meter),
+                  PRIO_METER);
+
+    printf("[Info]: OS ticks per second: %d \n",OS_CONFIG_TICKS_PER_SEC);
+    printf("[Info]: Tick cost vs. number of delayed tasks.\n\n");
+
+    /*  Transfer control to the RTOS to run the tasks.   */
+    OS_Run(BSP_CPU_FrequencyGet());
+
+    /*       Should never reach here.   */
+    for(;;);
+}
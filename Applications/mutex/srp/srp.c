@@ -0,0 +1,246 @@
+/*****************************************************************************
+MIT License
+
+Copyright (c) 2020 Yahia Farghaly Ashour
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+/*
+ * Author   : 	Yahia Farghaly Ashour
+ *
+ * Purpose  : This example demonstrates the Stack Resource Policy (SRP) of the mutexes with EDF scheduling.
+ * 				Make sure you set OS_CONFIG_EDF_EN and OS_CONFIG_MUTEX_EN to OS_CONFIG_ENABLE.
+ *
+ * 				T_Low, T_Mid and T_High share a counter protected by a mutex.
+ * 				The mutex ceiling is the relative deadline of T_High (the shortest among its users).
+ *
+				 +----------------------
+				 | tsk   |  T  |  C  |  D |		T is the period of the task.
+				 +-------+-----+-----+----|		C is the computation time for execution (in the critical section).
+				 | T_Low |  20 |  3  | 20 |		D is the relative deadline for a task job.
+				 | T_Mid |  10 |  1  |  5 |
+				 | T_High|   4 |  1  |  3 |		The unit of time here is second.
+				 +------------------------+
+
+				 T_Low locks the mutex at t = 2 (after T_High and T_Mid) till t = 5, And T_High is released inside
+				 its critical section at t = 4 with the earliest absolute deadline (t = 7). Its job is not allowed to
+				 start (its relative deadline is not shorter than the ceiling) till T_Low posts the mutex, So it never
+				 blocks on the mutex and it's blocked once for at most one critical section of T_Low.
+ *
+ * Language	:  	C
+ */
+
+/*
+*******************************************************************************
+*                               Includes Files                                *
+*******************************************************************************
+*/
+#include <bsp.h>
+#include <pretty_os.h>
+#include <uartstdio.h>
+
+/*
+*******************************************************************************
+*                                   Macros                                    *
+*******************************************************************************
+*/
+#define STACK_SIZE   (40U)
+
+/* Task's Parameters In Seconds.			*/
+#define Task_Low_P	20U
+#define Task_Mid_P	10U
+#define Task_High_P	4U
+
+#define Task_Low_C	3U
+#define Task_Mid_C	1U
+#define Task_High_C	1U
+
+#define Task_Low_D	20U
+#define Task_Mid_D	5U
+#define Task_High_D	3U
+
+/*
+*******************************************************************************
+*                              Tasks Stacks                                   *
+*******************************************************************************
+*/
+
+OS_tSTACK stkTask_Low 	  [STACK_SIZE];
+OS_tSTACK stkTask_Mid 	  [STACK_SIZE];
+OS_tSTACK stkTask_High 	  [STACK_SIZE];
+
+OS_tSTACK stkTask_Idle    [STACK_SIZE];
+
+/*
+*******************************************************************************
+*                                 Globals                                     *
+*******************************************************************************
+*/
+
+OS_MUTEX* 		mutex;
+CPU_t32U  		shared_counter;
+OS_BOOLEAN		low_locked;			/* Set while T_Low is in its critical section.				*/
+OS_TICK			low_post_tick;		/* The tick time of the last OS_MutexPost() of T_Low.		*/
+
+/*
+*******************************************************************************
+*                              OS Hooks functions                             *
+*******************************************************************************
+*/
+
+void App_Hook_TaskIdle(void)
+{
+
+}
+
+/*
+*******************************************************************************
+*                              Tasks Definitions                              *
+*******************************************************************************
+*/
+
+void
+task_low(void* args) {
+
+	(void)args;
+
+    while (1) {
+
+    	OS_MutexPend(mutex, 0);
+    	printf("t[+%05d] | T_Low  locks   the mutex\n",OS_TickTimeGet()/OS_CONFIG_TICKS_PER_SEC);
+    	low_locked = OS_TRUE;
+
+    	BSP_DelayMilliseconds(Task_Low_C*1000);
+    	++shared_counter;
+
+    	printf("t[+%05d] | T_Low  unlocks the mutex, counter = %u\n",OS_TickTimeGet()/OS_CONFIG_TICKS_PER_SEC, shared_counter);
+    	low_locked    = OS_FAlSE;
+    	low_post_tick = OS_TickTimeGet();
+    	OS_MutexPost(mutex);			/* T_High starts here if it was released in the critical section.	*/
+
+    	OS_TaskYield();
+    }
+}
+
+void
+task_mid(void* args) {
+
+	(void)args;
+
+    while (1) {
+
+    	OS_MutexPend(mutex, 0);			/* Never waits, The mutex is free whenever T_Mid starts.	*/
+    	printf("t[+%05d] | T_Mid  locks   the mutex\n",OS_TickTimeGet()/OS_CONFIG_TICKS_PER_SEC);
+
+    	BSP_DelayMilliseconds(Task_Mid_C*1000);
+    	++shared_counter;
+
+    	OS_MutexPost(mutex);
+
+    	if(OS_Is_CurrentTaskMissedDeadline())
+    	{
+    		printf("T_Mid Missed its deadline ! \n");
+    	}
+
+    	OS_TaskYield();
+    }
+}
+
+void
+task_high(void* args) {
+
+	OS_TICK release = 0U;
+
+	(void)args;
+
+    while (1) {
+
+    	if(low_locked == OS_TRUE)
+    	{
+    		printf("T_High started inside the critical section of T_Low ! \n");
+    	}
+    	else if(low_post_tick > release)	/* T_Low posted the mutex after the release of this job.	*/
+    	{
+    		printf("t[+%05d] | T_High starts after OS_MutexPost(), Released at t[+%05d]\n",OS_TickTimeGet()/OS_CONFIG_TICKS_PER_SEC, release/OS_CONFIG_TICKS_PER_SEC);
+    	}
+    	else
+    	{
+    		printf("t[+%05d] | T_High starts\n",OS_TickTimeGet()/OS_CONFIG_TICKS_PER_SEC);
+    	}
+
+    	OS_MutexPend(mutex, 0);			/* Never waits, The mutex is free whenever T_High starts.	*/
+    	BSP_DelayMilliseconds(Task_High_C*1000);
+    	++shared_counter;
+    	OS_MutexPost(mutex);
+
+    	if(OS_Is_CurrentTaskMissedDeadline())
+    	{
+    		printf("T_High Missed its deadline ! \n");
+    	}
+
+    	release += Task_High_P*OS_CONFIG_TICKS_PER_SEC;
+    	OS_TaskYield();
+    }
+}
+
+int main() {
+
+    /* Setup low level connected devices.   */
+    BSP_HardwareSetup();
+
+    /* Clear console terminal.              */
+    BSP_UART_ClearVirtualTerminal();
+
+    /* Initialize the Idle Task stack.      */
+    OS_Init(stkTask_Idle, sizeof(stkTask_Idle));
+
+    /* The ceiling is the shortest relative deadline of the mutex users (i.e T_Mid).	*/
+    mutex = OS_MutexCreate(Task_High_D*OS_CONFIG_TICKS_PER_SEC, OS_MUTEX_PRIO_CEIL_ENABLE);
+
+    OS_TaskCreate(&task_low,
+                  OS_NULL(void),
+                  &stkTask_Low[0],
+                  sizeof(stkTask_Low),
+				  OS_TASK_PERIODIC,
+				  Task_Low_D*OS_CONFIG_TICKS_PER_SEC,Task_Low_P*OS_CONFIG_TICKS_PER_SEC);
+
+    OS_TaskCreate(&task_mid,
+                  OS_NULL(void),
+                  &stkTask_Mid[0],
+                  sizeof(stkTask_Mid),
+				  OS_TASK_PERIODIC,
+				  Task_Mid_D*OS_CONFIG_TICKS_PER_SEC,Task_Mid_P*OS_CONFIG_TICKS_PER_SEC);
+
+    OS_TaskCreate(&task_high,
+                  OS_NULL(void),
+                  &stkTask_High[0],
+                  sizeof(stkTask_High),
+				  OS_TASK_PERIODIC,
+				  Task_High_D*OS_CONFIG_TICKS_PER_SEC,Task_High_P*OS_CONFIG_TICKS_PER_SEC);
+
+    printf("[Info]: OS ticks per second: %d \n",OS_CONFIG_TICKS_PER_SEC);
+    printf("[Info]: Stack Resource Policy with EDF.\n\n");
+
+    /*  Transfer control to the RTOS to run the tasks.   */
+    OS_Run(BSP_CPU_FrequencyGet());
+
+    /*       Should never reach here.   */
+    for(;;);
+}
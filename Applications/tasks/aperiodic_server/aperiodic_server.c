@@ -0,0 +1,181 @@
+/*****************************************************************************
+MIT License
+
+Copyright (c) 2020 Yahia Farghaly Ashour
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+/*
+ * Author   : 	Yahia Farghaly Ashour
+ *
+ * Purpose  : This example demonstrates serving an aperiodic task by a Constant Bandwidth Server (CBS) with EDF scheduling.
+ * 				Make sure you set OS_CONFIG_EDF_EN and OS_CONFIG_SEMAPHORE_EN to OS_CONFIG_ENABLE.
+ *
+ * 				T_Periodic is a periodic task, Every job posts a request to T_Server.
+ * 				T_Server is an aperiodic task served by a CBS with a budget Qs of 2 seconds every Ts = 10 seconds.
+ *
+				 +-------------------------+
+				 | tsk        |  T  |  C   |		T is the period ( the server period Ts for T_Server ).
+				 +------------+-----+------|		C is the computation time ( the server budget Qs for T_Server ).
+				 | T_Periodic |  10 |  3   |
+				 | T_Server   |  10 |  2   |		The unit of time here is second.
+				 +-------------------------+
+
+				 A request to T_Server needs 5 seconds of execution which is more than its budget, So its deadline
+				 is postponed by Ts each time the budget is exhausted and T_Periodic is never delayed by it.
+				 The aperiodic load can't take more than Qs/Ts = 20% of the CPU.
+ *
+ * Language	:  	C
+ */
+
+/*
+*******************************************************************************
+*                               Includes Files                                *
+*******************************************************************************
+*/
+#include <bsp.h>
+#include <pretty_os.h>
+#include <uartstdio.h>
+
+/*
+*******************************************************************************
+*                                   Macros                                    *
+*******************************************************************************
+*/
+#define STACK_SIZE   (40U)
+
+/* Task's Parameters In Seconds.			*/
+#define Task_Periodic_P		10U
+#define Task_Periodic_C		3U
+
+#define Task_Server_Ts		10U
+#define Task_Server_Qs		2U
+
+#define Request_C			5U
+
+/*
+*******************************************************************************
+*                              Tasks Stacks                                   *
+*******************************************************************************
+*/
+
+OS_tSTACK stkTask_Periodic [STACK_SIZE];
+OS_tSTACK stkTask_Server   [STACK_SIZE];
+
+OS_tSTACK stkTask_Idle     [STACK_SIZE];
+
+/*
+*******************************************************************************
+*                                 Globals                                     *
+*******************************************************************************
+*/
+
+OS_SEM* 		request;
+
+/*
+*******************************************************************************
+*                              OS Hooks functions                             *
+*******************************************************************************
+*/
+
+void App_Hook_TaskIdle(void)
+{
+
+}
+
+/*
+*******************************************************************************
+*                              Tasks Definitions                              *
+*******************************************************************************
+*/
+
+void
+task_periodic(void* args) {
+
+	(void)args;
+
+    while (1) {
+
+    	printf("t[+%05d] | T_Periodic posts a request\n",OS_TickTimeGet()/OS_CONFIG_TICKS_PER_SEC);
+    	OS_SemPost(request);
+
+    	BSP_DelayMilliseconds(Task_Periodic_C*1000);
+
+    	if(OS_Is_CurrentTaskMissedDeadline())
+    	{
+    		printf("T_Periodic Missed its deadline ! \n");
+    	}
+
+    	OS_TaskYield();
+    }
+}
+
+void
+task_server(void* args) {
+
+	(void)args;
+
+    while (1) {
+
+    	OS_SemPend(request, 0);			/* The server deadline is assigned when the request arrives.				*/
+    	printf("t[+%05d] | T_Server  starts a request\n",OS_TickTimeGet()/OS_CONFIG_TICKS_PER_SEC);
+
+    	BSP_DelayMilliseconds(Request_C*1000);
+
+    	printf("t[+%05d] | T_Server  finishes the request\n",OS_TickTimeGet()/OS_CONFIG_TICKS_PER_SEC);
+    }
+}
+
+int main() {
+
+    /* Setup low level connected devices.   */
+    BSP_HardwareSetup();
+
+    /* Clear console terminal.              */
+    BSP_UART_ClearVirtualTerminal();
+
+    /* Initialize the Idle Task stack.      */
+    OS_Init(stkTask_Idle, sizeof(stkTask_Idle));
+
+    request = OS_SemCreate(0);
+
+    OS_TaskCreate(&task_periodic,
+                  OS_NULL(void),
+                  &stkTask_Periodic[0],
+                  sizeof(stkTask_Periodic),
+				  OS_TASK_PERIODIC,
+				  Task_Periodic_P*OS_CONFIG_TICKS_PER_SEC,Task_Periodic_P*OS_CONFIG_TICKS_PER_SEC);
+
+    OS_TaskCreate(&task_server,
+                  OS_NULL(void),
+                  &stkTask_Server[0],
+                  sizeof(stkTask_Server),
+				  OS_TASK_APERIODIC,
+				  Task_Server_Qs*OS_CONFIG_TICKS_PER_SEC,Task_Server_Ts*OS_CONFIG_TICKS_PER_SEC);
+
+    printf("[Info]: OS ticks per second: %d \n",OS_CONFIG_TICKS_PER_SEC);
+    printf("[Info]: Constant Bandwidth Server with EDF.\n\n");
+
+    /*  Transfer control to the RTOS to run the tasks.   */
+    OS_Run(BSP_CPU_FrequencyGet());
+
+    /*       Should never reach here.   */
+    for(;;);
+}
@@ -0,0 +1,168 @@
+/*****************************************************************************
+MIT License
+
+Copyright (c) 2020 Yahia Farghaly Ashour
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+/*
+ * Author   : Yahia Farghaly Ashour
+ *
+ * Purpose  : CPU usage as measured by the statistics task.
+ *
+ *            A load task busy-waits for LOAD_STEP_TICKS more in each period of LOAD_PERIOD_TICKS, then starts over
+ *            once it uses the whole period. A monitor task prints the smoothed and the peak CPU usage every second,
+ *            Which should follow the load of the task.
+ *
+ *            Requires OS_CONFIG_EDF_EN = OS_CONFIG_DISABLE, OS_CONFIG_TASK_RUNTIME_EN and OS_CONFIG_TASK_STAT_EN = OS_CONFIG_ENABLE.
+ *
+ * Language:  C
+ */
+
+/*
+*******************************************************************************
+*                               Includes Files                                *
+*******************************************************************************
+*/
+#include <bsp.h>
+#include <pretty_os.h>
+#include <uartstdio.h>
+
+/*
+*******************************************************************************
+*                                   Macros                                    *
+*******************************************************************************
+*/
+#define STACK_SIZE          (40U)
+#define PRIO_LOAD           (2U)
+#define PRIO_MONITOR        (3U)
+
+#define LOAD_PERIOD_TICKS   (OS_CONFIG_TICKS_PER_SEC / 10U)    /* The load task wakes up every 100 ms.      */
+#define LOAD_STEP_TICKS     (1U)                                /* Extra busy ticks after every report.      */
+
+/*
+*******************************************************************************
+*                              Tasks Stacks                                   *
+*******************************************************************************
+*/
+
+OS_tSTACK stkTask_Load    [STACK_SIZE];
+OS_tSTACK stkTask_Monitor [STACK_SIZE];
+OS_tSTACK stkTask_Idle    [STACK_SIZE];
+
+/*
+*******************************************************************************
+*                                 Globals                                     *
+*******************************************************************************
+*/
+volatile OS_TICK load_busy_ticks;
+
+/*
+*******************************************************************************
+*                              OS Hooks functions                             *
+*******************************************************************************
+*/
+
+void App_Hook_TaskIdle(void)
+{
+    /*  The statistics task measures the time of the idle task, It may sleep.  */
+}
+
+/*
+*******************************************************************************
+*                              Tasks Definitions                              *
+*******************************************************************************
+*/
+
+void
+task_load(void* args) {
+    OS_TICK start;
+
+    (void)args;
+
+    while (1) {
+        start = OS_TickTimeGet();
+        while ((OS_TickTimeGet() - start) < load_busy_ticks);  /* Busy for a part of the period.           */
+
+        if (load_busy_ticks < LOAD_PERIOD_TICKS) {
+            OS_DelayTicks(LOAD_PERIOD_TICKS - load_busy_ticks);
+        }
+    }
+}
+
+void
+task_monitor(void* args) {
+    OS_TIME period = { 0U, 0U, 1U, 0U};
+    CPU_t16U usage;
+    CPU_t16U peak;
+
+    (void)args;
+
+    printf("Load (%%), CPU Usage (%%), Peak (%%)\n");
+
+    while (1) {
+        OS_DelayTime(&period);
+
+        usage = OS_StatCPUUsageGet();
+        peak  = OS_StatCPUUsagePeakGet();
+        OS_StatCPUUsagePeakReset();
+
+        printf("%8u, %3u.%02u, %3u.%02u\n",
+               (unsigned)((load_busy_ticks * 100U) / LOAD_PERIOD_TICKS),
+               usage / 100U, usage % 100U, peak / 100U, peak % 100U);
+
+        load_busy_ticks = (load_busy_ticks + LOAD_STEP_TICKS) % (LOAD_PERIOD_TICKS + 1U);
+    }
+}
+
+int main() {
+
+    /* Setup low level connected devices.   */
+    BSP_HardwareSetup();
+
+    /* Clear console terminal.              */
+    BSP_UART_ClearVirtualTerminal();
+
+    /* Initialize the Idle Task stack, It creates the statistics task too.  */
+    OS_Init(stkTask_Idle, sizeof(stkTask_Idle));
+
+    load_busy_ticks = 0U;
+
+    OS_TaskCreate(&task_load,
+                  OS_NULL(void),
+                  stkTask_Load,
+                  sizeof(stkTask_Load),
+                  PRIO_LOAD);
+
+    OS_TaskCreate(&task_monitor,
+                  OS_NULL(void),
+                  stkTask_Monitor,
+                  sizeof(stkTask_Monitor),
+                  PRIO_MONITOR);
+
+    printf("[Info]: OS ticks per second: %d \n",OS_CONFIG_TICKS_PER_SEC);
+    printf("[Info]: CPU usage sampled every %u ms.\n\n", OS_CONFIG_TASK_STAT_RATE_MS);
+
+    /*  Transfer control to the RTOS to run the tasks.   */
+    OS_Run(BSP_CPU_FrequencyGet());
+
+    /*       Should never reach here.   */
+    for(;;);
+}
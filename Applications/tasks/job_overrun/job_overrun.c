@@ -0,0 +1,287 @@
+/*****************************************************************************
+MIT License
+
+Copyright (c) 2020 Yahia Farghaly Ashour
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+/*
+ * Author   : 	Yahia Farghaly Ashour
+ *
+ * Purpose  : This example demonstrates the overrun policies of the jobs which run out of their execution budget with EDF scheduling.
+ * 				Make sure you set OS_CONFIG_EDF_EN, OS_CONFIG_MUTEX_EN and OS_CONFIG_TASK_BUDGET_EN to OS_CONFIG_ENABLE.
+ *
+ * 				Every task is created with a budget C (its WCET) but each job executes for E which is longer,
+ * 				So every job overruns and the policy of its task is applied.
+ *
+				 +--------------------------------------------+
+				 | tsk      |  T  |  C  |  E  |  Policy        |		T is the period (= the relative deadline).
+				 +----------+-----+-----+-----+----------------|		C is the execution budget given to OS_TaskCreate().
+				 | T_Notify |  10 |  1  |  2  | NOTIFY         |		E is the actual computation time of a job.
+				 | T_Demote |  10 |  1  |  2  | DEMOTE         |
+				 | T_Skip   |  10 |  1  |  2  | SKIP           |		The unit of time here is second.
+				 | T_Abort  |  10 |  1  |  2  | ABORT          |
+				 | T_Locker |  10 |  1  |  2  | ABORT          |
+				 | T_Waiter |  10 |  1  |  0  | NOTIFY         |
+				 +--------------------------------------------+
+
+				 T_Notify  completes every job, The overrun is only counted.
+				 T_Demote  completes every job in background after the jobs which have a deadline.
+				 T_Skip    completes every job but its next job is skipped, So it runs every other period.
+				 T_Abort   never completes a job, It restarts from its entry point at every period.
+				 T_Locker  overruns while it owns a mutex (without a SRP ceiling), So its job is demoted instead of aborted
+				           and the mutex is always posted. T_Waiter pends on the mutex and never times out.
+ *
+ * Language	:  	C
+ */
+
+/*
+*******************************************************************************
+*                               Includes Files                                *
+*******************************************************************************
+*/
+#include <bsp.h>
+#include <pretty_os.h>
+#include <uartstdio.h>
+
+/*
+*******************************************************************************
+*                                   Macros                                    *
+*******************************************************************************
+*/
+#define STACK_SIZE   (40U)
+
+/* Task's Parameters In Seconds.			*/
+#define Task_P				10U
+#define Task_C				1U
+#define Task_E				2U
+
+#define Task_Waiter_Timeout	9U
+
+/*
+*******************************************************************************
+*                              Tasks Stacks                                   *
+*******************************************************************************
+*/
+
+OS_tSTACK stkTask_Notify  [STACK_SIZE];
+OS_tSTACK stkTask_Demote  [STACK_SIZE];
+OS_tSTACK stkTask_Skip    [STACK_SIZE];
+OS_tSTACK stkTask_Abort   [STACK_SIZE];
+OS_tSTACK stkTask_Locker  [STACK_SIZE];
+OS_tSTACK stkTask_Waiter  [STACK_SIZE];
+
+OS_tSTACK stkTask_Idle    [STACK_SIZE];
+
+/*
+*******************************************************************************
+*                                 Globals                                     *
+*******************************************************************************
+*/
+
+OS_MUTEX* 		mutex;
+
+/*
+*******************************************************************************
+*                              OS Hooks functions                             *
+*******************************************************************************
+*/
+
+void App_Hook_TaskIdle(void)
+{
+
+}
+
+/*
+*******************************************************************************
+*                              Tasks Definitions                              *
+*******************************************************************************
+*/
+
+static void
+job_report(const char* name) {
+
+	CPU_t32U misses;
+	CPU_t32U overruns;
+
+	OS_TaskJobStatsGet(&misses, &overruns);
+	printf("t[+%05d] | %s completes a job, overruns = %u, misses = %u\n",OS_TickTimeGet()/OS_CONFIG_TICKS_PER_SEC, name, overruns, misses);
+}
+
+void
+task_notify(void* args) {
+
+	(void)args;
+
+    while (1) {
+
+    	BSP_DelayMilliseconds(Task_E*1000);
+    	job_report("T_Notify");
+
+    	OS_TaskYield();
+    }
+}
+
+void
+task_demote(void* args) {
+
+	(void)args;
+
+    while (1) {
+
+    	BSP_DelayMilliseconds(Task_E*1000);
+    	job_report("T_Demote");
+
+    	OS_TaskYield();
+    }
+}
+
+void
+task_skip(void* args) {
+
+	(void)args;
+
+    while (1) {
+
+    	BSP_DelayMilliseconds(Task_E*1000);
+    	job_report("T_Skip  ");
+
+    	OS_TaskYield();
+    }
+}
+
+void
+task_abort(void* args) {
+
+	(void)args;
+
+	printf("t[+%05d] | T_Abort  starts from its entry point\n",OS_TickTimeGet()/OS_CONFIG_TICKS_PER_SEC);
+
+    while (1) {
+
+    	BSP_DelayMilliseconds(Task_E*1000);
+    	job_report("T_Abort ");			/* Never reached, The job is aborted at its budget.		*/
+
+    	OS_TaskYield();
+    }
+}
+
+void
+task_locker(void* args) {
+
+	(void)args;
+
+    while (1) {
+
+    	OS_MutexPend(mutex, 0);
+    	BSP_DelayMilliseconds(Task_E*1000);
+    	OS_MutexPost(mutex);
+    	job_report("T_Locker");
+
+    	OS_TaskYield();
+    }
+}
+
+void
+task_waiter(void* args) {
+
+	(void)args;
+
+    while (1) {
+
+    	OS_MutexPend(mutex, Task_Waiter_Timeout*OS_CONFIG_TICKS_PER_SEC);
+    	if(OS_ERRNO != OS_ERR_NONE)
+    	{
+    		printf("t[+%05d] | T_Waiter timed out on the mutex !\n",OS_TickTimeGet()/OS_CONFIG_TICKS_PER_SEC);
+    	}
+    	else
+    	{
+    		printf("t[+%05d] | T_Waiter locks   the mutex\n",OS_TickTimeGet()/OS_CONFIG_TICKS_PER_SEC);
+    		OS_MutexPost(mutex);
+    	}
+
+    	OS_TaskYield();
+    }
+}
+
+int main() {
+
+    /* Setup low level connected devices.   */
+    BSP_HardwareSetup();
+
+    /* Clear console terminal.              */
+    BSP_UART_ClearVirtualTerminal();
+
+    /* Initialize the Idle Task stack.      */
+    OS_Init(stkTask_Idle, sizeof(stkTask_Idle));
+
+    mutex = OS_MutexCreate(0U, OS_MUTEX_PRIO_CEIL_DISABLE);
+
+    OS_TaskCreate(&task_notify,
+                  OS_NULL(void),
+                  &stkTask_Notify[0],
+                  sizeof(stkTask_Notify),
+				  OS_TASK_PERIODIC | OS_TASK_OVERRUN_NOTIFY,
+				  Task_P*OS_CONFIG_TICKS_PER_SEC,Task_P*OS_CONFIG_TICKS_PER_SEC,Task_C*OS_CONFIG_TICKS_PER_SEC);
+
+    OS_TaskCreate(&task_demote,
+                  OS_NULL(void),
+                  &stkTask_Demote[0],
+                  sizeof(stkTask_Demote),
+				  OS_TASK_PERIODIC | OS_TASK_OVERRUN_DEMOTE,
+				  Task_P*OS_CONFIG_TICKS_PER_SEC,Task_P*OS_CONFIG_TICKS_PER_SEC,Task_C*OS_CONFIG_TICKS_PER_SEC);
+
+    OS_TaskCreate(&task_skip,
+                  OS_NULL(void),
+                  &stkTask_Skip[0],
+                  sizeof(stkTask_Skip),
+				  OS_TASK_PERIODIC | OS_TASK_OVERRUN_SKIP,
+				  Task_P*OS_CONFIG_TICKS_PER_SEC,Task_P*OS_CONFIG_TICKS_PER_SEC,Task_C*OS_CONFIG_TICKS_PER_SEC);
+
+    OS_TaskCreate(&task_abort,
+                  OS_NULL(void),
+                  &stkTask_Abort[0],
+                  sizeof(stkTask_Abort),
+				  OS_TASK_PERIODIC | OS_TASK_OVERRUN_ABORT,
+				  Task_P*OS_CONFIG_TICKS_PER_SEC,Task_P*OS_CONFIG_TICKS_PER_SEC,Task_C*OS_CONFIG_TICKS_PER_SEC);
+
+    OS_TaskCreate(&task_locker,
+                  OS_NULL(void),
+                  &stkTask_Locker[0],
+                  sizeof(stkTask_Locker),
+				  OS_TASK_PERIODIC | OS_TASK_OVERRUN_ABORT,
+				  Task_P*OS_CONFIG_TICKS_PER_SEC,Task_P*OS_CONFIG_TICKS_PER_SEC,Task_C*OS_CONFIG_TICKS_PER_SEC);
+
+    OS_TaskCreate(&task_waiter,
+                  OS_NULL(void),
+                  &stkTask_Waiter[0],
+                  sizeof(stkTask_Waiter),
+				  OS_TASK_PERIODIC,
+				  Task_P*OS_CONFIG_TICKS_PER_SEC,Task_P*OS_CONFIG_TICKS_PER_SEC,Task_C*OS_CONFIG_TICKS_PER_SEC);
+
+    printf("[Info]: OS ticks per second: %d \n",OS_CONFIG_TICKS_PER_SEC);
+    printf("[Info]: Job overrun policies with EDF.\n\n");
+
+    /*  Transfer control to the RTOS to run the tasks.   */
+    OS_Run(BSP_CPU_FrequencyGet());
+
+    /*       Should never reach here.   */
+    for(;;);
+}
@@ -0,0 +1,167 @@
+/*****************************************************************************
+MIT License
+
+Copyright (c) 2020 Yahia Farghaly Ashour
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+/*
+ * Author   : Yahia Farghaly Ashour
+ *
+ * Purpose  : Round Robin between tasks of the same priority.
+ *
+ *            WORKERS_COUNT busy workers share the same priority and each one counts its loop iterations.
+ *            The time quanta of each worker is its index in ticks, So a worker with a larger quanta
+ *            gets a bigger share of the CPU. A higher priority monitor task prints the counts every second.
+ *
+ *            Requires OS_CONFIG_EDF_EN = OS_CONFIG_DISABLE and OS_CONFIG_ROUND_ROBIN_EN = OS_CONFIG_ENABLE.
+ *
+ * Language:  C
+ */
+
+/*
+*******************************************************************************
+*                               Includes Files                                *
+*******************************************************************************
+*/
+#include <bsp.h>
+#include <pretty_os.h>
+#include <uartstdio.h>
+
+/*
+*******************************************************************************
+*                                   Macros                                    *
+*******************************************************************************
+*/
+#define STACK_SIZE          (40U)
+#define PRIO_WORKERS        (3U)                        /* All the workers share this priority.             */
+#define PRIO_MONITOR        (4U)
+#define WORKERS_COUNT       (4U)
+
+/*
+*******************************************************************************
+*                              Tasks Stacks                                   *
+*******************************************************************************
+*/
+
+OS_tSTACK stkTask_Worker  [WORKERS_COUNT][STACK_SIZE];
+OS_tSTACK stkTask_Monitor [STACK_SIZE];
+OS_tSTACK stkTask_Idle    [STACK_SIZE];
+
+/*
+*******************************************************************************
+*                                 Globals                                     *
+*******************************************************************************
+*/
+volatile unsigned long  worker_count [WORKERS_COUNT];
+unsigned long           worker_index [WORKERS_COUNT];
+
+/*
+*******************************************************************************
+*                              OS Hooks functions                             *
+*******************************************************************************
+*/
+
+void App_Hook_TaskIdle(void)
+{
+    /*  Application idle routine.    */
+}
+
+/*
+*******************************************************************************
+*                              Tasks Definitions                              *
+*******************************************************************************
+*/
+
+void
+task_worker(void* args) {
+    unsigned long idx = *(unsigned long*)args;
+
+    OS_TaskTimeQuantaSet(PRIO_WORKERS, idx + 1U);       /* Set the quanta of the calling worker.            */
+
+    while (1) {
+        ++worker_count[idx];
+    }
+}
+
+void
+task_monitor(void* args) {
+    OS_TIME period = { 0U, 0U, 1U, 0U};
+    unsigned long idx;
+    unsigned long total;
+
+    (void)args;
+
+    while (1) {
+        OS_DelayTime(&period);
+
+        total = 0U;
+        for (idx = 0U; idx < WORKERS_COUNT; ++idx) {
+            total += worker_count[idx];
+        }
+        if (total == 0U) {
+            continue;
+        }
+
+        for (idx = 0U; idx < WORKERS_COUNT; ++idx) {
+            printf("Worker#%lu [quanta: %lu ticks]: %3lu%%\n", idx, idx + 1U, (worker_count[idx] * 100U) / total);
+        }
+        printf("\n");
+    }
+}
+
+int main() {
+    unsigned long idx;
+
+    /* Setup low level connected devices.   */
+    BSP_HardwareSetup();
+
+    /* Clear console terminal.              */
+    BSP_UART_ClearVirtualTerminal();
+
+    /* Initialize the Idle Task stack.      */
+    OS_Init(stkTask_Idle, sizeof(stkTask_Idle));
+
+    /* Create the workers at the same priority. */
+    for (idx = 0U; idx < WORKERS_COUNT; ++idx) {
+        worker_index[idx] = idx;
+        OS_TaskCreate(&task_worker,
+                      (void*)&worker_index[idx],
+                      stkTask_Worker[idx],
+                      sizeof(stkTask_Worker[idx]),
+                      PRIO_WORKERS);
+    }
+
+    /* Create the monitor task.             */
+    OS_TaskCreate(&task_monitor,
+                  OS_NULL(void),
+                  stkTask_Monitor,
+                  sizeof(stkTask_Monitor),
+                  PRIO_MONITOR);
+
+    printf("[Info]: OS ticks per second: %d \n",OS_CONFIG_TICKS_PER_SEC);
+    printf("[Info]: %u workers share priority %u.\n\n", WORKERS_COUNT, PRIO_WORKERS);
+
+    /*  Transfer control to the RTOS to run the tasks.   */
+    OS_Run(BSP_CPU_FrequencyGet());
+
+    /*       Should never reach here.   */
+    for(;;);
+}
@@ -0,0 +1,183 @@
+/*****************************************************************************
+MIT License
+
+Copyright (c) 2020 Yahia Farghaly Ashour
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+/*
+ * Author   : Yahia Farghaly Ashour
+ *
+ * Purpose  : Stack high-water marks of the tasks.
+ *
+ *            A worker task calls a recursive function one level deeper every second, Till MAX_DEPTH levels then
+ *            starts over. A monitor task prints the used and the free bytes of the worker, Itself and the idle task
+ *            stacks. The worker used bytes should grow by about a frame of the function each second, Then stay at
+ *            its maximum since it's a high-water mark.
+ *
+ *            Requires OS_CONFIG_EDF_EN = OS_CONFIG_DISABLE and OS_CONFIG_TASK_STACK_USAGE_EN = OS_CONFIG_ENABLE.
+ *
+ * Language:  C
+ */
+
+/*
+*******************************************************************************
+*                               Includes Files                                *
+*******************************************************************************
+*/
+#include <bsp.h>
+#include <pretty_os.h>
+#include <uartstdio.h>
+
+/*
+*******************************************************************************
+*                                   Macros                                    *
+*******************************************************************************
+*/
+#define STACK_SIZE          (40U)
+#define STACK_SIZE_WORKER   (256U)
+#define PRIO_WORKER         (2U)
+#define PRIO_MONITOR        (3U)
+
+#define FRAME_WORDS         (16U)                               /* Local words of each recursion level.     */
+#define MAX_DEPTH           (8U)
+
+/*
+*******************************************************************************
+*                              Tasks Stacks                                   *
+*******************************************************************************
+*/
+
+OS_tSTACK stkTask_Worker  [STACK_SIZE_WORKER];
+OS_tSTACK stkTask_Monitor [STACK_SIZE];
+OS_tSTACK stkTask_Idle    [STACK_SIZE];
+
+/*
+*******************************************************************************
+*                                 Globals                                     *
+*******************************************************************************
+*/
+volatile CPU_t32U worker_depth;
+
+/*
+*******************************************************************************
+*                              OS Hooks functions                             *
+*******************************************************************************
+*/
+
+void App_Hook_TaskIdle(void)
+{
+    /*  The idle task refreshes the high-water marks before calling it.  */
+}
+
+/*
+*******************************************************************************
+*                              Tasks Definitions                              *
+*******************************************************************************
+*/
+
+CPU_t32U __attribute__((noinline))
+worker_recurse(CPU_t32U depth) {
+    CPU_t32U volatile frame[FRAME_WORDS];
+    CPU_t32U i;
+
+    for (i = 0U; i < FRAME_WORDS; i++)
+        frame[i] = depth + i;
+
+    if (depth > 1U)
+        frame[0] += worker_recurse(depth - 1U);
+
+    return frame[0];
+}
+
+void
+task_worker(void* args) {
+    OS_TIME period = { 0U, 0U, 1U, 0U};
+
+    (void)args;
+
+    while (1) {
+        worker_depth = (worker_depth % MAX_DEPTH) + 1U;
+        (void)worker_recurse(worker_depth);
+        OS_DelayTime(&period);
+    }
+}
+
+void
+print_usage(const char* name, OS_PRIO prio) {
+    CPU_tSTK_SIZE used;
+    CPU_tSTK_SIZE free;
+
+    if (OS_TaskStackUsageGet(prio, &used, &free) == OS_ERR_NONE) {
+        printf(" %s: %6u / %6u", name, (unsigned)used, (unsigned)(used + free));
+    }
+}
+
+void
+task_monitor(void* args) {
+    OS_TIME period = { 0U, 0U, 1U, 0U};
+
+    (void)args;
+
+    printf("Depth, Stack used / size (bytes)\n");
+
+    while (1) {
+        OS_DelayTime(&period);
+
+        printf("%5u,", (unsigned)worker_depth);
+        print_usage("worker",  PRIO_WORKER);
+        print_usage("monitor", PRIO_MONITOR);
+        print_usage("idle",    OS_IDLE_TASK_PRIO_LEVEL);
+        printf("\n");
+    }
+}
+
+int main() {
+
+    /* Setup low level connected devices.   */
+    BSP_HardwareSetup();
+
+    /* Clear console terminal.              */
+    BSP_UART_ClearVirtualTerminal();
+
+    /* Initialize the Idle Task stack.      */
+    OS_Init(stkTask_Idle, sizeof(stkTask_Idle));
+
+    OS_TaskCreate(&task_worker,
+                  OS_NULL(void),
+                  stkTask_Worker,
+                  sizeof(stkTask_Worker),
+                  PRIO_WORKER);
+
+    OS_TaskCreate(&task_monitor,
+                  OS_NULL(void),
+                  stkTask_Monitor,
+                  sizeof(stkTask_Monitor),
+                  PRIO_MONITOR);
+
+    printf("[Info]: OS ticks per second: %d \n",OS_CONFIG_TICKS_PER_SEC);
+    printf("[Info]: Stack words scanned per idle loop: %u\n\n", OS_CONFIG_TASK_STACK_SCAN_WORDS);
+
+    /*  Transfer control to the RTOS to run the tasks.   */
+    OS_Run(BSP_CPU_FrequencyGet());
+
+    /*       Should never reach here.   */
+    for(;;);
+}
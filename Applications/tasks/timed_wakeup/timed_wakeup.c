@@ -0,0 +1,222 @@
+/*****************************************************************************
+MIT License
+
+Copyright (c) 2020 Yahia Farghaly Ashour
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+/*
+ * Author   : Yahia Farghaly Ashour
+ *
+ * Purpose  : Test the delay list when a timed wait ends early by a post.
+ *
+ *            Each round, A pender task waits on a semaphore (or an event flag on odd rounds) with a timeout of
+ *            PEND_TICKS, Then a delayer task delays for DELAY_TICKS. The delayer sits behind the pender in the
+ *            delay list, So its ticks are stored relative to the pender. A poster task posts to the pender after
+ *            POST_TICKS, Which unlinks it from the list before its timeout. The delayer must still wake up after
+ *            exactly DELAY_TICKS, Each round prints OK or FAIL.
+ *
+ *            Requires OS_CONFIG_EDF_EN = OS_CONFIG_DISABLE.
+ *
+ * Language:  C
+ */
+
+/*
+*******************************************************************************
+*                               Includes Files                                *
+*******************************************************************************
+*/
+#include <bsp.h>
+#include <pretty_os.h>
+#include <uartstdio.h>
+
+/*
+*******************************************************************************
+*                                   Macros                                    *
+*******************************************************************************
+*/
+#define STACK_SIZE          (40U)
+#define PRIO_DELAYER        (2U)
+#define PRIO_PENDER         (3U)
+#define PRIO_POSTER         (4U)
+
+#define POST_TICKS          (3U)
+#define PEND_TICKS          (10U)
+#define DELAY_TICKS         (15U)
+#define ROUND_TICKS         (30U)
+#define ROUNDS              (10U)
+
+#define FLAG_POSTED         (0x01U)
+
+/*
+*******************************************************************************
+*                              Tasks Stacks                                   *
+*******************************************************************************
+*/
+
+OS_tSTACK stkTask_Delayer [STACK_SIZE];
+OS_tSTACK stkTask_Pender  [STACK_SIZE];
+OS_tSTACK stkTask_Poster  [STACK_SIZE];
+OS_tSTACK stkTask_Idle    [STACK_SIZE];
+
+/*
+*******************************************************************************
+*                                 Globals                                     *
+*******************************************************************************
+*/
+OS_SEM*            sem_go_pender;
+OS_SEM*            sem_go_delayer;
+OS_SEM*            sem_posted;
+OS_EVENT_FLAG_GRP* flag_posted;
+
+volatile CPU_t32U  round_num;
+volatile CPU_t32U  rounds_failed;
+
+/*
+*******************************************************************************
+*                              OS Hooks functions                             *
+*******************************************************************************
+*/
+
+void App_Hook_TaskIdle(void)
+{
+
+}
+
+/*
+*******************************************************************************
+*                              Tasks Definitions                              *
+*******************************************************************************
+*/
+
+void
+task_pender(void* args) {
+    (void)args;
+
+    while (1) {
+        OS_SemPend(sem_go_pender, 0U);
+
+        if (round_num & 1U) {
+            (void)OS_EVENT_FlagPend(flag_posted, FLAG_POSTED, OS_FLAG_WAIT_SET_ANY, OS_TRUE, PEND_TICKS);
+        } else {
+            OS_SemPend(sem_posted, PEND_TICKS);
+        }
+
+        if (OS_ERRNO != OS_ERR_NONE) {
+            printf("Round %2u: The pend was not posted (%d)\n", (unsigned)round_num, (int)OS_ERRNO);
+        }
+    }
+}
+
+void
+task_delayer(void* args) {
+    OS_TICK start;
+    OS_TICK elapsed;
+
+    (void)args;
+
+    while (1) {
+        OS_SemPend(sem_go_delayer, 0U);
+
+        start = OS_TickTimeGet();
+        OS_DelayTicks(DELAY_TICKS);
+        elapsed = OS_TickTimeGet() - start;
+
+        if (elapsed != DELAY_TICKS) {
+            ++rounds_failed;
+        }
+
+        printf("Round %2u (%s): delayed %u ticks, woke up after %u ticks [%s]\n",
+               (unsigned)round_num,
+               (round_num & 1U) ? "flag" : "sem ",
+               (unsigned)DELAY_TICKS,
+               (unsigned)elapsed,
+               (elapsed == DELAY_TICKS) ? "OK" : "FAIL");
+    }
+}
+
+void
+task_poster(void* args) {
+    (void)args;
+
+    for (round_num = 0U; round_num < ROUNDS; round_num++) {
+        OS_SemPost(sem_go_pender);                      /* Lower priority, They pend after this task delays.    */
+        OS_SemPost(sem_go_delayer);
+
+        OS_DelayTicks(POST_TICKS);
+
+        if (round_num & 1U) {
+            (void)OS_EVENT_FlagPost(flag_posted, FLAG_POSTED, OS_FLAG_SET);
+        } else {
+            OS_SemPost(sem_posted);
+        }
+
+        OS_DelayTicks(ROUND_TICKS);
+    }
+
+    printf("\n%u of %u rounds failed.\n", (unsigned)rounds_failed, (unsigned)ROUNDS);
+
+    for (;;) {
+        OS_DelayTicks(ROUND_TICKS);
+    }
+}
+
+int main() {
+
+    /* Setup low level connected devices.   */
+    BSP_HardwareSetup();
+
+    /* Clear console terminal.              */
+    BSP_UART_ClearVirtualTerminal();
+
+    /* Initialize the Idle Task stack.      */
+    OS_Init(stkTask_Idle, sizeof(stkTask_Idle));
+
+    sem_go_pender  = OS_SemCreate(0U);
+    sem_go_delayer = OS_SemCreate(0U);
+    sem_posted     = OS_SemCreate(0U);
+    flag_posted    = OS_EVENT_FlagCreate(0U);
+
+    OS_TaskCreate(&task_delayer,
+                  OS_NULL(void),
+                  stkTask_Delayer,
+                  sizeof(stkTask_Delayer),
+                  PRIO_DELAYER);
+
+    OS_TaskCreate(&task_pender,
+                  OS_NULL(void),
+                  stkTask_Pender,
+                  sizeof(stkTask_Pender),
+                  PRIO_PENDER);
+
+    OS_TaskCreate(&task_poster,
+                  OS_NULL(void),
+                  stkTask_Poster,
+                  sizeof(stkTask_Poster),
+                  PRIO_POSTER);
+
+    printf("[Info]: OS ticks per second: %d \n\n",OS_CONFIG_TICKS_PER_SEC);
+
+    /*  Transfer control to the RTOS to run the tasks.   */
+    OS_Run(BSP_CPU_FrequencyGet());
+
+    /*       Should never reach here.   */
+    for(;;);
+}
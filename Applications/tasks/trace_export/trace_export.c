@@ -0,0 +1,181 @@
+/*****************************************************************************
+MIT License
+
+Copyright (c) 2020 Yahia Farghaly Ashour
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+/*
+ * Author   : Yahia Farghaly Ashour
+ *
+ * Purpose  : Record a schedule with the kernel trace and export it to a Chrome/Perfetto trace JSON file.
+ *
+ *            A producer task posts a semaphore every few ticks, A consumer task pends on it and busy-waits
+ *            a little for each item. After TRACE_TICKS ticks, The recorder task stops the trace and writes
+ *            TRACE_FILE, Which can be opened by https://ui.perfetto.dev or chrome://tracing.
+ *
+ *            Requires the POSIX port, OS_CONFIG_EDF_EN = OS_CONFIG_DISABLE and OS_CONFIG_TRACE_EN = OS_CONFIG_ENABLE.
+ *
+ * Language:  C
+ */
+
+/*
+*******************************************************************************
+*                               Includes Files                                *
+*******************************************************************************
+*/
+#include <bsp.h>
+#include <pretty_os.h>
+#include <uartstdio.h>
+
+/*
+*******************************************************************************
+*                                   Macros                                    *
+*******************************************************************************
+*/
+#define STACK_SIZE          (40U)
+#define PRIO_CONSUMER       (2U)
+#define PRIO_PRODUCER       (3U)
+#define PRIO_RECORDER       (4U)
+
+#define PRODUCE_TICKS       (3U)                        /* An item is produced every 3 ticks.           */
+#define TRACE_TICKS         (OS_CONFIG_TICKS_PER_SEC)   /* The recorded window.                          */
+#define TRACE_FILE          "prettyos_trace.json"
+
+/*
+*******************************************************************************
+*                              Tasks Stacks                                   *
+*******************************************************************************
+*/
+
+OS_tSTACK stkTask_Consumer [STACK_SIZE];
+OS_tSTACK stkTask_Producer [STACK_SIZE];
+OS_tSTACK stkTask_Recorder [STACK_SIZE];
+OS_tSTACK stkTask_Idle     [STACK_SIZE];
+
+/*
+*******************************************************************************
+*                                 Globals                                     *
+*******************************************************************************
+*/
+OS_SEM* items;
+
+/*
+*******************************************************************************
+*                              OS Hooks functions                             *
+*******************************************************************************
+*/
+
+void App_Hook_TaskIdle(void)
+{
+    /*  Application idle routine.    */
+}
+
+/*
+*******************************************************************************
+*                              Tasks Definitions                              *
+*******************************************************************************
+*/
+
+void
+task_consumer(void* args) {
+    OS_TICK start;
+
+    (void)args;
+
+    while (1) {
+        OS_SemPend(items, 0U);
+
+        start = OS_TickTimeGet();
+        while (OS_TickTimeGet() == start);              /* Work till the next tick.                     */
+    }
+}
+
+void
+task_producer(void* args) {
+    (void)args;
+
+    while (1) {
+        OS_DelayTicks(PRODUCE_TICKS);
+        OS_SemPost(items);
+    }
+}
+
+void
+task_recorder(void* args) {
+    CPU_t32S count;
+
+    (void)args;
+
+    OS_TraceStart();                                    /* Drop the records of the start up.            */
+    OS_DelayTicks(TRACE_TICKS);
+    OS_TraceStop();
+
+    count = OS_CPU_TraceExport(TRACE_FILE);
+    if (count < 0) {
+        printf("[Error]: Can't write %s\n", TRACE_FILE);
+    } else {
+        printf("[Info]: %d records are written to %s\n", (int)count, TRACE_FILE);
+    }
+
+    while (1) {
+        OS_DelayTicks(TRACE_TICKS);
+    }
+}
+
+int main() {
+
+    /* Setup low level connected devices.   */
+    BSP_HardwareSetup();
+
+    /* Clear console terminal.              */
+    BSP_UART_ClearVirtualTerminal();
+
+    /* Initialize the Idle Task stack, The trace starts recording from here.   */
+    OS_Init(stkTask_Idle, sizeof(stkTask_Idle));
+
+    items = OS_SemCreate(0U);
+
+    OS_TaskCreate(&task_consumer,
+                  OS_NULL(void),
+                  stkTask_Consumer,
+                  sizeof(stkTask_Consumer),
+                  PRIO_CONSUMER);
+
+    OS_TaskCreate(&task_producer,
+                  OS_NULL(void),
+                  stkTask_Producer,
+                  sizeof(stkTask_Producer),
+                  PRIO_PRODUCER);
+
+    OS_TaskCreate(&task_recorder,
+                  OS_NULL(void),
+                  stkTask_Recorder,
+                  sizeof(stkTask_Recorder),
+                  PRIO_RECORDER);
+
+    printf("[Info]: OS ticks per second: %d \n",OS_CONFIG_TICKS_PER_SEC);
+    printf("[Info]: Recording %u ticks of %u records at most.\n\n", TRACE_TICKS, OS_CONFIG_TRACE_RECORDS);
+
+    /*  Transfer control to the RTOS to run the tasks.   */
+    OS_Run(BSP_CPU_FrequencyGet());
+
+    /*       Should never reach here.   */
+    for(;;);
+}
@@ -47,7 +47,11 @@ SOFTWARE.
 #error "CPU_CONFIG_COUNT_LEAD_ZEROS_ASM_PRESENT Must be defined in pretty_arch.h"
 #endif
 
-#if(CPU_CONFIG_COUNT_LEAD_ZEROS_ASM_PRESENT == 0U)
+#ifndef CPU_CONFIG_COUNT_LEAD_ZEROS_BUILTIN_PRESENT             /* Optional, The port may not define it.                            */
+#define CPU_CONFIG_COUNT_LEAD_ZEROS_BUILTIN_PRESENT     (0U)
+#endif
+
+#if(CPU_CONFIG_COUNT_LEAD_ZEROS_ASM_PRESENT == 0U) && (CPU_CONFIG_COUNT_LEAD_ZEROS_BUILTIN_PRESENT == 0U)
 
 /*
  * Fixed values of known leading zeros of numbers from 0x00 to 0xFF.
@@ -80,6 +84,28 @@ static const CPU_t08U CPU_CntLeadZerosTbl[256] = {
 extern "C" {
 #endif
 
+#if(CPU_CONFIG_COUNT_LEAD_ZEROS_BUILTIN_PRESENT == 1U)
+
+/*
+ * The compiler builtin is mapped to the CPU instruction if it exists, Otherwise the compiler
+ * provides its own optimized implementation. The result is undefined for zero, So it's checked first.
+ */
+CPU_tWORD CPU_CountLeadZeros(CPU_tWORD val)
+{
+    if(val == 0U)
+    {
+        return (CPU_tWORD)(CPU_CONFIG_DATA_SIZE_BITS);
+    }
+
+#if   (CPU_CONFIG_DATA_SIZE_BITS == CPU_WORD_SIZE_64)
+    return (CPU_tWORD)__builtin_clzll((unsigned long long)val);
+#else
+    return (CPU_tWORD)(__builtin_clz((unsigned int)val) - ((sizeof(unsigned int) * 8U) - CPU_CONFIG_DATA_SIZE_BITS));
+#endif
+}
+
+#else
+
 
 #if (CPU_CONFIG_DATA_SIZE_BITS == CPU_WORD_SIZE_08)
 CPU_tWORD static inline CntLeadZeros08 (CPU_t08U val)
@@ -189,6 +215,8 @@ CPU_tWORD CPU_CountLeadZeros(CPU_tWORD val)
     return (number_of_lead_zeros);
 }
 
+#endif      /* End of CPU_CONFIG_COUNT_LEAD_ZEROS_BUILTIN_PRESENT */
+
 #ifdef __cplusplus
 }
 #endif
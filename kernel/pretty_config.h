@@ -94,6 +94,73 @@ SOFTWARE.
 
 #define OS_CONFIG_SYSTEM_TIME_SET_GET_EN	(OS_CONFIG_ENABLE)
 
+/*=========  Enable/Disable Tickless Idle mode. ===============================*/
+/* The idle task asks the port to suppress the ticks until the next timed-wait expiry.
+ * Requires the port to implement OS_CPU_SystemTimerNextExpiry().               */
+
+#define OS_CONFIG_TICKLESS_EN				(OS_CONFIG_DISABLE)
+
+/*=========  Enable/Disable Round Robin between tasks of the same priority. ===*/
+/* Allows more than one task per priority level (Static priority scheduler only).
+ * Ready tasks of the same priority run in FIFO order, each for its time quanta. */
+
+#define OS_CONFIG_ROUND_ROBIN_EN			(OS_CONFIG_DISABLE)
+
+/*=========  Enable/Disable Binary Heaps for the EDF ready/inactive lists. ====*/
+/* O(log n) insertion/removal instead of the O(n) sorted linked list insertion.
+ * The list items can only be taken in order from the list head.                */
+
+#define OS_CONFIG_LIST_HEAP_EN				(OS_CONFIG_ENABLE)
+
+/*=========  Enable/Disable the admission test at the task creation. ==========*/
+/* OS_TaskCreate() takes the worst case execution time of the task jobs (and their
+ * period for the static priority scheduler) and refuses a task which makes the
+ * set of tasks not schedulable.                                                */
+
+#define OS_CONFIG_TASK_ADMISSION_EN			(OS_CONFIG_DISABLE)
+
+/*=========  Enable/Disable the execution budget of the EDF periodic jobs. ====*/
+/* OS_TaskCreate() takes the worst case execution time of the jobs, The tick
+ * handler charges the running job and applies the overrun policy of its task
+ * once the job runs longer than it.                                            */
+
+#define OS_CONFIG_TASK_BUDGET_EN			(OS_CONFIG_DISABLE)
+
+/*=========  Enable/Disable the CPU runtime accounting of the tasks. ==========*/
+/* The time between two context switches is added to the runtime of the task which
+ * was running, See OS_TaskRuntimeGet().
+ * Requires the port to implement OS_CPU_TimestampGet().                       */
+
+#define OS_CONFIG_TASK_RUNTIME_EN			(OS_CONFIG_DISABLE)
+
+/*=========  Enable/Disable the statistics task of the CPU usage. =============*/
+/* A statistics task compares the runtime of the idle task in every
+ * OS_CONFIG_TASK_STAT_RATE_MS window with the elapsed time, See OS_StatCPUUsageGet().
+ * Requires OS_CONFIG_TASK_RUNTIME_EN.                                         */
+
+#define OS_CONFIG_TASK_STAT_EN				(OS_CONFIG_DISABLE)
+
+/*=========  Enable/Disable the histograms of the dispatch latency. ===========*/
+/* The time from making a task ready till it's switched in is counted in a log2
+ * histogram of the task, See OS_TaskLatencyHistGet().
+ * Requires the port to implement OS_CPU_TimestampGet().                       */
+
+#define OS_CONFIG_TASK_LATENCY_EN			(OS_CONFIG_DISABLE)
+
+/*=========  Enable/Disable the trace recorder of the kernel events. ==========*/
+/* The context switches, ticks, ISRs, pend/post and memory calls are written as
+ * binary records in a ring buffer, See OS_TraceDump().
+ * Requires the port to implement OS_CPU_TimestampGet().                       */
+
+#define OS_CONFIG_TRACE_EN					(OS_CONFIG_DISABLE)
+
+/*=========  Enable/Disable the stack usage measurement of the tasks. =========*/
+/* The unused part of a task stack is painted with OS_TASK_STACK_PAINT at its
+ * creation, The painted words left at its far end are the stack never used,
+ * See OS_TaskStackUsageGet(). The idle task refreshes them in the background.  */
+
+#define OS_CONFIG_TASK_STACK_USAGE_EN		(OS_CONFIG_DISABLE)
+
 
 /******************************************************************************/
 /**********************	  Application Hooks Configs     ***********************/
@@ -129,6 +196,10 @@ SOFTWARE.
 
 #define OS_CONFIG_APP_STACK_OVERFLOW        (OS_CONFIG_DISABLE)
 
+/*= Enable/Disable Application specific code on an EDF job execution budget overrun. =*/
+
+#define OS_CONFIG_APP_TASK_OVERRUN          (OS_CONFIG_DISABLE)
+
 /********************************************************************************/
 /**********************	      Parameterized Configs	      ***********************/
 /********************************************************************************/
@@ -158,6 +229,34 @@ SOFTWARE.
 
 #define OS_CONFIG_MEMORY_PARTITION_COUNT							(10U)		/* Max. of Memory Partition Objects.	*/
 
+/*============== Default time quanta of a task in Round Robin mode. ============*/
+
+#define OS_CONFIG_ROUND_ROBIN_QUANTA_DEFAULT						(10U)		/* In ticks, 0 => No time slicing.		*/
+
+/*================ Priority of the statistics task (Static priority). ==========*/
+
+#define OS_CONFIG_TASK_STAT_PRIO									(OS_CONFIG_TASK_COUNT - 1U)	/* The highest to sample on time.	*/
+
+/*================ Stack size of the statistics task. =========================*/
+
+#define OS_CONFIG_TASK_STAT_STACK_SIZE								(128U)		/* In OS_tSTACK words.					*/
+
+/*================ Sampling window of the statistics task. ====================*/
+
+#define OS_CONFIG_TASK_STAT_RATE_MS									(100U)		/* In milliseconds.						*/
+
+/*================ Number of buckets of a latency histogram. ==================*/
+
+#define OS_CONFIG_TASK_LATENCY_BUCKETS								(24U)		/* Bucket i counts [2^i, 2^(i+1)).		*/
+
+/*================ Number of records of the trace ring buffer. ================*/
+
+#define OS_CONFIG_TRACE_RECORDS										(256U)		/* Required to be a power of 2.			*/
+
+/*================ Stack words checked by the idle task per loop. =============*/
+
+#define OS_CONFIG_TASK_STACK_SCAN_WORDS								(32U)		/* 0 => No background refresh.			*/
+
 
 /******************************************************************************/
 /************************* A U T O GENERATED MACROS ***************************/
@@ -165,32 +264,30 @@ SOFTWARE.
 
 #if(OS_CONFIG_EDF_EN == OS_CONFIG_ENABLE)
 
-/*============ The Current Code Doesn't Support Mutex with EDF. ==============*/
-#if(OS_CONFIG_MUTEX_EN == OS_CONFIG_ENABLE)
-	#undef 		OS_CONFIG_MUTEX_EN
-	#define 	OS_CONFIG_MUTEX_EN				(OS_CONFIG_DISABLE)
+/*============ Round Robin is only for the static priority scheduler. ========*/
+#if(OS_CONFIG_ROUND_ROBIN_EN == OS_CONFIG_ENABLE)
+	#undef 		OS_CONFIG_ROUND_ROBIN_EN
+	#define 	OS_CONFIG_ROUND_ROBIN_EN		(OS_CONFIG_DISABLE)
 #endif
 
-/*======= The Current Code Doesn't Support Semaphores with EDF. ==============*/
-#if(OS_CONFIG_SEMAPHORE_EN == OS_CONFIG_ENABLE)
-	#undef 		OS_CONFIG_SEMAPHORE_EN
-	#define 	OS_CONFIG_SEMAPHORE_EN			(OS_CONFIG_DISABLE)
+/*============ An aborted job restarts from the task entry point. ============*/
+#if(OS_CONFIG_TASK_BUDGET_EN == OS_CONFIG_ENABLE)
+	#undef 		OS_CONFIG_TCB_TASK_ENTRY_STORE_EN
+	#define 	OS_CONFIG_TCB_TASK_ENTRY_STORE_EN	(OS_CONFIG_ENABLE)
 #endif
 
-/*======= The Current Code Doesn't Support Mailboxes with EDF. ===============*/
-#if(OS_CONFIG_MAILBOX_EN == OS_CONFIG_ENABLE)
-	#undef 		OS_CONFIG_MAILBOX_EN
-	#define 	OS_CONFIG_MAILBOX_EN			(OS_CONFIG_DISABLE)
-#endif
+#else
 
-/*======= The Current Code Doesn't Support EventFlags with EDF. ==============*/
-#if(OS_CONFIG_FLAG_EN == OS_CONFIG_ENABLE)
-	#undef 		OS_CONFIG_FLAG_EN
-	#define 	OS_CONFIG_FLAG_EN				(OS_CONFIG_DISABLE)
+/*============ The job budgets are only for the EDF scheduler. ===============*/
+#if(OS_CONFIG_TASK_BUDGET_EN == OS_CONFIG_ENABLE)
+	#undef 		OS_CONFIG_TASK_BUDGET_EN
+	#define 	OS_CONFIG_TASK_BUDGET_EN		(OS_CONFIG_DISABLE)
 #endif
 
 #endif
 
+#define OS_AUTO_CONFIG_TASK_WCET		(OS_CONFIG_TASK_ADMISSION_EN || OS_CONFIG_TASK_BUDGET_EN)
+
 #define OS_AUTO_CONFIG_INCLUDE_EVENTS	(OS_CONFIG_SEMAPHORE_EN || OS_CONFIG_MUTEX_EN || OS_CONFIG_MAILBOX_EN)
 
 #define OS_AUTO_CONFIG_INCLUDE_LIST		(OS_CONFIG_EDF_EN)
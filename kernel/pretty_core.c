@@ -99,6 +99,9 @@ SOFTWARE.
     #define OS_AUTO_CONFIG_MAX_PRIO_ENTRIES     (1U)
 #endif
 
+                                                                    /* Number of group entries, Each bit in a group entry refers to a priority entry. */
+#define OS_AUTO_CONFIG_MAX_PRIO_GROUPS      ((OS_AUTO_CONFIG_MAX_PRIO_ENTRIES + OS_AUTO_CONFIG_CPU_BITS_PER_DATA_WORD - 1U) / OS_AUTO_CONFIG_CPU_BITS_PER_DATA_WORD)
+
 /*
 *******************************************************************************
 *                               static variables                              *
@@ -111,12 +114,35 @@ SOFTWARE.
  * (Accessible by task priority)                                              */
 static CPU_tWORD OS_TblReady		[OS_AUTO_CONFIG_MAX_PRIO_ENTRIES] = { 0U };
 
-/* Array of bit-mask of tasks that blocked due to time delay.
- * (Accessible by task priority)                                              */
-static CPU_tWORD OS_TblTimeBlocked	[OS_AUTO_CONFIG_MAX_PRIO_ENTRIES] = { 0U };
+/* Array of bit-mask of the non empty entries of OS_TblReady[].
+ * (Accessible by the entry position of a task priority)                      */
+static CPU_tWORD OS_TblReadyGrp		[OS_AUTO_CONFIG_MAX_PRIO_GROUPS] = { 0U };
+
+#if (OS_CONFIG_ROUND_ROBIN_EN == OS_CONFIG_ENABLE)
+
+/* Array of FIFO queues of the ready tasks, one queue per priority. Each entry
+ * points to the head of a circular list of ready TCBs, The head is the task
+ * to run at this priority. OS_TblReady[] marks the non empty queues.         */
+static OS_TASK_TCB* OS_TblReadyQueue [OS_CONFIG_TASK_COUNT];
+
+#endif
+
+#else
+
+/* The ready list items which are put aside by OS_ScheduleNext() because their
+ * jobs are not allowed to start by the SRP system ceiling.                   */
+static List_Item* OS_SRP_BlockedItems [OS_CONFIG_TASK_COUNT];
 
 #endif
 
+/* Head of the delta list of tasks that are blocked due to a time delay or a
+ * pend timeout. The list is sorted by expiry time and each TCB stores its
+ * remaining ticks relative to the TCB before it, So OS_TimerTick() only
+ * decrements the head and touches the tasks that actually expire.
+ * The flat tick cost is paid by the sorted insertion of OS_BlockTime(),
+ * Which is O(n) in the number of the timed waits.                            */
+static OS_TASK_TCB* OS_DelayListHead = OS_NULL(OS_TASK_TCB);
+
 /*
 *******************************************************************************
 *                               static functions                              *
@@ -131,6 +157,38 @@ static CPU_tWORD OS_TblTimeBlocked	[OS_AUTO_CONFIG_MAX_PRIO_ENTRIES] = { 0U };
 #endif
 
 	static void         OS_ScheduleNext(void);
+	static void         OS_TimerTickAdvance(OS_TICK ticks);
+
+#if (OS_CONFIG_TICKLESS_EN == OS_CONFIG_ENABLE)
+
+	static void         OS_TicklessIdle(void);
+
+#endif
+
+#if (OS_CONFIG_TASK_BUDGET_EN == OS_CONFIG_ENABLE)
+
+	static void         OS_TaskOverrun(OS_TASK_TCB* ptcb);
+
+#endif
+
+#if (OS_CONFIG_TASK_RUNTIME_EN == OS_CONFIG_ENABLE)
+
+	static void         OS_TaskRuntimeCharge(void);
+
+#endif
+
+#if (OS_CONFIG_TASK_LATENCY_EN == OS_CONFIG_ENABLE)
+
+	static void         OS_TaskLatencyStamp(OS_TASK_TCB* ptcb);
+	static void         OS_TaskLatencyRecord(OS_TASK_TCB* ptcb);
+
+#endif
+
+#if (OS_CONFIG_TASK_RUNTIME_EN == OS_CONFIG_ENABLE) || (OS_CONFIG_TASK_LATENCY_EN == OS_CONFIG_ENABLE)
+
+	static OS_TASK_TCB* OS_TaskTCBGet(OS_PRIO prio);
+
+#endif
 
 /*
 *******************************************************************************
@@ -176,6 +234,14 @@ OS_TASK_TCB*            OS_tblTCBPrio [OS_CONFIG_TASK_COUNT];
 	List OS_InactiveList;
 /* A Global variable which holds the number of created tasks that will be scheduled using EDF.					*/
 	OS_TASK_COUNT volatile OS_SystemTasksCount = 0;
+/* The Stack Resource Policy system ceiling, It's the shortest ceiling (relative deadline) of the locked Mutexes.
+ * A job can start only if its relative deadline is shorter than the system ceiling.							*/
+	OS_TICK volatile OS_SRP_SystemCeiling = OS_TICK_INFINITE;
+#endif
+
+#if (OS_CONFIG_TASK_RUNTIME_EN == OS_CONFIG_ENABLE)
+/* The port timestamp of the last context switch, The running task has consumed the time since then.			*/
+	static CPU_t64U OS_TaskRuntimeStamp;
 #endif
 
 /*
@@ -194,6 +260,14 @@ OS_IdleTask (void* args)
     while(1)
     {
 
+#if (OS_CONFIG_TASK_STACK_USAGE_EN == OS_CONFIG_ENABLE) && (OS_CONFIG_TASK_STACK_SCAN_WORDS > 0U)
+    	OS_TaskStackScan();		/* Refresh the stack high-water marks.		*/
+#endif
+
+#if (OS_CONFIG_TICKLESS_EN == OS_CONFIG_ENABLE)
+    	OS_TicklessIdle();		/* Suppress the ticks till the next expiry.	*/
+#endif
+
 #if(OS_CONFIG_CPU_IDLE == OS_CONFIG_ENABLE)
     	OS_CPU_Hook_Idle();		/* Call low level CPU idle routine.			*/
 #endif
@@ -210,6 +284,62 @@ OS_IdleTask (void* args)
     }
 }
 
+#if (OS_CONFIG_TICKLESS_EN == OS_CONFIG_ENABLE)
+/*
+ * Function:  OS_TicklessIdle
+ * --------------------
+ * Compute the number of ticks till the nearest timed-wait expiry and ask the port to
+ * suppress the tick interrupts until then. The port calls OS_TimerTickElapsed() on wake
+ * to catch up OS_TickTime.
+ *
+ * Arguments    : None.
+ *
+ * Returns      : None.
+ *
+ * Notes        : 1) Called only by the idle task, So no other task is ready to run.
+ *                2) OS_TICK_INFINITE is passed if there is no timed-wait at all.
+ */
+static void
+OS_TicklessIdle (void)
+{
+    OS_TICK ticks;
+    CPU_SR_ALLOC();
+
+    OS_CRTICAL_BEGIN();
+
+    if(OS_DelayListHead != OS_NULL(OS_TASK_TCB))            /* The head holds the ticks till the nearest expiry.          */
+    {
+        ticks = OS_DelayListHead->TASK_Ticks;
+    }
+    else
+    {
+        ticks = OS_TICK_INFINITE;
+    }
+
+#if(OS_CONFIG_EDF_EN == OS_CONFIG_ENABLE)
+    if(OS_InactiveList.itemsCnt != 0U)                      /* The inactive list is sorted by arrival times.              */
+    {
+        OS_TASK_TCB* ptcb = (OS_TASK_TCB*)OS_InactiveList.head->pOwner;
+        if(ptcb->EDF_params.tick_arrive <= OS_TickTime)
+        {
+            ticks = 1U;
+        }
+        else if(ptcb->EDF_params.tick_arrive - OS_TickTime < ticks)
+        {
+            ticks = ptcb->EDF_params.tick_arrive - OS_TickTime;
+        }
+    }
+#endif
+
+    if(ticks > 1U)                                          /* Nothing to gain for a single tick.                         */
+    {
+        OS_CPU_SystemTimerNextExpiry(ticks);
+    }
+
+    OS_CRTICAL_END();
+}
+#endif
+
 /*
 *******************************************************************************
 *                                                                             *
@@ -248,6 +378,10 @@ OS_Init (CPU_tSTK* pStackBaseIdleTask, CPU_tSTK  stackSizeIdleTask)
 #endif
     OS_Running          = OS_FAlSE;
 
+#if (OS_CONFIG_TRACE_EN == OS_CONFIG_ENABLE)
+    OS_TraceInit();									/* Start recording before the first task is created.			*/
+#endif
+
 #if (OS_AUTO_CONFIG_INCLUDE_LIST == OS_CONFIG_ENABLE)
 
     list_Init(&OS_ReadyList);
@@ -270,11 +404,28 @@ OS_Init (CPU_tSTK* pStackBaseIdleTask, CPU_tSTK  stackSizeIdleTask)
     for(idx = 0; idx < OS_AUTO_CONFIG_MAX_PRIO_ENTRIES; ++idx)
     {
         OS_TblReady[idx]        = 0U;
-        OS_TblTimeBlocked[idx]  = 0U;
     }
 
+    for(idx = 0; idx < OS_AUTO_CONFIG_MAX_PRIO_GROUPS; ++idx)
+    {
+        OS_TblReadyGrp[idx]     = 0U;
+    }
+
+#if (OS_CONFIG_ROUND_ROBIN_EN == OS_CONFIG_ENABLE)
+    for(idx = 0; idx < OS_CONFIG_TASK_COUNT; ++idx)
+    {
+        OS_TblReadyQueue[idx]   = OS_NULL(OS_TASK_TCB);
+    }
+#endif
+
+#else
+
+    OS_SRP_SystemCeiling = OS_TICK_INFINITE;
+
 #endif
 
+    OS_DelayListHead = OS_NULL(OS_TASK_TCB);
+
 #if (OS_AUTO_CONFIG_INCLUDE_EVENTS == OS_CONFIG_ENABLE)
 
     OS_Event_FreeListInit();
@@ -291,7 +442,13 @@ OS_Init (CPU_tSTK* pStackBaseIdleTask, CPU_tSTK  stackSizeIdleTask)
                         OS_NULL(void),
                         pStackBaseIdleTask,
                         stackSizeIdleTask,
+#if (OS_CONFIG_TASK_ADMISSION_EN == OS_CONFIG_ENABLE)
+                        OS_IDLE_TASK_PRIO_LEVEL,
+                        0U,                     /* The idle task is not accounted by the admission test.   */
+                        0U);
+#else
                         OS_IDLE_TASK_PRIO_LEVEL);
+#endif
 
 #else
 
@@ -301,7 +458,12 @@ OS_Init (CPU_tSTK* pStackBaseIdleTask, CPU_tSTK  stackSizeIdleTask)
             stackSizeIdleTask,
 			OS_TASK_PERIODIC,
 			(CPU_tWORD)0xFFFFFFFF,	 /* Dummy Value, Doesn't affect the creation of the idle task.										*/
+#if (OS_AUTO_CONFIG_TASK_WCET == OS_CONFIG_ENABLE)
+			OS_CONFIG_TICKS_PER_SEC, /* Dummy Value, Doesn't affect the creation of the idle task.										*/
+			0U);					 /* The idle task has no execution budget.															*/
+#else
 			OS_CONFIG_TICKS_PER_SEC);/* Dummy Value, Doesn't affect the creation of the idle task.										*/
+#endif
 
 #if(OS_CONFIG_ERRNO_EN == OS_CONFIG_ENABLE)
     ret = OS_ERRNO;
@@ -309,6 +471,13 @@ OS_Init (CPU_tSTK* pStackBaseIdleTask, CPU_tSTK  stackSizeIdleTask)
     ret = OS_ERR_NONE;
 #endif
 
+#endif
+
+#if (OS_CONFIG_TASK_STAT_EN == OS_CONFIG_ENABLE)
+    if(ret == OS_ERR_NONE)
+    {
+    	ret = OS_StatTaskInit();	/* Create the statistics task.				*/
+    }
 #endif
 
     return (ret);
@@ -340,6 +509,7 @@ OS_IntEnter (void)
         {
             ++OS_IntNestingLvl;
         }
+        OS_TRACE(OS_TRACE_EV_INT_ENTER, OS_currentTask, OS_NULL(void));
     }
 }
 
@@ -366,6 +536,7 @@ OS_IntExit (void)
     if(OS_TRUE == OS_Running)                           /* The kernel has already started.                            	*/
     {
         OS_CRTICAL_BEGIN();
+        OS_TRACE(OS_TRACE_EV_INT_EXIT, OS_currentTask, OS_NULL(void));
         if(OS_IntNestingLvl > 0U)                       /* Prevent OS_IntNestingLvl from wrapping                     	*/
         {
             --OS_IntNestingLvl;
@@ -375,13 +546,18 @@ OS_IntExit (void)
         {
             if(0U == OS_LockSchedNesting)               /* ... and not locked                                          	*/
             {
-#if(OS_CONFIG_EDF_EN == OS_CONFIG_DISABLE)				/* Active this section in static priority based scheduling.		*/
                 OS_ScheduleNext();                   	/* Determine the next high task to run.                        	*/
                 if(OS_nextTask != OS_currentTask)       /* No context switch if the current task is the highest.       	*/
                 {
+#if (OS_CONFIG_TASK_RUNTIME_EN == OS_CONFIG_ENABLE)
+                    OS_TaskRuntimeCharge();             /* Charge the preempted task till the switch.                  	*/
+#endif
+#if (OS_CONFIG_TASK_LATENCY_EN == OS_CONFIG_ENABLE)
+                    OS_TaskLatencyRecord(OS_nextTask);  /* The next task waited the CPU since it was made ready.       	*/
+#endif
+                    OS_TRACE(OS_TRACE_EV_TASK_SWITCH, OS_nextTask, OS_NULL(void));
                     OS_CPU_InterruptContexSwitch();     /* Perform a CPU specific code for interrupt context switch.   	*/
                 }
-#endif
             }
         }
 
@@ -454,7 +630,6 @@ OS_SchedUnlock (void)
                 --OS_LockSchedNesting;                 /* Decrement lock nesting level                       */
                 if(0U == OS_LockSchedNesting)          /* Call the scheduler if lock reached to 0            */
                 {
-                    OS_CRTICAL_END();
                     OS_Sched();
                 }
             }
@@ -491,6 +666,13 @@ OS_Sched (void)
             OS_ScheduleNext();                   	/* Determine the next high task to run.                        */
             if(OS_nextTask != OS_currentTask)       /* No context switch if the current task is the highest.       */
             {
+#if (OS_CONFIG_TASK_RUNTIME_EN == OS_CONFIG_ENABLE)
+                OS_TaskRuntimeCharge();             /* Charge the running task till the switch.                    */
+#endif
+#if (OS_CONFIG_TASK_LATENCY_EN == OS_CONFIG_ENABLE)
+                OS_TaskLatencyRecord(OS_nextTask);  /* The next task waited the CPU since it was made ready.       */
+#endif
+                OS_TRACE(OS_TRACE_EV_TASK_SWITCH, OS_nextTask, OS_NULL(void));
                 OS_CPU_ContexSwitch();              /* Perform a CPU specific code for task context switch.        */
             }
         }
@@ -511,6 +693,9 @@ OS_Sched (void)
  *
  * Notes        : 1) Interrupts are assumed to be disabled.
  *                2) This function is internal to PrettyOS functions.
+ *                3) In EDF, the jobs enter the inactive list when they yield and the ready list when the tick releases them.
+ *                   Only the running job is re-inserted here, So the cost doesn't depend on the number of tasks.
+ *                4) In EDF, the running job is kept on a deadline tie.
  */
 void
 OS_ScheduleNext (void)
@@ -521,6 +706,9 @@ OS_ScheduleNext (void)
 
 	OS_PRIO OS_HighPrio =  OS_PriorityHighestGet();
 
+#if (OS_CONFIG_ROUND_ROBIN_EN == OS_CONFIG_ENABLE)
+    OS_nextTask = OS_TblReadyQueue[OS_HighPrio];            /* The head of the highest priority ready queue.                */
+#else
     if(OS_IDLE_TASK_PRIO_LEVEL == OS_HighPrio)
     {
         OS_nextTask = OS_tblTCBPrio[OS_IDLE_TASK_PRIO_LEVEL];
@@ -529,56 +717,66 @@ OS_ScheduleNext (void)
     {
         OS_nextTask = OS_tblTCBPrio[OS_HighPrio];
     }
+#endif
 #else
 
     /* 							Earliest Deadline Scheduling.					*/
     
-    OS_TASK_COUNT tskcnt = 1;
-    OS_TASK_TCB* ptcb = OS_tblTCBPrio[1];
+    OS_TASK_TCB* idle = (OS_TASK_TCB*)OS_TCBList[0].pOwner;
+    OS_TASK_TCB* rdy_tsk;
+    CPU_tWORD    blocked = 0U;
+    OS_BOOLEAN   cur_ready;
+
+    cur_ready = (OS_currentTask != OS_NULL(OS_TASK_TCB) && OS_currentTask != idle &&	/* The running job was removed from the ready list when it was dispatched, ...	*/
+                 OS_currentTask->EDF_params.task_yield == OS_FAlSE &&	/* ... If it has not yielded or blocked ...														*/
+                 OS_currentTask->pListItemOwner->pList == OS_NULL(List));	/* ... and was not made ready again, It competes with the released jobs.					*/
 
-    while(ptcb)													/* While there are tasks more than Idle task ...												*/
+    OS_nextTask = idle;											/* Schedule the Idle task if no job is ready to run.											*/
+
+    while(OS_ReadyList.itemsCnt != 0U)							/* Is any task in the ready list ?																*/
     {
-    	if(ptcb->pListItemOwner->pList == OS_NULL(List))		/* ... and the task is not belong to a Ready or Pending list.									*/
+    	rdy_tsk = (OS_TASK_TCB*)OS_ReadyList.head->pOwner;		/* Extract The TCB with lowest deadline to be dispatched.		 								*/
+
+    	if(rdy_tsk->EDF_params.tick_arrive > OS_TickTime)		/* The task is ready but not in the right time, so schedule Idle task.							*/
+    	{
+    		break;
+    	}
+
+    	if(rdy_tsk->EDF_params.task_started == OS_TRUE ||		/* Stack Resource Policy: A job which has already started or ...								*/
+    	   rdy_tsk->EDF_params.tick_relative_deadline < OS_SRP_SystemCeiling) /* ... whose preemption level is above the system ceiling can run.				*/
     	{
-			if((ptcb->EDF_params.tick_absolute_deadline - ptcb->EDF_params.tick_arrive) <= OS_TickTime)
-			{													/*... and the difference between its deadline and arrival is before the current time. 			*/
-																/* Then, insert this task to the ready list which will be sorted according to its deadline. 	*/
-				ptcb->pListItemOwner->itemVal = ptcb->EDF_params.tick_absolute_deadline;
-				listItemInsert(&OS_ReadyList,ptcb->pListItemOwner);
-			}
+			OS_nextTask = rdy_tsk;								/* The earliest deadline job which can run.														*/
+			break;
     	}
 
-        ++tskcnt;
-        ptcb = OS_tblTCBPrio[tskcnt];							/* See the next task's TCB.																		*/
+    	OS_SRP_BlockedItems[blocked++] = OS_ReadyList.head;		/* Blocked by the system ceiling, Look at the next earliest deadline.							*/
+    	(void)ListItemRemove(OS_ReadyList.head);
     }
 
-    if(OS_ReadyList.itemsCnt != 0U)								/* Is any task in the ready list ?																*/
+    while(blocked > 0U)											/* Return the blocked jobs to the ready list.													*/
     {
-    	OS_TASK_TCB* rdy_tsk = (OS_TASK_TCB*)OS_ReadyList.head->pOwner;		/* Extract The TCB with lowest deadline to be dispatched.		 					*/
+    	listItemInsert(&OS_ReadyList,OS_SRP_BlockedItems[--blocked]);
+    }
 
-    	if(rdy_tsk->EDF_params.tick_arrive <= OS_TickTime)		/* Dispatch the ready task if its arrival time come or less than the current time.       		*/
-		{
-			OS_nextTask = rdy_tsk;								/* Dispatch by making the TCB the next TCB to run.												*/
-			OS_nextTask->EDF_params.task_yield = OS_FAlSE;		/* Reset the yield to be false so it will be scheduled on the next context switch.				*/
-			(void)ListItemRemove(OS_ReadyList.head);			/* Remove the Dispatched TCB from the ready list.												*/
-		}
-    	else
-    	{
-    															/* Else, the task is ready but not in the right time, so schedule Idle task. 					*/
-    		OS_nextTask = (OS_TASK_TCB*)OS_TCBList[0].pOwner;
-    	}
+    if(cur_ready == OS_TRUE &&
+       (OS_nextTask == idle ||									/* Keep the running job unless a job with a strictly earlier deadline is released, ...			*/
+        OS_currentTask->EDF_params.tick_absolute_deadline <= OS_nextTask->EDF_params.tick_absolute_deadline))
+    {
+    	OS_nextTask = OS_currentTask;							/* ... So jobs with equal deadlines don't preempt each other on every tick.						*/
+    	return;
     }
-    else
+
+    if(cur_ready == OS_TRUE)									/* The running job is preempted, Put it back to the ready list.									*/
     {
-    															/* No Ready Tasks are available. 																*/
-    	if(OS_currentTask->EDF_params.task_yield == OS_TRUE)
-    	{
-    		OS_nextTask = (OS_TASK_TCB*)OS_TCBList[0].pOwner;	/* The Current task wants to yield & No Ready Tasks. So, schedule Idle task.					*/
-    	}
-    	else
-    	{
-    		OS_nextTask = OS_currentTask;						/* Continue the current task execution.															*/
-    	}
+    	OS_currentTask->pListItemOwner->itemVal = OS_currentTask->EDF_params.tick_absolute_deadline;
+    	listItemInsert(&OS_ReadyList,OS_currentTask->pListItemOwner);
+    }
+
+    if(OS_nextTask != idle)
+    {
+		OS_nextTask->EDF_params.task_yield   = OS_FAlSE;		/* Reset the yield to be false so it will be scheduled on the next context switch.				*/
+		OS_nextTask->EDF_params.task_started = OS_TRUE;
+		(void)ListItemRemove(OS_nextTask->pListItemOwner);		/* Remove the Dispatched TCB from the ready list.												*/
     }
 
 #endif
@@ -609,6 +807,11 @@ OS_Run (CPU_t32U cpuClockFreq)
         OS_CRTICAL_BEGIN();
 
         OS_ScheduleNext();                         /* Find the highest priority task to be scheduled.                        */
+
+#if (OS_CONFIG_TASK_RUNTIME_EN == OS_CONFIG_ENABLE)
+        OS_TaskRuntimeStamp = OS_CPU_TimestampGet();   /* The first task runs from now on.                                   */
+#endif
+        OS_TRACE(OS_TRACE_EV_TASK_SWITCH, OS_nextTask, OS_NULL(void));
         OS_CPU_FirstStart();                       /* Start the highest task.                                                */
 
         OS_CRTICAL_END();                          /* Enable the processor interrupt in case accidentally it is not enabled. */
@@ -626,93 +829,308 @@ OS_Run (CPU_t32U cpuClockFreq)
  * Arguments    : None.
  *
  * Returns      : The highest priority number.
+ *
+ * Notes        :   1) The group table gives the highest non empty entry of OS_TblReady[] and the entry gives the
+ *                     highest priority, So it's two CLZ operations as long as the priorities fit in a single group
+ *                     entry (i.e OS_CONFIG_TASK_COUNT <= 1024 for a 32-bit CPU).
+ *                  2) The idle task is always ready, So the tables are never empty.
  */
 OS_PRIO inline
 OS_PriorityHighestGet (void)
 {
-    CPU_tWORD   *r_tbl;
-    OS_PRIO      prio;
-
-    prio  = (OS_AUTO_CONFIG_CPU_BITS_PER_DATA_WORD*OS_AUTO_CONFIG_MAX_PRIO_ENTRIES);
-    r_tbl = &OS_TblReady[OS_AUTO_CONFIG_MAX_PRIO_ENTRIES - 1U];
+    CPU_tWORD   grp;
+    CPU_tWORD   entry;
 
-    while (*r_tbl == (CPU_tWORD)0) {                    /* Loop Through Entries until find a non empty entry                */
-        prio -= OS_AUTO_CONFIG_CPU_BITS_PER_DATA_WORD;  /* Go Back by a Complete Entry                                      */
-        r_tbl = r_tbl - 1;
+    grp = OS_AUTO_CONFIG_MAX_PRIO_GROUPS - 1U;
+    while (OS_TblReadyGrp[grp] == (CPU_tWORD)0) {       /* Loop through the groups, Only one group for up to BITS^2 priorities. */
+        --grp;
     }
-    prio -= OS_AUTO_CONFIG_CPU_BITS_PER_DATA_WORD;
-    prio += ((OS_AUTO_CONFIG_CPU_BITS_PER_DATA_WORD - (CPU_tWORD)CPU_CountLeadZeros(*r_tbl)) - 1U);
-    return (prio);
+
+    entry  = (grp * OS_AUTO_CONFIG_CPU_BITS_PER_DATA_WORD);
+    entry += ((OS_AUTO_CONFIG_CPU_BITS_PER_DATA_WORD - (CPU_tWORD)CPU_CountLeadZeros(OS_TblReadyGrp[grp])) - 1U);
+
+    return (OS_PRIO)((entry * OS_AUTO_CONFIG_CPU_BITS_PER_DATA_WORD) +
+                     ((OS_AUTO_CONFIG_CPU_BITS_PER_DATA_WORD - (CPU_tWORD)CPU_CountLeadZeros(OS_TblReady[entry])) - 1U));
 }
 
 /*
- * Function:  OS_PrioritySet
+ * Function:  OS_SetReady
  * --------------------
- * Insert a task with a certain priority to the ready state.
+ * Insert a task to the ready state at its priority.
  *
- * Arguments    : prio    is the task's priority.
+ * Arguments    : ptcb    is a pointer to the TCB of the task.
  *
  * Returns      : None.
+ *
+ * Notes        :   1) With Round Robin, The task is appended at the tail of its priority ready queue.
+ *                     Setting an already ready task is ignored.
  */
 void inline
-OS_SetReady (OS_PRIO prio)
+OS_SetReady (OS_TASK_TCB* ptcb)
 {
+    OS_PRIO   prio          = ptcb->TASK_priority;
     CPU_tWORD bit_pos       = prio & (OS_AUTO_CONFIG_CPU_BITS_PER_DATA_WORD - 1);
     CPU_tWORD entry_pos     = prio >> OS_Log2(OS_AUTO_CONFIG_CPU_BITS_PER_DATA_WORD);
-    OS_TblReady[entry_pos] |= (1U << bit_pos);
+    CPU_tWORD grp_bit_pos   = entry_pos & (OS_AUTO_CONFIG_CPU_BITS_PER_DATA_WORD - 1);
+    CPU_tWORD grp_pos       = entry_pos >> OS_Log2(OS_AUTO_CONFIG_CPU_BITS_PER_DATA_WORD);
+
+#if (OS_CONFIG_ROUND_ROBIN_EN == OS_CONFIG_ENABLE)
+    OS_TASK_TCB* phead;
+
+    if(ptcb->OSTCB_ReadyNextPtr != OS_NULL(OS_TASK_TCB))    /* Already in the ready queue.                          */
+    {
+        return;
+    }
+
+    phead = OS_TblReadyQueue[prio];
+    if(phead == OS_NULL(OS_TASK_TCB))                       /* First ready task at this priority.                   */
+    {
+        ptcb->OSTCB_ReadyNextPtr = ptcb;
+        ptcb->OSTCB_ReadyPrevPtr = ptcb;
+        OS_TblReadyQueue[prio]   = ptcb;
+    }
+    else                                                    /* Append at the tail (i.e before the head).            */
+    {
+        ptcb->OSTCB_ReadyNextPtr = phead;
+        ptcb->OSTCB_ReadyPrevPtr = phead->OSTCB_ReadyPrevPtr;
+        phead->OSTCB_ReadyPrevPtr->OSTCB_ReadyNextPtr = ptcb;
+        phead->OSTCB_ReadyPrevPtr = ptcb;
+    }
+#endif
+
+    OS_TblReady[entry_pos]  |= ((CPU_tWORD)1U << bit_pos);
+    OS_TblReadyGrp[grp_pos] |= ((CPU_tWORD)1U << grp_bit_pos);
+
+#if (OS_CONFIG_TASK_LATENCY_EN == OS_CONFIG_ENABLE)
+    OS_TaskLatencyStamp(ptcb);
+#endif
+    OS_TRACE(OS_TRACE_EV_TASK_READY, ptcb, OS_NULL(void));
 }
 
 /*
- * Function:  OS_PriorityClear
+ * Function:  OS_RemoveReady
  * --------------------
- * Remove a task with a certain priority from the ready state.
+ * Remove a task from the ready state at its priority.
  *
- * Arguments    : prio    is the task's priority.
+ * Arguments    : ptcb    is a pointer to the TCB of the task.
  *
  * Returns      : None.
+ *
+ * Notes        :   1) With Round Robin, The priority stays ready as long as its ready queue is not empty.
  */
 void inline
-OS_RemoveReady (OS_PRIO prio)
+OS_RemoveReady (OS_TASK_TCB* ptcb)
 {
+    OS_PRIO   prio          = ptcb->TASK_priority;
     CPU_tWORD bit_pos       = prio & (OS_AUTO_CONFIG_CPU_BITS_PER_DATA_WORD - 1);
     CPU_tWORD entry_pos     = prio >> OS_Log2(OS_AUTO_CONFIG_CPU_BITS_PER_DATA_WORD);
-    OS_TblReady[entry_pos] &= ~(1U << bit_pos);
+    CPU_tWORD grp_bit_pos   = entry_pos & (OS_AUTO_CONFIG_CPU_BITS_PER_DATA_WORD - 1);
+    CPU_tWORD grp_pos       = entry_pos >> OS_Log2(OS_AUTO_CONFIG_CPU_BITS_PER_DATA_WORD);
+
+#if (OS_CONFIG_TASK_LATENCY_EN == OS_CONFIG_ENABLE)
+    ptcb->TASK_ReadyStamp = 0U;                             /* It's no longer waiting the CPU.                      */
+#endif
+
+#if (OS_CONFIG_ROUND_ROBIN_EN == OS_CONFIG_ENABLE)
+    if(ptcb->OSTCB_ReadyNextPtr == OS_NULL(OS_TASK_TCB))    /* Not in the ready queue.                              */
+    {
+        return;
+    }
+
+    if(ptcb->OSTCB_ReadyNextPtr != ptcb)                    /* Other tasks are still ready at this priority.        */
+    {
+        ptcb->OSTCB_ReadyPrevPtr->OSTCB_ReadyNextPtr = ptcb->OSTCB_ReadyNextPtr;
+        ptcb->OSTCB_ReadyNextPtr->OSTCB_ReadyPrevPtr = ptcb->OSTCB_ReadyPrevPtr;
+        if(OS_TblReadyQueue[prio] == ptcb)
+        {
+            OS_TblReadyQueue[prio] = ptcb->OSTCB_ReadyNextPtr;
+        }
+        ptcb->OSTCB_ReadyNextPtr = OS_NULL(OS_TASK_TCB);
+        ptcb->OSTCB_ReadyPrevPtr = OS_NULL(OS_TASK_TCB);
+        return;
+    }
+
+    ptcb->OSTCB_ReadyNextPtr = OS_NULL(OS_TASK_TCB);
+    ptcb->OSTCB_ReadyPrevPtr = OS_NULL(OS_TASK_TCB);
+    OS_TblReadyQueue[prio]   = OS_NULL(OS_TASK_TCB);
+#endif
+
+    OS_TblReady[entry_pos] &= ~((CPU_tWORD)1U << bit_pos);
+    if(OS_TblReady[entry_pos] == 0U)                    /* Clear the group bit if it was the last ready task in the entry.   */
+    {
+        OS_TblReadyGrp[grp_pos] &= ~((CPU_tWORD)1U << grp_bit_pos);
+    }
+}
+
+#else
+
+/*
+ * Function:  OS_SetReady
+ * --------------------
+ * Make a task ready to run by inserting it in the ready list ordered by its absolute deadline.
+ *
+ * Arguments    : ptcb    is a pointer to the TCB of the task.
+ *
+ * Returns      : None.
+ *
+ * Notes        :   1) Interrupts are assumed to be disabled.
+ *                  2) A task which is already in the ready or the inactive list is ignored.
+ *                  3) A server task (sporadic/aperiodic) keeps its deadline only if its remaining budget Cs can be consumed
+ *                     with the server bandwidth before it (i.e Cs <= (d - now) * Qs / Ts), Otherwise it's a new job of the
+ *                     server with a deadline of now + Ts and a full budget.
+ */
+void
+OS_SetReady (OS_TASK_TCB* ptcb)
+{
+    OS_EDF_SCHED_PARAMS* pedf = &ptcb->EDF_params;
+
+    if(ptcb->pListItemOwner->pList != OS_NULL(List))
+    {
+        return;
+    }
+
+    if(pedf->task_type != OS_TASK_PERIODIC)
+    {
+        if(pedf->tick_absolute_deadline <= OS_TickTime ||
+           (CPU_t64U)pedf->server_budget_left * pedf->task_period >=
+           (CPU_t64U)(pedf->tick_absolute_deadline - OS_TickTime) * pedf->server_budget)
+        {
+            pedf->tick_absolute_deadline = OS_TickTime + pedf->task_period;
+            pedf->server_budget_left     = pedf->server_budget;
+            pedf->task_started           = OS_FAlSE;
+        }
+    }
+
+    ptcb->pListItemOwner->itemVal = ptcb->EDF_params.tick_absolute_deadline;
+    listItemInsert(&OS_ReadyList,ptcb->pListItemOwner);
+
+#if (OS_CONFIG_TASK_LATENCY_EN == OS_CONFIG_ENABLE)
+    OS_TaskLatencyStamp(ptcb);
+#endif
+    OS_TRACE(OS_TRACE_EV_TASK_READY, ptcb, OS_NULL(void));
+}
+
+/*
+ * Function:  OS_RemoveReady
+ * --------------------
+ * Remove a task from the ready list.
+ *
+ * Arguments    : ptcb    is a pointer to the TCB of the task.
+ *
+ * Returns      : None.
+ *
+ * Notes        :   1) Interrupts are assumed to be disabled.
+ *                  2) The running task is not in the ready list, It's marked as yielded so OS_ScheduleNext()
+ *                     doesn't put it back until it's made ready again.
+ */
+void
+OS_RemoveReady (OS_TASK_TCB* ptcb)
+{
+    if(ptcb->pListItemOwner->pList == (void*)&OS_ReadyList)
+    {
+        (void)ListItemRemove(ptcb->pListItemOwner);
+    }
+    ptcb->EDF_params.task_yield = OS_TRUE;                  /* It gave up the CPU, OS_ScheduleNext() must not keep it running.  */
+
+#if (OS_CONFIG_TASK_LATENCY_EN == OS_CONFIG_ENABLE)
+    ptcb->TASK_ReadyStamp = 0U;                             /* It's no longer waiting the CPU.                                  */
+#endif
 }
 
+#endif
+
 /*
  * Function:  OS_BlockTime
  * --------------------
- * Put a task with a certain priority in the block time state.
+ * Put a task in the block time state by inserting its TCB in the delay list.
  *
- * Arguments    : prio    is the task's priority.
+ * Arguments    : ptcb    is a pointer to the TCB of the task. Its TASK_Ticks must hold the number of ticks to wait.
  *
  * Returns      : None.
+ *
+ * Notes        :   1) Interrupts are assumed to be disabled.
+ *                  2) The insertion walks the list to find the right position, So the cost is paid here at task level
+ *                     and not in OS_TimerTick(). It's O(n) in the number of the tasks in the delay list (at most
+ *                     OS_CONFIG_TASK_COUNT) and runs with the interrupts disabled, So it adds up to n list steps to the
+ *                     worst case interrupt latency of every delay and timed pend.
  */
-void inline
-OS_BlockTime (OS_PRIO prio)
+void
+OS_BlockTime (OS_TASK_TCB* ptcb)
 {
-    CPU_tWORD bit_pos             = prio & (OS_AUTO_CONFIG_CPU_BITS_PER_DATA_WORD - 1);
-    CPU_tWORD entry_pos           = prio >> OS_Log2(OS_AUTO_CONFIG_CPU_BITS_PER_DATA_WORD);
-    OS_TblTimeBlocked[entry_pos] |= (1U << bit_pos);
+    OS_TASK_TCB* pprev  = OS_NULL(OS_TASK_TCB);
+    OS_TASK_TCB* pnext  = OS_DelayListHead;
+    OS_TICK      ticks  = ptcb->TASK_Ticks;
+
+    while(pnext != OS_NULL(OS_TASK_TCB) && pnext->TASK_Ticks <= ticks)
+    {
+        ticks -= pnext->TASK_Ticks;                         /* Skip the TCBs which expire before (or with) this one.        */
+        pprev  = pnext;
+        pnext  = pnext->OSTCB_DelayNextPtr;
+    }
+
+    ptcb->TASK_Ticks         = ticks;                       /* Store the ticks relative to the previous TCB.                */
+    ptcb->OSTCB_DelayPrevPtr = pprev;
+    ptcb->OSTCB_DelayNextPtr = pnext;
+    ptcb->TASK_Stat         |= OS_TASK_STAT_DELAY;
+
+    if(pnext != OS_NULL(OS_TASK_TCB))
+    {
+        pnext->TASK_Ticks        -= ticks;                  /* The next TCB is now relative to this one.                    */
+        pnext->OSTCB_DelayPrevPtr = ptcb;
+    }
+
+    if(pprev != OS_NULL(OS_TASK_TCB))
+    {
+        pprev->OSTCB_DelayNextPtr = ptcb;
+    }
+    else
+    {
+        OS_DelayListHead = ptcb;
+    }
 }
 
 /*
  * Function:  OS_UnBlockTime
  * --------------------
- * Remove a task with a certain priority from the block time state.
+ * Remove a task from the block time state by removing its TCB from the delay list.
  *
- * Arguments    : prio    is the task's priority.
+ * Arguments    : ptcb    is a pointer to the TCB of the task.
  *
  * Returns      : None.
+ *
+ * Notes        :   1) Interrupts are assumed to be disabled.
+ *                  2) It does nothing if the task is not in the delay list (i.e OS_TASK_STAT_DELAY is not set).
  */
-void inline
-OS_UnBlockTime (OS_PRIO prio)
+void
+OS_UnBlockTime (OS_TASK_TCB* ptcb)
 {
-    CPU_tWORD bit_pos             = prio & (OS_AUTO_CONFIG_CPU_BITS_PER_DATA_WORD - 1);
-    CPU_tWORD entry_pos           = prio >> OS_Log2(OS_AUTO_CONFIG_CPU_BITS_PER_DATA_WORD);
-    OS_TblTimeBlocked[entry_pos] &= ~(1U << bit_pos);
+    if((ptcb->TASK_Stat & OS_TASK_STAT_DELAY) == 0U)
+    {
+        return;
+    }
+
+    if(ptcb->OSTCB_DelayNextPtr != OS_NULL(OS_TASK_TCB))
+    {
+        ptcb->OSTCB_DelayNextPtr->TASK_Ticks        += ptcb->TASK_Ticks;  /* Give the remaining ticks to the next TCB.      */
+        ptcb->OSTCB_DelayNextPtr->OSTCB_DelayPrevPtr = ptcb->OSTCB_DelayPrevPtr;
+    }
+
+    if(ptcb->OSTCB_DelayPrevPtr != OS_NULL(OS_TASK_TCB))
+    {
+        ptcb->OSTCB_DelayPrevPtr->OSTCB_DelayNextPtr = ptcb->OSTCB_DelayNextPtr;
+    }
+    else
+    {
+        OS_DelayListHead = ptcb->OSTCB_DelayNextPtr;
+    }
+
+    ptcb->OSTCB_DelayNextPtr = OS_NULL(OS_TASK_TCB);
+    ptcb->OSTCB_DelayPrevPtr = OS_NULL(OS_TASK_TCB);
+    ptcb->TASK_Ticks         = 0U;
+    ptcb->TASK_Stat         &= ~(OS_TASK_STAT_DELAY);
 }
 
+#if(OS_CONFIG_EDF_EN == OS_CONFIG_DISABLE)
 /*
  * Function:  OS_Log2
  * --------------------
@@ -790,20 +1208,114 @@ OS_MemoryByteClear (CPU_t08U* pdest, CPU_t32U size)
 void
 OS_TimerTick (void)
 {
-#if(OS_CONFIG_EDF_EN == OS_CONFIG_DISABLE)
-    CPU_tWORD i = 0;
-    CPU_tWORD workingSet;
-#endif
-    CPU_SR_ALLOC();
+    OS_TimerTickAdvance(1U);
+}
 
-#if (OS_CONFIG_SYSTEM_TIME_SET_GET_EN == OS_CONFIG_ENABLE)
-    OS_CRTICAL_BEGIN();
-    OS_TickTime += 1U;												/* Update System time of ticks.														*/
-    OS_CRTICAL_END();
+#if (OS_CONFIG_TICKLESS_EN == OS_CONFIG_ENABLE)
+/*
+ * Function:  OS_TimerTickElapsed
+ * --------------------
+ * Signal the occurrence of a number of "system ticks" at once. It's used by a tickless port
+ * to catch up the system time after the ticks were suppressed by OS_CPU_SystemTimerNextExpiry().
+ *
+ * Arguments    : ticks     is the number of ticks elapsed since the last announced tick.
+ *
+ * Returns      : None.
+ *
+ * Notes        : 1) This function must be called from a ticker ISR.
+ *                2) The tick hooks are called once per call and not once per tick.
+ */
+void
+OS_TimerTickElapsed (OS_TICK ticks)
+{
+    if(ticks > 0U)
+    {
+        OS_TimerTickAdvance(ticks);
+    }
+}
 #endif
 
-#if(OS_CONFIG_CPU_TIME_TICK == OS_CONFIG_ENABLE)
-    OS_CPU_Hook_TimeTick();											/* Call Port Specific Tick Hook.						  							*/
+#if (OS_CONFIG_TASK_BUDGET_EN == OS_CONFIG_ENABLE)
+
+/*
+ * Function:  OS_TaskOverrun
+ * --------------------
+ * Apply the overrun policy of a periodic task whose running job has exhausted its execution budget.
+ *
+ * Arguments    : ptcb    is a pointer to the TCB of the running task.
+ *
+ * Returns      : None.
+ *
+ * Notes        :   1) Interrupts are assumed to be disabled.
+ *                  2) An abort is applied as a demotion while the job owns a mutex, The system ceiling is raised or the scheduler
+ *                     is locked, Since an aborted job never posts its mutexes and a locked job can't be switched out.
+ */
+static void
+OS_TaskOverrun (OS_TASK_TCB* ptcb)
+{
+    OS_OPT policy = ptcb->EDF_params.task_overrun;
+
+    ++ptcb->EDF_params.job_overruns;
+
+#if (OS_CONFIG_APP_TASK_OVERRUN == OS_CONFIG_ENABLE)
+    App_Hook_TaskOverrun(ptcb);										/* Calls Application specific code for the overrun.												*/
+#endif
+
+    if(policy == OS_TASK_OVERRUN_ABORT &&
+       (ptcb->EDF_params.job_mutexes > 0U || OS_SRP_SystemCeiling != OS_TICK_INFINITE || OS_LockSchedNesting > 0U))
+    {
+        policy = OS_TASK_OVERRUN_DEMOTE;
+    }
+
+    switch(policy)
+    {
+    case OS_TASK_OVERRUN_DEMOTE:									/* Behind all the jobs which have a deadline, OS_TaskYield() restores the deadline of its next job.	*/
+        ptcb->EDF_params.tick_absolute_deadline = OS_TICK_INFINITE;
+        break;
+
+    case OS_TASK_OVERRUN_ABORT:										/* Drop the job, And queue its next job at the first period which is not released yet.			*/
+        while(ptcb->EDF_params.tick_arrive + ptcb->EDF_params.task_period <= OS_TickTime)
+        {
+            ptcb->EDF_params.tick_arrive += ptcb->EDF_params.task_period;
+        }
+        OS_TaskJobNext(ptcb);										/* It's not ready anymore, OS_IntExit() switches it out.										*/
+        break;
+
+    default:														/* OS_TASK_OVERRUN_NOTIFY or OS_TASK_OVERRUN_SKIP, The job keeps running.						*/
+        break;
+    }
+
+    ptcb->EDF_params.job_overrun = policy;							/* OS_TaskYield() skips the next job, Or the release restarts an aborted task.					*/
+}
+
+#endif
+
+/*
+ * Function:  OS_TimerTickAdvance
+ * --------------------
+ * Advance the system time by a number of ticks and release the tasks whose timed waits are expired.
+ *
+ * Arguments    : ticks     is the number of elapsed ticks.
+ *
+ * Returns      : None.
+ */
+static void
+OS_TimerTickAdvance (OS_TICK ticks)
+{
+    OS_TASK_TCB* ptcb;
+#if(OS_CONFIG_EDF_EN == OS_CONFIG_ENABLE)
+    OS_TICK      budget;
+#endif
+    CPU_SR_ALLOC();
+
+#if (OS_CONFIG_SYSTEM_TIME_SET_GET_EN == OS_CONFIG_ENABLE)
+    OS_CRTICAL_BEGIN();
+    OS_TickTime += ticks;											/* Update System time of ticks.														*/
+    OS_CRTICAL_END();
+#endif
+
+#if(OS_CONFIG_CPU_TIME_TICK == OS_CONFIG_ENABLE)
+    OS_CPU_Hook_TimeTick();											/* Call Port Specific Tick Hook.						  							*/
 #endif
 
 #if (OS_CONFIG_APP_TIME_TICK == OS_CONFIG_ENABLE)
@@ -817,61 +1329,123 @@ OS_TimerTick (void)
 
     OS_CRTICAL_BEGIN();
 
-#if(OS_CONFIG_EDF_EN == OS_CONFIG_DISABLE)
-    for(i = 0; i < OS_AUTO_CONFIG_MAX_PRIO_ENTRIES; i++)
+    OS_TRACE(OS_TRACE_EV_TICK, OS_currentTask, OS_NULL(void));
+
+#if(OS_CONFIG_EDF_EN == OS_CONFIG_ENABLE)
+    ptcb = OS_currentTask;
+    if(ptcb->EDF_params.task_type != OS_TASK_PERIODIC &&			/* Is the running task served by a CBS ?															*/
+       ptcb->EDF_params.task_yield == OS_FAlSE)
+    {
+        budget = ticks;
+        while(budget >= ptcb->EDF_params.server_budget_left)		/* Its budget is exhausted, Postpone its deadline by a server period and recharge the budget.	*/
+        {
+            budget -= ptcb->EDF_params.server_budget_left;
+            ptcb->EDF_params.server_budget_left      = ptcb->EDF_params.server_budget;
+            ptcb->EDF_params.tick_absolute_deadline += ptcb->EDF_params.task_period;
+        }
+        ptcb->EDF_params.server_budget_left -= budget;				/* OS_IntExit() re-inserts it in the ready list by its new deadline.							*/
+    }
+#if (OS_CONFIG_TASK_BUDGET_EN == OS_CONFIG_ENABLE)
+    else if(ptcb->EDF_params.task_yield == OS_FAlSE &&				/* Is the running job a periodic job with a budget ?											*/
+            ptcb->EDF_params.job_budget_left != 0U)
     {
-        if(OS_TblTimeBlocked[i] != 0U)
+        if(ptcb->EDF_params.job_budget_left > ticks)
+        {
+            ptcb->EDF_params.job_budget_left -= ticks;
+        }
+        else														/* It has run for its WCET and it's not finished yet.											*/
         {
-            workingSet = OS_TblTimeBlocked[i];
-            while(workingSet != 0U)
+            ptcb->EDF_params.job_budget_left  = 0U;
+            OS_TaskOverrun(ptcb);
+        }
+    }
+#endif
+#endif
+
+#if (OS_CONFIG_ROUND_ROBIN_EN == OS_CONFIG_ENABLE)
+    ptcb = OS_currentTask;
+    if(ptcb->TASK_TimeQuanta > 0U &&                                /* Is the running task time sliced and still ready ?                                */
+       ptcb->OSTCB_ReadyNextPtr != OS_NULL(OS_TASK_TCB))
+    {
+        if(ptcb->TASK_TimeQuantaCtr > ticks)
+        {
+            ptcb->TASK_TimeQuantaCtr -= ticks;
+        }
+        else                                                        /* Its time slice is over.                                                          */
+        {
+            ptcb->TASK_TimeQuantaCtr = ptcb->TASK_TimeQuanta;       /* Reload for its next turn.                                                        */
+            if(ptcb->OSTCB_ReadyNextPtr != ptcb)                    /* Other tasks are ready at the same priority ?                                     */
             {
-                CPU_tWORD task_pos = ((OS_AUTO_CONFIG_CPU_BITS_PER_DATA_WORD - (CPU_tWORD)CPU_CountLeadZeros(workingSet)) - 1U);
-                OS_TASK_TCB* t = OS_tblTCBPrio[ task_pos + (i * OS_AUTO_CONFIG_CPU_BITS_PER_DATA_WORD) ];
-                if(t != OS_NULL(OS_TASK_TCB))
-                {
-                    --(t->TASK_Ticks);
-                    if(0U == t->TASK_Ticks)                         /* No more ticks to tick                                                             */
-                    {
-                        t->TASK_Stat &= ~(OS_TASK_STAT_DELAY);      /* Clear the delay bit                                                               */
-                        OS_UnBlockTime(t->TASK_priority);
+                OS_RemoveReady(ptcb);                               /* Move it to the tail of its ready queue, OS_IntExit() switches to the next one.    */
+                OS_SetReady(ptcb);
+            }
+        }
+    }
+#endif
+
+    ptcb = OS_DelayListHead;
+    if(ptcb != OS_NULL(OS_TASK_TCB))
+    {
+        while(ptcb != OS_NULL(OS_TASK_TCB) && ptcb->TASK_Ticks <= ticks)
+        {                                                           /* No more ticks to tick                                                             */
+            ticks -= ptcb->TASK_Ticks;                              /* The rest of the list is relative to this TCB.                                     */
+            OS_DelayListHead = ptcb->OSTCB_DelayNextPtr;            /* Pop it from the delay list.                                                       */
+            if(OS_DelayListHead != OS_NULL(OS_TASK_TCB))
+            {
+                OS_DelayListHead->OSTCB_DelayPrevPtr = OS_NULL(OS_TASK_TCB);
+            }
+            ptcb->OSTCB_DelayNextPtr = OS_NULL(OS_TASK_TCB);
+            ptcb->TASK_Stat &= ~(OS_TASK_STAT_DELAY);               /* Clear the delay bit                                                               */
 
 #if (OS_AUTO_CONFIG_INCLUDE_EVENTS == OS_CONFIG_ENABLE)
 
-                        if(t->TASK_Stat & OS_TASK_STATE_PEND_ANY)
-                        {
-                            t->TASK_PendStat = OS_STAT_PEND_TIMEOUT;
-                        }
+            if(ptcb->TASK_Stat & OS_TASK_STATE_PEND_ANY)
+            {
+                ptcb->TASK_PendStat = OS_STAT_PEND_TIMEOUT;
+            }
 
 #endif
-                        /* If it's not waiting on any events or suspension,
-                           Add the current task to the ready table to be scheduled. */
-                        if((t->TASK_Stat & OS_TASK_STAT_SUSPENDED) == OS_TASK_STAT_READY)
-                        {
-                            OS_SetReady(t->TASK_priority);
-                        }
-                    }
-                }
-                workingSet &= ~(1U << task_pos);                /* Remove this processed bit and go to the next priority task in the same entry level. */
+            /* If it's not waiting on any events or suspension,
+               Add the current task to the ready table to be scheduled. */
+            if((ptcb->TASK_Stat & OS_TASK_STAT_SUSPENDED) == OS_TASK_STAT_READY)
+            {
+                OS_SetReady(ptcb);
             }
+
+            ptcb = OS_DelayListHead;                                /* The next TCB may expire at the same tick.                                         */
+        }
+
+        if(ptcb != OS_NULL(OS_TASK_TCB))
+        {
+            ptcb->TASK_Ticks -= ticks;                              /* Only the head is decremented, the rest are relative to it.                       */
         }
     }
-#else
 
-    if(OS_InactiveList.itemsCnt != 0U)							/* Any task in the inactive list ?																		*/
+#if(OS_CONFIG_EDF_EN == OS_CONFIG_ENABLE)
+
+    while(OS_InactiveList.itemsCnt != 0U)						/* Any task in the inactive list ?																		*/
     {
-        List_Item* pIterator = OS_InactiveList.head;			/* ... Yes, Start with first list item to the end of the list.											*/
-        while(pIterator != OS_NULL(List_Item))
+        List_Item* pIterator = OS_InactiveList.head;			/* ... Yes, The head has the earliest arrival time.														*/
+        OS_TASK_TCB* tsk = (OS_TASK_TCB*)pIterator->pOwner;		/* Extract the owner (TCB) from list item.	 															*/
+        if(tsk->EDF_params.tick_arrive > OS_TickTime)			/* Stop at the first task which has not arrived yet, The rest arrive later.								*/
+        {
+            break;
+        }
+        ListItemRemove(pIterator);								/* Remove the task from the inactive list.																*/
+#if (OS_CONFIG_TASK_BUDGET_EN == OS_CONFIG_ENABLE)
+        if(tsk->EDF_params.job_overrun == OS_TASK_OVERRUN_ABORT)	/* Its previous job was aborted, Restart the task from its entry point on a new stack frame.		*/
         {
-        	OS_TASK_TCB* tsk = (OS_TASK_TCB*)pIterator->pOwner;	/* Extract the owner (TCB) from list item.	 															*/
-				if(tsk->EDF_params.tick_arrive <= OS_TickTime)	/* Does the current system tick greater or equal the task's arrival time ?								*/
-				{
-					ListItemRemove(tsk->pListItemOwner);		/* Yes, Remove the task from the inactive list.															*/
-					pIterator->itemVal = tsk->EDF_params.tick_absolute_deadline; /* Update the list item value for the task's absolute deadline.						*/
-					tsk->EDF_params.task_yield = OS_FAlSE;		/* Make it ready for the possible next context switch.													*/
-					listItemInsert(&OS_ReadyList,pIterator);	/* Add to the ready list and it will placed in the right order according to its absolute deadline time.	*/
-				}
-        	pIterator = pIterator->next;						/* See the next inactive list item.																		*/
+            tsk->TASK_SP = OS_CPU_TaskStackInit(tsk->TASK_EntryAddr, tsk->TASK_EntryArg, tsk->TASK_StkBase, tsk->TASK_StkSize);
+            tsk->EDF_params.job_overrun = OS_TASK_OVERRUN_NONE;
         }
+#endif
+        pIterator->itemVal = tsk->EDF_params.tick_absolute_deadline; /* Update the list item value for the task's absolute deadline.									*/
+        tsk->EDF_params.task_yield = OS_FAlSE;					/* Make it ready for the possible next context switch.													*/
+        listItemInsert(&OS_ReadyList,pIterator);				/* Add to the ready list and it will placed in the right order according to its absolute deadline time.	*/
+#if (OS_CONFIG_TASK_LATENCY_EN == OS_CONFIG_ENABLE)
+        OS_TaskLatencyStamp(tsk);								/* The job is released, It waits the CPU from now on.													*/
+#endif
+        OS_TRACE(OS_TRACE_EV_TASK_READY, tsk, OS_NULL(void));
     }
 
 #endif
@@ -900,7 +1474,14 @@ OS_Is_CurrentTaskMissedDeadline (void)
 	OS_CRTICAL_BEGIN();
 
 	result = OS_FAlSE;
-	if(OS_TickTime > OS_currentTask->EDF_params.tick_absolute_deadline)
+	if(OS_currentTask->EDF_params.task_type == OS_TASK_PERIODIC)
+	{
+		if(OS_TickTime > OS_currentTask->EDF_params.tick_arrive + OS_currentTask->EDF_params.tick_relative_deadline)
+		{
+			result = OS_TRUE;			/* The job deadline, Even if the job is demoted after an overrun.	*/
+		}
+	}
+	else if(OS_TickTime > OS_currentTask->EDF_params.tick_absolute_deadline)
 	{
 		result = OS_TRUE;
 	}
@@ -909,6 +1490,311 @@ OS_Is_CurrentTaskMissedDeadline (void)
 
 	return result;
 }
+
+#if (OS_CONFIG_TASK_BUDGET_EN == OS_CONFIG_ENABLE)
+
+/*
+ * Function:  OS_TaskJobStatsGet
+ * -----------------------------
+ * Get the deadline misses and the budget overruns of the jobs of the current task.
+ *
+ * Arguments    : 	pmisses		is a pointer to the number of jobs which completed after their deadline.
+ * 					poverruns	is a pointer to the number of jobs which ran out of their execution budget.
+ *
+ * Returns      :	None.
+ */
+void
+OS_TaskJobStatsGet (CPU_t32U* pmisses, CPU_t32U* poverruns)
+{
+	CPU_SR_ALLOC();
+
+	OS_CRTICAL_BEGIN();
+
+	if(pmisses != OS_NULL(CPU_t32U))
+	{
+		*pmisses   = OS_currentTask->EDF_params.job_misses;
+	}
+	if(poverruns != OS_NULL(CPU_t32U))
+	{
+		*poverruns = OS_currentTask->EDF_params.job_overruns;
+	}
+
+	OS_CRTICAL_END();
+}
+
+#endif
+
+#endif
+
+#if (OS_CONFIG_TASK_RUNTIME_EN == OS_CONFIG_ENABLE) || (OS_CONFIG_TASK_LATENCY_EN == OS_CONFIG_ENABLE)
+
+/*
+ * Function:  OS_TaskTCBGet
+ * --------------------
+ * Get the TCB of a task to read its statistics.
+ *
+ * Arguments    :   prio    is the task priority, Or the task creation order with the EDF scheduler.
+ *
+ * Returns      :   A pointer to the TCB, OS_NULL(OS_TASK_TCB) if there is no task.
+ *
+ * Notes        :   1) With Round Robin, The calling task is returned if it runs at this priority,
+ *                     Otherwise the first created task of this priority.
+ *                  2) Interrupts are assumed to be disabled.
+ */
+static OS_TASK_TCB*
+OS_TaskTCBGet (OS_PRIO prio)
+{
+	OS_TASK_TCB* ptcb = OS_tblTCBPrio[prio];
+
+#if (OS_CONFIG_EDF_EN == OS_CONFIG_DISABLE) && (OS_CONFIG_ROUND_ROBIN_EN == OS_CONFIG_ENABLE)
+	if(OS_currentTask != OS_NULL(OS_TASK_TCB) && OS_currentTask->TASK_priority == prio)
+	{
+		ptcb = OS_currentTask;
+	}
+#endif
+
+	if(ptcb == OS_TCB_MUTEX_RESERVED)
+	{
+		ptcb = OS_NULL(OS_TASK_TCB);
+	}
+
+	return (ptcb);
+}
+
+#endif
+
+#if (OS_CONFIG_TASK_LATENCY_EN == OS_CONFIG_ENABLE)
+
+/*
+ * Function:  OS_TaskLatencyStamp
+ * --------------------
+ * Record the time a task is made ready, If it's not waiting the CPU already.
+ *
+ * Arguments    :   ptcb    is a pointer to the TCB of the task.
+ *
+ * Returns      :   None.
+ *
+ * Notes        :   1) Interrupts are assumed to be disabled.
+ *                  2) The tasks made ready before OS_Run() and the running task are not stamped.
+ */
+static void
+OS_TaskLatencyStamp (OS_TASK_TCB* ptcb)
+{
+	if(OS_TRUE == OS_Running && ptcb != OS_currentTask && ptcb->TASK_ReadyStamp == 0U)
+	{
+		ptcb->TASK_ReadyStamp = OS_CPU_TimestampGet();
+	}
+}
+
+/*
+ * Function:  OS_TaskLatencyRecord
+ * --------------------
+ * Count the time since a task was made ready in its latency histogram.
+ *
+ * Arguments    :   ptcb    is a pointer to the TCB of the task to be switched in.
+ *
+ * Returns      :   None.
+ *
+ * Notes        :   1) Called right before a context switch is requested, Interrupts are assumed to be disabled.
+ *                  2) A latency L is counted in the bucket floor(log2(L)), 0 and 1 in the first one. The last bucket
+ *                     counts all the longer latencies.
+ */
+static void
+OS_TaskLatencyRecord (OS_TASK_TCB* ptcb)
+{
+	CPU_t64U latency;
+	CPU_t32U bucket;
+
+	if(ptcb->TASK_ReadyStamp == 0U)							/* It didn't wait, i.e a preempted task which is resumed.	*/
+	{
+		return;
+	}
+
+	latency               = OS_CPU_TimestampGet() - ptcb->TASK_ReadyStamp;
+	ptcb->TASK_ReadyStamp = 0U;
+
+	for(bucket = 0U; latency > 1U && bucket < (OS_CONFIG_TASK_LATENCY_BUCKETS - 1U); ++bucket)
+	{
+		latency >>= 1U;
+	}
+
+	if(ptcb->TASK_LatencyHist[bucket] != 0xFFFFFFFFU)		/* Saturate instead of wrapping.							*/
+	{
+		++ptcb->TASK_LatencyHist[bucket];
+	}
+}
+
+/*
+ * Function:  OS_TaskLatencyHistGet
+ * -----------------------------
+ * Get the histogram of the dispatch latencies of a task.
+ *
+ * Arguments    :   prio    is the task priority.
+ *                          With the EDF scheduler, It's the task creation order (i.e 0 is the Idle task, Followed by
+ *                          the statistics task if enabled, Then the application tasks).
+ *                  phist   is a pointer to an array of OS_CONFIG_TASK_LATENCY_BUCKETS counts to be filled.
+ *
+ * Returns      :   OS_ERR_NONE, OS_ERR_PARAM, OS_ERR_PRIO_INVALID, OS_ERR_TASK_NOT_EXIST
+ */
+OS_tRet
+OS_TaskLatencyHistGet (OS_PRIO prio, CPU_t32U* phist)
+{
+	OS_TASK_TCB* ptcb;
+	CPU_t32U     idx;
+	CPU_SR_ALLOC();
+
+	if(phist == OS_NULL(CPU_t32U))
+	{
+		OS_ERR_SET(OS_ERR_PARAM);
+		return (OS_ERR_PARAM);
+	}
+
+	if(prio >= OS_CONFIG_TASK_COUNT)
+	{
+		OS_ERR_SET(OS_ERR_PRIO_INVALID);
+		return (OS_ERR_PRIO_INVALID);
+	}
+
+	OS_CRTICAL_BEGIN();
+
+	ptcb = OS_TaskTCBGet(prio);
+	if(ptcb == OS_NULL(OS_TASK_TCB))
+	{
+		OS_CRTICAL_END();
+		OS_ERR_SET(OS_ERR_TASK_NOT_EXIST);
+		return (OS_ERR_TASK_NOT_EXIST);
+	}
+
+	for(idx = 0U; idx < OS_CONFIG_TASK_LATENCY_BUCKETS; ++idx)
+	{
+		phist[idx] = ptcb->TASK_LatencyHist[idx];
+	}
+
+	OS_CRTICAL_END();
+
+	OS_ERR_SET(OS_ERR_NONE);
+	return (OS_ERR_NONE);
+}
+
+/*
+ * Function:  OS_TaskLatencyHistReset
+ * -----------------------------
+ * Clear the histogram of the dispatch latencies of a task.
+ *
+ * Arguments    :   prio    is the task priority (or the task creation order with the EDF scheduler).
+ *
+ * Returns      :   OS_ERR_NONE, OS_ERR_PRIO_INVALID, OS_ERR_TASK_NOT_EXIST
+ */
+OS_tRet
+OS_TaskLatencyHistReset (OS_PRIO prio)
+{
+	OS_TASK_TCB* ptcb;
+	CPU_SR_ALLOC();
+
+	if(prio >= OS_CONFIG_TASK_COUNT)
+	{
+		OS_ERR_SET(OS_ERR_PRIO_INVALID);
+		return (OS_ERR_PRIO_INVALID);
+	}
+
+	OS_CRTICAL_BEGIN();
+
+	ptcb = OS_TaskTCBGet(prio);
+	if(ptcb == OS_NULL(OS_TASK_TCB))
+	{
+		OS_CRTICAL_END();
+		OS_ERR_SET(OS_ERR_TASK_NOT_EXIST);
+		return (OS_ERR_TASK_NOT_EXIST);
+	}
+
+	OS_MemoryByteClear((CPU_t08U*)ptcb->TASK_LatencyHist, sizeof(ptcb->TASK_LatencyHist));
+
+	OS_CRTICAL_END();
+
+	OS_ERR_SET(OS_ERR_NONE);
+	return (OS_ERR_NONE);
+}
+
+#endif
+
+#if (OS_CONFIG_TASK_RUNTIME_EN == OS_CONFIG_ENABLE)
+
+/*
+ * Function:  OS_TaskRuntimeCharge
+ * --------------------
+ * Add the time since the last context switch to the runtime of the current task.
+ *
+ * Arguments    : None.
+ *
+ * Returns      : None.
+ *
+ * Notes        :   1) Called right before a context switch is requested, Interrupts are assumed to be disabled.
+ *                  2) The time spent in the ISRs is charged to the interrupted task.
+ */
+static void
+OS_TaskRuntimeCharge (void)
+{
+	CPU_t64U now = OS_CPU_TimestampGet();
+
+	if(OS_currentTask != OS_NULL(OS_TASK_TCB))
+	{
+		OS_currentTask->TASK_Runtime += (now - OS_TaskRuntimeStamp);
+	}
+	OS_TaskRuntimeStamp = now;
+}
+
+/*
+ * Function:  OS_TaskRuntimeGet
+ * -----------------------------
+ * Get the CPU time consumed by a task since its creation.
+ *
+ * Arguments    :   prio    is the task priority.
+ *                          With the EDF scheduler, It's the task creation order (i.e 0 is the Idle task, Followed by
+ *                          the statistics task if enabled, Then the application tasks).
+ *
+ * Returns      :   The consumed time in units of OS_CPU_TimestampGet() (i.e nanoseconds in the POSIX port,
+ *                  CPU cycles in the ARM Cortex-M4 port).
+ *                  0 and OS_ERRNO = OS_ERR_TASK_NOT_EXIST if there is no task at this priority.
+ *
+ * Notes        :   1) The time of the running task is counted up to the call.
+ *                  2) With Round Robin, The calling task is used if it runs at this priority,
+ *                     Otherwise the first created task of this priority.
+ */
+CPU_t64U
+OS_TaskRuntimeGet (OS_PRIO prio)
+{
+	OS_TASK_TCB* ptcb;
+	CPU_t64U     runtime;
+	CPU_SR_ALLOC();
+
+	if(prio >= OS_CONFIG_TASK_COUNT)
+	{
+		OS_ERR_SET(OS_ERR_PRIO_INVALID);
+		return (0U);
+	}
+
+	OS_CRTICAL_BEGIN();
+
+	ptcb = OS_TaskTCBGet(prio);
+	if(ptcb == OS_NULL(OS_TASK_TCB))
+	{
+		OS_CRTICAL_END();
+		OS_ERR_SET(OS_ERR_TASK_NOT_EXIST);
+		return (0U);
+	}
+
+	runtime = ptcb->TASK_Runtime;
+	if(OS_TRUE == OS_Running && ptcb == OS_currentTask)
+	{
+		runtime += (OS_CPU_TimestampGet() - OS_TaskRuntimeStamp);
+	}
+
+	OS_CRTICAL_END();
+
+	OS_ERR_SET(OS_ERR_NONE);
+	return (runtime);
+}
+
 #endif
 
 #if (OS_CONFIG_CPU_SOFT_STK_OVERFLOW_DETECTION == OS_CONFIG_ENABLE)
@@ -997,6 +1883,22 @@ OS_StackOverflow_Detected ( void* ptcb )
 	#error "Missing OS_CONFIG_SYSTEM_TIME_SET_GET_EN"
 #endif
 
+#ifndef OS_CONFIG_TICKLESS_EN
+	#error "Missing OS_CONFIG_TICKLESS_EN"
+#endif
+
+#ifndef OS_CONFIG_LIST_HEAP_EN
+    #error  "Missing OS_CONFIG_LIST_HEAP_EN"
+#endif
+
+#ifndef OS_CONFIG_ROUND_ROBIN_EN
+    #error  "Missing OS_CONFIG_ROUND_ROBIN_EN"
+#endif
+
+#ifndef OS_CONFIG_ROUND_ROBIN_QUANTA_DEFAULT
+    #error  "Missing OS_CONFIG_ROUND_ROBIN_QUANTA_DEFAULT"
+#endif
+
 #ifndef OS_CONFIG_TICKS_PER_SEC
     #error  "Missing OS_CONFIG_TICKS_PER_SEC"
 #endif
@@ -1045,6 +1947,10 @@ OS_StackOverflow_Detected ( void* ptcb )
     #error "Missing OS_CONFIG_APP_STACK_OVERFLOW"
 #endif
 
+#ifndef OS_CONFIG_APP_TASK_OVERRUN
+    #error "Missing OS_CONFIG_APP_TASK_OVERRUN"
+#endif
+
 #ifndef OS_CONFIG_CPU_INIT
     #error  "Missing OS_CONFIG_CPU_INIT"
 #endif
@@ -1076,3 +1982,79 @@ OS_StackOverflow_Detected ( void* ptcb )
 #ifndef OS_CONFIG_CPU_SOFT_STK_OVERFLOW_DETECTION
     #error "Missing OS_CONFIG_CPU_SOFT_STK_OVERFLOW_DETECTION"
 #endif
+
+#ifndef OS_CONFIG_TASK_ADMISSION_EN
+    #error "Missing OS_CONFIG_TASK_ADMISSION_EN"
+#endif
+
+#ifndef OS_CONFIG_TASK_BUDGET_EN
+    #error "Missing OS_CONFIG_TASK_BUDGET_EN"
+#endif
+
+#ifndef OS_CONFIG_TASK_RUNTIME_EN
+    #error "Missing OS_CONFIG_TASK_RUNTIME_EN"
+#endif
+
+#ifndef OS_CONFIG_TASK_STAT_EN
+    #error "Missing OS_CONFIG_TASK_STAT_EN"
+#endif
+
+#if (OS_CONFIG_TASK_STAT_EN == OS_CONFIG_ENABLE)
+
+#ifndef OS_CONFIG_TASK_STAT_PRIO
+    #error  "Missing OS_CONFIG_TASK_STAT_PRIO"
+#endif
+
+#ifndef OS_CONFIG_TASK_STAT_STACK_SIZE
+    #error  "Missing OS_CONFIG_TASK_STAT_STACK_SIZE"
+#endif
+
+#ifndef OS_CONFIG_TASK_STAT_RATE_MS
+    #error  "Missing OS_CONFIG_TASK_STAT_RATE_MS"
+#endif
+
+#if (OS_CONFIG_TASK_RUNTIME_EN == OS_CONFIG_DISABLE)
+    #error  "OS_CONFIG_TASK_STAT_EN requires OS_CONFIG_TASK_RUNTIME_EN, The idle time is the runtime of the idle task."
+#endif
+
+#endif
+
+#ifndef OS_CONFIG_TASK_LATENCY_EN
+    #error "Missing OS_CONFIG_TASK_LATENCY_EN"
+#endif
+
+#if (OS_CONFIG_TASK_LATENCY_EN == OS_CONFIG_ENABLE)
+
+#ifndef OS_CONFIG_TASK_LATENCY_BUCKETS
+    #error  "Missing OS_CONFIG_TASK_LATENCY_BUCKETS"
+#endif
+
+#endif
+
+#ifndef OS_CONFIG_TRACE_EN
+    #error "Missing OS_CONFIG_TRACE_EN"
+#endif
+
+#if (OS_CONFIG_TRACE_EN == OS_CONFIG_ENABLE)
+
+#ifndef OS_CONFIG_TRACE_RECORDS
+    #error  "Missing OS_CONFIG_TRACE_RECORDS"
+#endif
+
+#endif
+
+#ifndef OS_CONFIG_TASK_STACK_USAGE_EN
+    #error "Missing OS_CONFIG_TASK_STACK_USAGE_EN"
+#endif
+
+#if (OS_CONFIG_TASK_STACK_USAGE_EN == OS_CONFIG_ENABLE)
+
+#ifndef OS_CONFIG_TASK_STACK_SCAN_WORDS
+    #error  "Missing OS_CONFIG_TASK_STACK_SCAN_WORDS"
+#endif
+
+#if (CPU_CONFIG_STACK_GROWTH == CPU_STACK_GROWTH_NONE)
+    #error  "OS_CONFIG_TASK_STACK_USAGE_EN requires a port of a known stack growth direction"
+#endif
+
+#endif
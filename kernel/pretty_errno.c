@@ -101,6 +101,12 @@ OS_StrError(OS_ERR errno)
     case OS_ERR_TASK_DELETE_IDLE:
         return xstr(OS_ERR_TASK_DELETE_IDLE);
 
+    case OS_ERR_TASK_POOL_EMPTY:
+        return xstr(OS_ERR_TASK_POOL_EMPTY);
+
+    case OS_ERR_TASK_NOT_SCHEDULABLE:
+        return xstr(OS_ERR_TASK_NOT_SCHEDULABLE);
+
     case OS_ERR_EVENT_PEVENT_NULL:
         return xstr(OS_ERR_EVENT_PEVENT_NULL);
 
@@ -49,6 +49,8 @@ SOFTWARE.
  * 
  *              A wait list of tasks pending on an event is a simple sorted linked list based on task priority. i.e a higher priority task
  *              waiting for an event to occur is get placed in the head of the wait list.
+ *              With the EDF scheduler, The wait list is sorted by the tasks' absolute deadline instead. i.e the earliest deadline task is
+ *              placed in the head of the wait list.
  * 
  *              The search strategy for insertion or deletion is a linear search which takes up to O(n) in its worst case.
  * 
@@ -75,6 +77,19 @@ SOFTWARE.
 	#error  "OS_CONFIG_MAX_EVENTS must be >= 1"
 #endif
 
+/*
+*******************************************************************************
+*                                   Macros                                    *
+*******************************************************************************
+*/
+
+/* Is `ptcb1` served before `ptcb2` in an event's wait list ?                 */
+#if(OS_CONFIG_EDF_EN == OS_CONFIG_ENABLE)
+#define OS_EVENT_TCB_IS_BEFORE(ptcb1, ptcb2)   ((ptcb1)->EDF_params.tick_absolute_deadline < (ptcb2)->EDF_params.tick_absolute_deadline)
+#else
+#define OS_EVENT_TCB_IS_BEFORE(ptcb1, ptcb2)   ((ptcb1)->TASK_priority > (ptcb2)->TASK_priority)
+#endif
+
 /*
 *******************************************************************************
 *                               Global Variables                              *
@@ -166,7 +181,8 @@ OS_EVENT_free(OS_EVENT* pevent)
  * --------------------
  * Insert a task to an event's wait list according to its priority.
  * The function works by placing the TCBs that wait for a certain event (pointed by `pevent`)
- * in a sorted linked-list in descending order of TCBs' priority.
+ * in a sorted linked-list in descending order of TCBs' priority (ascending order of absolute deadline in EDF).
+ * TCBs of the same priority are kept in FIFO order.
  *
  * Arguments    : ptcb    is a pointer to TCB object where `pevent` will be stored into
  *                pevent  is a pointer to an allocated OS_EVENT object.
@@ -179,11 +195,9 @@ OS_EVENT_free(OS_EVENT* pevent)
 void
 OS_Event_TaskInsert(OS_TASK_TCB* ptcb, OS_EVENT *pevent)
 {
-    OS_PRIO prio;
     OS_TASK_TCB* currentTCBPtr;
 
     ptcb->TASK_Event = pevent;                                      	/* Store the event pointer inside the current TCB.              */
-    prio          	 = ptcb->TASK_priority;
 
     currentTCBPtr = pevent->OSEventsTCBHead;
 
@@ -192,7 +206,7 @@ OS_Event_TaskInsert(OS_TASK_TCB* ptcb, OS_EVENT *pevent)
         ptcb->OSTCB_NextPtr = ((OS_TASK_TCB*)0U);                        /* Place at the head.                                           */
         pevent->OSEventsTCBHead  = ptcb;
     }
-    else if(currentTCBPtr->TASK_priority <= prio)
+    else if(OS_EVENT_TCB_IS_BEFORE(ptcb, currentTCBPtr))
     {
         ptcb->OSTCB_NextPtr = currentTCBPtr;
         pevent->OSEventsTCBHead  = ptcb;
@@ -200,7 +214,7 @@ OS_Event_TaskInsert(OS_TASK_TCB* ptcb, OS_EVENT *pevent)
     else
     {
         while (currentTCBPtr->OSTCB_NextPtr != ((OS_TASK_TCB*)0U)        /* Walk-Through the list to place the TCB in the correct order. */
-                && currentTCBPtr->OSTCB_NextPtr->TASK_priority > prio)
+                && !OS_EVENT_TCB_IS_BEFORE(ptcb, currentTCBPtr->OSTCB_NextPtr))
         {
             currentTCBPtr = currentTCBPtr->OSTCB_NextPtr;
         }
@@ -226,7 +240,7 @@ void
 OS_Event_TaskPend (OS_EVENT *pevent)
 {
     OS_Event_TaskInsert(OS_currentTask, pevent);     /* Insert the current running test into the waiting list        */
-    OS_RemoveReady(OS_currentTask->TASK_priority);   /* Remove from the ready list.                                  */
+    OS_RemoveReady(OS_currentTask);                  /* Remove from the ready list.                                  */
 }
 
 /*
@@ -245,10 +259,8 @@ OS_Event_TaskPend (OS_EVENT *pevent)
 void
 OS_Event_TaskRemove (OS_TASK_TCB* ptcb, OS_EVENT *pevent)
 {
-    OS_PRIO  prio;
     OS_TASK_TCB* currentTCBPtr;
 
-    prio = ptcb->TASK_priority;
     currentTCBPtr = pevent->OSEventsTCBHead;
 
     if (currentTCBPtr == OS_NULL(OS_TASK_TCB))                						/* Is an empty pended TCB list                       							*/
@@ -257,7 +269,7 @@ OS_Event_TaskRemove (OS_TASK_TCB* ptcb, OS_EVENT *pevent)
     }
     else																			/* No ...																		*/
     {
-        if(prio == currentTCBPtr->TASK_priority)									/* Is the head TCB priority equals to the TCB priority we desire to remove ?	*/
+        if(ptcb == currentTCBPtr)													/* Is the head TCB the one we desire to remove ?								*/
         {
             pevent->OSEventsTCBHead = pevent->OSEventsTCBHead->OSTCB_NextPtr;		/* Yes ... Move the head to the next TCB.										*/
             currentTCBPtr->OSTCB_NextPtr = OS_NULL(OS_TASK_TCB);					/* Clear the next of the previous head.											*/
@@ -265,7 +277,7 @@ OS_Event_TaskRemove (OS_TASK_TCB* ptcb, OS_EVENT *pevent)
         else
         {
 			while (currentTCBPtr->OSTCB_NextPtr != OS_NULL(OS_TASK_TCB)
-					&& currentTCBPtr->OSTCB_NextPtr->TASK_priority != prio)			/* Loop to the end of the list or we find the desired priority to remove.		*/
+					&& currentTCBPtr->OSTCB_NextPtr != ptcb)						/* Loop to the end of the list or we find the desired TCB to remove.			*/
 			{
 				currentTCBPtr = currentTCBPtr->OSTCB_NextPtr;
 			}
@@ -290,14 +302,14 @@ OS_Event_TaskRemove (OS_TASK_TCB* ptcb, OS_EVENT *pevent)
  *                                      OS_STAT_PEND_OK     => Task ready due to a post (or delete event object).
  *                                      OS_STAT_PEND_ABORT  => Task ready due to an abort.
  *
- * Returns      : The highest priority of the ready task that was waiting for an event.
+ * Returns      : The TCB of the ready task that was waiting for an event (i.e the head of the wait list).
  *
  *
  * Notes        :   1) This function for internal use.
  *                  2) This function should be called by the post functions(e.g, semaphore,.. etc)
  *                  3) Interrupts must be disabled at this call.
  */
-OS_PRIO
+OS_TASK_TCB*
 OS_Event_TaskMakeReady(OS_EVENT* pevent,void* pmsg,
                        OS_STATUS TASK_StatEventMask,
                        OS_STATUS TASK_PendStat)
@@ -306,8 +318,7 @@ OS_Event_TaskMakeReady(OS_EVENT* pevent,void* pmsg,
 
     pHighTCB = pevent->OSEventsTCBHead;                     /* Highest Priority Task waiting for an event.                      */
 
-    pHighTCB->TASK_Ticks = 0U;                              /* The task is not waiting for event anymore So, let                */
-    OS_UnBlockTime(pHighTCB->TASK_priority);                /* make sure that OS_TimerTick will not try to make it ready.       */
+    OS_UnBlockTime(pHighTCB);                               /* The task is not waiting for event anymore, Unlink its timeout.   */
 
 #if (OS_CONFIG_MAILBOX_EN == OS_CONFIG_ENABLE)
 
@@ -324,12 +335,12 @@ OS_Event_TaskMakeReady(OS_EVENT* pevent,void* pmsg,
     if((pHighTCB->TASK_Stat & OS_TASK_STAT_SUSPENDED)       /* Make task ready if it's not suspended.                           */
             == OS_TASK_STAT_READY)
     {
-        OS_SetReady(pHighTCB->TASK_priority);
+        OS_SetReady(pHighTCB);
     }
 
     OS_Event_TaskRemove(pHighTCB,pevent);                   /* Remove TCB from the wait list.                                   */
 
-    return (pHighTCB->TASK_priority);                       /* Return ready task priority                                       */
+    return (pHighTCB);                                      /* Return ready task TCB.                                           */
 }
 
 
@@ -140,7 +140,7 @@ static inline void OS_EventFlag_PendCurrentTask(OS_EVENT_FLAG_GRP* pflagGrp, OS_
 
     if(timeout > 0U)
     {
-        OS_BlockTime(OS_currentTask->TASK_priority);		/* Add time delay block.								*/
+        OS_BlockTime(OS_currentTask);						/* Add time delay block.								*/
         OS_currentTask->TASK_Stat |= OS_TASK_STAT_DELAY;
     }
 
@@ -151,7 +151,7 @@ static inline void OS_EventFlag_PendCurrentTask(OS_EVENT_FLAG_GRP* pflagGrp, OS_
     pflagNode->pFlagNodeNext	= pflagGrp->pFlagNodeHead;	/* Always insert node at the beginning of the list.		*/
     pflagGrp->pFlagNodeHead		= pflagNode;				/* Reset the head to the new node.						*/
 
-    OS_RemoveReady(OS_currentTask->TASK_priority);			/* Finally, Remove task's TCB from the ready state.		*/
+    OS_RemoveReady(OS_currentTask);							/* Finally, Remove task's TCB from the ready state.		*/
 }
 
 /*
@@ -196,15 +196,14 @@ static OS_BOOLEAN OS_EventFlag_MakeTaskReady (OS_EVENT_FLAG_NODE *pnode,
     ptcb->TASK_Stat        &= ~(TASK_StatEventMask);        /* Clear the event type bit.                                        */
     ptcb->TASK_PendStat     = TASK_PendStat;                /* pend status due to a post or abort operation.                    */
 
-    ptcb->TASK_Ticks        = 0u;
-    OS_UnBlockTime(ptcb->TASK_priority);
+    OS_UnBlockTime(ptcb);                                   /* Unlink its timeout, The remaining ticks go to the next waiter.   */
 
     ptcb->OSFlagReady       = flags_ready;                  /* Store the flags which caused in a ready state.                   */
 
     if((ptcb->TASK_Stat & OS_TASK_STAT_SUSPENDED)           /* Make task ready if it's not suspended.                           */
             == OS_TASK_STAT_READY)
     {
-        OS_SetReady(ptcb->TASK_priority);
+        OS_SetReady(ptcb);
         sched = OS_TRUE;
     }
     else
@@ -353,6 +352,7 @@ OS_EVENT_FlagPend (OS_EVENT_FLAG_GRP* pflagGrp, OS_FLAG flags_pattern_wait, OS_F
     }
 
     OS_CRTICAL_BEGIN();
+    OS_TRACE(OS_TRACE_EV_FLAG_PEND, OS_currentTask, pflagGrp);
 
 
     														/* Check the wait type and pend ...							*/
@@ -496,8 +496,9 @@ OS_EVENT_FlagPost (OS_EVENT_FLAG_GRP* pflagGrp, OS_FLAG flags_pattern_wait, OS_O
 {
     OS_FLAG 	flags_ready;
     OS_FLAG		flags_current;
-    OS_BOOLEAN 	sched;
+    OS_BOOLEAN 	sched = OS_FAlSE;
     OS_EVENT_FLAG_NODE* pEventFlagNode;
+    OS_EVENT_FLAG_NODE* pEventFlagNodeNext;
 	CPU_SR_ALLOC();
 
 	if(pflagGrp == OS_NULL(OS_EVENT_FLAG_GRP))				/* Validate Event Group Type Pointer.						        */
@@ -512,6 +513,7 @@ OS_EVENT_FlagPost (OS_EVENT_FLAG_GRP* pflagGrp, OS_FLAG flags_pattern_wait, OS_O
     }
 
     OS_CRTICAL_BEGIN();
+    OS_TRACE(OS_TRACE_EV_FLAG_POST, OS_currentTask, pflagGrp);
 
     switch(flags_options)                                   /* Perform the desired operation on the event group flag.           */
     {
@@ -533,13 +535,15 @@ OS_EVENT_FlagPost (OS_EVENT_FLAG_GRP* pflagGrp, OS_FLAG flags_pattern_wait, OS_O
     pEventFlagNode  = pflagGrp->pFlagNodeHead;              /* Let's Check that for each event node, Has it met its event ?     */
     while(pEventFlagNode != OS_NULL(OS_EVENT_FLAG_NODE))
     {
+        pEventFlagNodeNext = pEventFlagNode->pFlagNodeNext; /* Save it, A node made ready is unlinked from the wait list.       */
+
         switch(pEventFlagNode->OSFlagWaitType)              /* Check event waiting type.                                        */
         {
             case OS_FLAG_WAIT_CLEAR_ALL:
             	 flags_ready = (pEventFlagNode->OSFlagWaited & ~(pflagGrp->OSFlagCurrent));
 				 if(flags_ready == pEventFlagNode->OSFlagWaited)
 				 {
-					 sched = OS_EventFlag_MakeTaskReady(pEventFlagNode,flags_ready,OS_TASK_STATE_PEND_FLAG,OS_STAT_PEND_OK);
+					 sched |= OS_EventFlag_MakeTaskReady(pEventFlagNode,flags_ready,OS_TASK_STATE_PEND_FLAG,OS_STAT_PEND_OK);
 				 }
 				 break;
 
@@ -547,7 +551,7 @@ OS_EVENT_FlagPost (OS_EVENT_FLAG_GRP* pflagGrp, OS_FLAG flags_pattern_wait, OS_O
             	 flags_ready = (pEventFlagNode->OSFlagWaited & ~(pflagGrp->OSFlagCurrent));
 				 if(flags_ready != (OS_FLAG)0U)
 				 {
-					 sched = OS_EventFlag_MakeTaskReady(pEventFlagNode,flags_ready,OS_TASK_STATE_PEND_FLAG,OS_STAT_PEND_OK);
+					 sched |= OS_EventFlag_MakeTaskReady(pEventFlagNode,flags_ready,OS_TASK_STATE_PEND_FLAG,OS_STAT_PEND_OK);
 				 }
 				 break;
 
@@ -555,7 +559,7 @@ OS_EVENT_FlagPost (OS_EVENT_FLAG_GRP* pflagGrp, OS_FLAG flags_pattern_wait, OS_O
                 flags_ready = (pEventFlagNode->OSFlagWaited  & (pflagGrp->OSFlagCurrent));
                 if(flags_ready == pEventFlagNode->OSFlagWaited)
                 {
-                	sched = OS_EventFlag_MakeTaskReady(pEventFlagNode,flags_ready,OS_TASK_STATE_PEND_FLAG,OS_STAT_PEND_OK);
+                	sched |= OS_EventFlag_MakeTaskReady(pEventFlagNode,flags_ready,OS_TASK_STATE_PEND_FLAG,OS_STAT_PEND_OK);
                 }
                 break;
             case OS_FLAG_WAIT_SET_ANY:
@@ -563,7 +567,7 @@ OS_EVENT_FlagPost (OS_EVENT_FLAG_GRP* pflagGrp, OS_FLAG flags_pattern_wait, OS_O
 				flags_ready = (pEventFlagNode->OSFlagWaited  & (pflagGrp->OSFlagCurrent));
 				if(flags_ready != (OS_FLAG)0U)
 				{
-					sched = OS_EventFlag_MakeTaskReady(pEventFlagNode,flags_ready,OS_TASK_STATE_PEND_FLAG,OS_STAT_PEND_OK);
+					sched |= OS_EventFlag_MakeTaskReady(pEventFlagNode,flags_ready,OS_TASK_STATE_PEND_FLAG,OS_STAT_PEND_OK);
 				}
 				break;
 
@@ -573,7 +577,7 @@ OS_EVENT_FlagPost (OS_EVENT_FLAG_GRP* pflagGrp, OS_FLAG flags_pattern_wait, OS_O
                 return ((OS_FLAG)0U);
         }
 
-        pEventFlagNode = pEventFlagNode->pFlagNodeNext;
+        pEventFlagNode = pEventFlagNodeNext;
     }
 
     OS_CRTICAL_END();
@@ -87,6 +87,10 @@ extern "C" {
 	void App_Hook_StackOverflow_Detected (OS_TASK_TCB* ptcb);       /* Calls Application specific code for a possible event of a task's stack overflow is detected. */
 #endif
 
+#if (OS_CONFIG_APP_TASK_OVERRUN == OS_CONFIG_ENABLE)
+	void App_Hook_TaskOverrun	(OS_TASK_TCB* ptcb);				/* Calls Application specific code when an EDF job runs out of its execution budget. (ISR)		*/
+#endif
+
 
 /*
 *******************************************************************************
@@ -34,6 +34,10 @@ SOFTWARE.
  * 				This picture shows the xList structure top overview
  * 				https://www.aosabook.org/images/freertos/freertos-figures-full-ready-list.png
  *
+ * 				With OS_CONFIG_LIST_HEAP_EN, The list is a binary min-heap of its items
+ * 				instead. Insertion and removal are O(log n) and only the head (the smallest
+ * 				item) is meaningful, The next/prev links of the items are not used.
+ *
  * Language:  C
  *
  * Set 1 tab = 4 spaces for better comments readability.
@@ -55,6 +59,106 @@ list_Init(List * const list)
 	list->itemsCnt = 0U;
 }
 
+#if (OS_CONFIG_LIST_HEAP_EN == OS_CONFIG_ENABLE)
+
+/*
+ * Function:  listHeapPlace
+ * --------------------
+ * Place a list item at a heap position and move it up or down till the heap order is restored.
+ *
+ * Arguments    : list     is the list which holds the heap.
+ * 				  listItem is the list item to place.
+ * 				  idx	   is the free heap position to start from.
+ *
+ * Returns      : None.
+ */
+static void
+listHeapPlace (List * const list, List_Item * const listItem, CPU_tWORD idx)
+{
+	CPU_tWORD child;
+
+	while(idx > 0U && list->heap[(idx - 1U) >> 1U]->itemVal > listItem->itemVal)
+	{
+		/*	Move the bigger parent down.											*/
+		list->heap[idx] = list->heap[(idx - 1U) >> 1U];
+		list->heap[idx]->heapIdx = idx;
+		idx = (idx - 1U) >> 1U;
+	}
+
+	for(;;)
+	{
+		child = (idx << 1U) + 1U;
+		if(child >= list->itemsCnt)
+		{
+			break;
+		}
+		if((child + 1U) < list->itemsCnt && list->heap[child + 1U]->itemVal < list->heap[child]->itemVal)
+		{
+			++child;
+		}
+		if(list->heap[child]->itemVal >= listItem->itemVal)
+		{
+			break;
+		}
+		/*	Move the smaller child up.												*/
+		list->heap[idx] = list->heap[child];
+		list->heap[idx]->heapIdx = idx;
+		idx = child;
+	}
+
+	list->heap[idx]   = listItem;
+	listItem->heapIdx = idx;
+}
+
+void
+listItem_Init(List_Item * const listItem)
+{
+	listItem->prev = listItem->next = ((List_Item*)0U);
+	listItem->pList = listItem->pOwner = ((void*)0U);
+	listItem->itemVal = 0U;
+	listItem->heapIdx = 0U;
+}
+
+void
+listItemInsert (List * const list, List_Item * const listItem)
+{
+	(list->itemsCnt)++;
+	listHeapPlace(list, listItem, list->itemsCnt - 1U);
+
+	listItem->pList = list;
+	list->head 		= list->heap[0];
+}
+
+CPU_tWORD ListItemRemove( List_Item * const pItemToRemove )
+{
+	List * const pList = pItemToRemove->pList;
+	List_Item*   pLast;
+
+	(pList->itemsCnt)--;
+	pLast = pList->heap[pList->itemsCnt];
+
+	if(pLast != pItemToRemove)
+	{
+		/*	Fill the hole with the last item of the heap.							*/
+		listHeapPlace(pList, pLast, pItemToRemove->heapIdx);
+	}
+
+	pItemToRemove->pList = ((List*)0U);
+
+	if(pList->itemsCnt == 0)
+	{
+		list_Init(pList);
+	}
+	else
+	{
+		pList->head = pList->heap[0];
+	}
+
+	return pList->itemsCnt;
+}
+
+#else
+
 void
 listItem_Init(List_Item * const listItem)
 {
@@ -154,4 +258,6 @@ CPU_tWORD ListItemRemove( List_Item * const pItemToRemove )
     return pList->itemsCnt;
 }
 
+#endif		/* OS_CONFIG_LIST_HEAP_EN		*/
+
 #endif		/* OS_AUTO_CONFIG_INCLUDE_LIST	*/
@@ -166,6 +166,7 @@ OS_MailBoxPend (OS_MAILBOX* pevent, OS_TICK timeout)
     }
 
     OS_CRTICAL_BEGIN();
+    OS_TRACE(OS_TRACE_EV_MAILBOX_PEND, OS_currentTask, pevent);
 
     p_message = (void*)pevent->OSEventPtr;					/* Read mailbox ...											*/
 
@@ -183,7 +184,7 @@ OS_MailBoxPend (OS_MAILBOX* pevent, OS_TICK timeout)
 
     if(timeout > 0U)
     {
-        OS_BlockTime(OS_currentTask->TASK_priority);
+        OS_BlockTime(OS_currentTask);
         OS_currentTask->TASK_Stat |= OS_TASK_STAT_DELAY;
     }
 
@@ -261,6 +262,7 @@ OS_MailBoxPost (OS_MAILBOX* pevent, void* p_message)
     }
 
     OS_CRTICAL_BEGIN();
+    OS_TRACE(OS_TRACE_EV_MAILBOX_POST, OS_currentTask, pevent);
 
     if (pevent->OSEventsTCBHead != OS_NULL(OS_TASK_TCB)) {   /* See if any task waiting for a message.                    */
          OS_Event_TaskMakeReady(pevent, p_message,           /* Make Highest priority task waiting on event be ready.     */
@@ -281,8 +283,6 @@ OS_MailBoxPost (OS_MAILBOX* pevent, void* p_message)
     	return;
     }
 
-     OS_CRTICAL_END();
-
      pevent->OSEventPtr	= (OS_EVENT*) p_message;			 /* No, .. Put the message in the mailbox.					  */
      OS_CRTICAL_END();
      OS_ERR_SET(OS_ERR_NONE);
@@ -201,6 +201,7 @@ OS_MemoryAllocateBlock (OS_MEMORY* pMemoryPart)
 	}
 
 	OS_CRTICAL_BEGIN();
+	OS_TRACE(OS_TRACE_EV_MEMORY_GET, OS_currentTask, pMemoryPart);
 
 	if(pMemoryPart->blockFreeCount > 0U)							/* See if there are any available blocks.									*/
 	{
@@ -252,6 +253,7 @@ OS_MemoryRestoreBlock (OS_MEMORY* pMemoryPart, void* pBlock)
 	}
 
 	OS_CRTICAL_BEGIN();
+	OS_TRACE(OS_TRACE_EV_MEMORY_PUT, OS_currentTask, pMemoryPart);
 
 	if(pMemoryPart->blockFreeCount < pMemoryPart->blockCount)		/* Assert that not all blocks are returned.									*/
 	{
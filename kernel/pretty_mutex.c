@@ -38,6 +38,295 @@ SOFTWARE.
 *******************************************************************************
 */
 
+#if(OS_CONFIG_EDF_EN == OS_CONFIG_ENABLE)
+
+/* ****************************************************************************
+ *																			  *
+ * 	  Mutex APIs For Earliest Deadline First Scheduling based (SRP).		  *
+ *																			  *
+ * ****************************************************************************
+ * */
+
+/*
+ * Function:  OS_MutexCreate
+ * --------------------
+ * Creates a mutual exclusion semaphore which is managed by the Stack Resource Policy (SRP).
+ *
+ * Arguments    :   ceiling is the preemption ceiling of the mutex, It's the shortest relative deadline (in ticks)
+ *                          among ALL of the tasks competing for the mutex.
+ *                          While the mutex is locked, a new job can start only if its relative deadline is shorter than the
+ *                          ceiling (i.e its preemption level is higher). So a job never blocks on the mutex once it starts and
+ *                          the blocking is bounded by one critical section of a job with a longer relative deadline.
+ *
+ *                  opt     Enable/Disable the SRP ceiling.
+ *                          = OS_MUTEX_PRIO_CEIL_DISABLE    (Default) The waiting tasks are served by their absolute deadlines.
+ *                          = OS_MUTEX_PRIO_CEIL_ENABLE
+ *
+ * Returns      :  != (OS_EVENT*)0U  is a pointer to OS_EVENT object of type OS_EVENT_TYPE_MUTEX for the created mutex.
+ *                 == (OS_EVENT*)0U  if error is found.
+ *                 OS_ERRNO = { OS_ERR_NONE, OS_ERR_PARAM, OS_ERR_EVENT_CREATE_ISR, OS_ERR_EVENT_POOL_EMPTY}
+ *
+ * Note(s)      :   1) This function is used only from Task code level.
+ *                  2) 'OSMutexCeil' of returned (OS_EVENT*) is the ceiling or 'OS_TICK_INFINITE' if the SRP ceiling is disabled.
+ */
+OS_MUTEX*
+OS_MutexCreate (OS_TICK ceiling, OS_OPT opt)
+{
+    OS_EVENT*    pevent;
+    CPU_SR_ALLOC();
+
+    if(opt == OS_MUTEX_PRIO_CEIL_ENABLE && (ceiling == 0U || ceiling == OS_TICK_INFINITE))
+    {
+        OS_ERR_SET(OS_ERR_PARAM);
+        return ((OS_EVENT*)0U);
+    }
+
+    if (OS_IntNestingLvl > 0U) {                                   /* Don't Create from an ISR.                                */
+        OS_ERR_SET(OS_ERR_EVENT_CREATE_ISR);
+        return ((OS_EVENT*)0U);
+    }
+
+    OS_CRTICAL_BEGIN();
+
+    OS_EVENT_allocate(&pevent);                                    /* Allocate a free event object.                             */
+    if(pevent == ((OS_EVENT*)0U))
+    {
+        OS_ERR_SET(OS_ERR_EVENT_POOL_EMPTY);
+        OS_CRTICAL_END();
+        return (pevent);
+    }
+
+    OS_CRTICAL_END();
+
+    pevent->OSEventType      = OS_EVENT_TYPE_MUTEX;                /* Store the Event type.                                     */
+    pevent->OSEventPtr       = ((OS_EVENT*)0U);                    /* Initial, No task is owning the Mutex.                     */
+    pevent->OSEventsTCBHead  = ((OS_TASK_TCB*)0U);                 /* Initial, No tasks are pended on this event.               */
+    pevent->OSMutexCeilPrev  = OS_TICK_INFINITE;
+
+    if(OS_MUTEX_PRIO_CEIL_DISABLE == opt)
+    {
+        pevent->OSMutexCeil  = OS_TICK_INFINITE;                   /* OS_TICK_INFINITE to indicate the SRP ceiling is disabled. */
+    }
+    else
+    {
+        pevent->OSMutexCeil  = ceiling;                            /* Store the preemption ceiling.                             */
+    }
+
+    OS_ERR_SET(OS_ERR_NONE);
+    return (pevent);
+}
+
+/*
+ * Function:  OS_MutexLock
+ * --------------------
+ * Give the Mutex to a task and raise the system ceiling by the Mutex ceiling.
+ *
+ * Arguments    :   pevent      is a pointer to the OS_EVENT object associated with the Mutex.
+ *                  ptcb        is a pointer to the TCB of the new owner.
+ *
+ * Returns      :   OS_ERR_NONE or OS_ERR_MUTEX_LOWER_PCP if the owner has a shorter relative deadline than the ceiling.
+ *
+ * Notes        :   1) Interrupts are assumed to be disabled.
+ */
+static OS_ERR
+OS_MutexLock (OS_MUTEX* pevent, OS_TASK_TCB* ptcb)
+{
+    pevent->OSEventPtr      = (OS_EVENT*)ptcb;                      /* Point to the owning task TCB.                             */
+    pevent->OSMutexCeilPrev = OS_SRP_SystemCeiling;                 /* Push the current system ceiling.                          */
+#if (OS_CONFIG_TASK_BUDGET_EN == OS_CONFIG_ENABLE)
+    ++ptcb->EDF_params.job_mutexes;                                 /* An overrun job can't be aborted while owning the Mutex.   */
+#endif
+
+    if(pevent->OSMutexCeil < OS_SRP_SystemCeiling)
+    {
+        OS_SRP_SystemCeiling = pevent->OSMutexCeil;
+    }
+
+    if(ptcb->EDF_params.tick_relative_deadline < pevent->OSMutexCeil &&
+       pevent->OSMutexCeil != OS_TICK_INFINITE)
+    {
+        return (OS_ERR_MUTEX_LOWER_PCP);                            /* The ceiling should not be lower than the owner level.     */
+    }
+
+    return (OS_ERR_NONE);
+}
+
+/*
+ * Function:  OS_MutexPend
+ * --------------------
+ * Waits for a mutual exclusion semaphore.
+ *
+ * Arguments    :   pevent      is a pointer to the OS_EVENT object associated with the Mutex.
+ *
+ *                  timeout     is an optional timeout period (in clock ticks).  If non-zero, your task will
+ *                              wait for the resource up to the amount of time specified by this argument.
+ *                              If you specify 0, however, your task will wait forever at the specified
+ *                              mutex or, until the resource becomes available (or the event occurs).
+ *
+ * Returns      :   OS_ERRNO = { OS_ERR_NONE, OS_ERR_EVENT_PEVENT_NULL, OS_ERR_EVENT_TYPE, OS_ERR_EVENT_PEND_ISR,
+ *                               OS_ERR_MUTEX_PCP_LOWER, OS_ERR_EVENT_PEND_ABORT, OS_ERR_EVENT_TIMEOUT, OS_ERR_EVENT_PEND_LOCKED }
+ *
+ * Note(s)      :   1) This function must used only from Task code level and not an ISR.
+ *                  2) With a correct ceiling, the Mutex is always free when a task asks for it. The task waits
+ *                     (in the order of absolute deadlines) only if the ceiling is disabled or too long.
+ *                  3) The Mutexes must be released in the reverse order of locking them.
+ */
+void
+OS_MutexPend (OS_MUTEX* pevent, OS_TICK timeout)
+{
+    OS_ERR err;
+    CPU_SR_ALLOC();
+
+    if (pevent == (OS_EVENT*)0U) {                          /* Validate 'pevent'                                         */
+        OS_ERR_SET(OS_ERR_EVENT_PEVENT_NULL);
+        return;
+    }
+
+    if (pevent->OSEventType != OS_EVENT_TYPE_MUTEX) {       /* Validate event type                                       */
+        OS_ERR_SET(OS_ERR_EVENT_TYPE);
+        return;
+    }
+
+    if (OS_IntNestingLvl > 0U) {
+        OS_ERR_SET(OS_ERR_EVENT_PEND_ISR);                  /* Doesn't make sense to wait inside an ISR.                 */
+        return;
+    }
+
+    if (OS_LockSchedNesting > 0U) {
+        OS_ERR_SET(OS_ERR_EVENT_PEND_LOCKED);               /* Should not wait when scheduler is locked.                 */
+        return;
+    }
+
+    OS_CRTICAL_BEGIN();
+    OS_TRACE(OS_TRACE_EV_MUTEX_PEND, OS_currentTask, pevent);
+
+    if(pevent->OSEventPtr == ((OS_EVENT*)0U))               /* Is Mutex available for the calling task ?                 */
+    {
+        err = OS_MutexLock(pevent, OS_currentTask);
+        OS_CRTICAL_END();
+        OS_ERR_SET(err);
+        (void)err;
+        return;                                             /* We are done here, the current task is owning the Mutex.  */
+    }
+                                                            /* The Mutex is owned by another task.                      */
+    OS_currentTask->TASK_Stat      |= OS_TASK_STATE_PEND_MUTEX;
+    OS_currentTask->TASK_PendStat   = OS_STAT_PEND_OK;
+    OS_currentTask->TASK_Ticks      = timeout;
+    if(timeout > 0U)
+    {
+        OS_BlockTime(OS_currentTask);                        /* Put in a time block state until mutex may be released.   */
+        OS_currentTask->TASK_Stat |= OS_TASK_STAT_DELAY;
+    }
+
+    OS_Event_TaskPend(pevent);                              /* Place the current TCB in the pending list.                */
+
+    OS_CRTICAL_END();
+
+    OS_Sched();                                             /* Run the next earliest deadline task.                      */
+
+    OS_CRTICAL_BEGIN();                                     /* We're back again ...                                      */
+
+    switch (OS_currentTask->TASK_PendStat) {                /* ... See if it was timed-out or aborted.                   */
+        case OS_STAT_PEND_OK:
+            OS_ERR_SET(OS_ERR_NONE);                        /* Indicate that the current task owns the Mutex.            */
+             break;
+
+        case OS_STAT_PEND_ABORT:
+            OS_ERR_SET(OS_ERR_EVENT_PEND_ABORT);            /* Indicate that we aborted before getting the mutex.        */
+             break;
+
+        case OS_STAT_PEND_TIMEOUT:
+        default:
+            OS_Event_TaskRemove(OS_currentTask, pevent);    /* Release the current task from pending on mutex.           */
+            OS_ERR_SET(OS_ERR_EVENT_TIMEOUT);               /* Indicate that we didn't get the mutex within Time out.    */
+             break;
+    }
+
+    OS_currentTask->TASK_Stat     &= ~(OS_TASK_STATE_PEND_MUTEX);
+    OS_currentTask->TASK_PendStat  =  OS_STAT_PEND_OK;
+    OS_currentTask->TASK_Event     = OS_NULL(OS_EVENT);     /* Unlink the event from the current TCB.                    */
+
+    OS_CRTICAL_END();
+}
+
+/*
+ * Function:  OS_MutexPost
+ * --------------------
+ * Signal a mutual exclusion semaphore.
+ *
+ * Arguments    :   pevent      is a pointer to the OS_EVENT object associated with the Mutex.
+ *
+ * Returns      :   OS_ERRNO = { OS_ERR_NONE, OS_ERR_EVENT_PEVENT_NULL, OS_ERR_EVENT_TYPE, OS_ERR_EVENT_POST_ISR,
+ *                               OS_ERR_MUTEX_NO_OWNER, OS_ERR_MUTEX_PCP_LOWER }
+ *
+ * Notes        :   1) This function must used only from Task code level.
+ *                  2) The system ceiling is restored to its value before the Mutex was locked, So the jobs which were
+ *                     not allowed to start can preempt the current task now.
+ */
+void
+OS_MutexPost (OS_MUTEX* pevent)
+{
+    OS_TASK_TCB* ptcb_new_owner;
+    OS_ERR       err;
+    CPU_SR_ALLOC();
+
+    if (OS_IntNestingLvl > 0U) {
+        OS_ERR_SET(OS_ERR_EVENT_POST_ISR);                                  /* Doesn't make sense to post inside an ISR.                */
+        return;
+    }
+
+    if (pevent == (OS_EVENT*)0U) {                                          /* Validate 'pevent'                                         */
+        OS_ERR_SET(OS_ERR_EVENT_PEVENT_NULL);
+        return;
+    }
+
+    if (pevent->OSEventType != OS_EVENT_TYPE_MUTEX) {                       /* Validate event type                                       */
+        OS_ERR_SET(OS_ERR_EVENT_TYPE);
+        return;
+    }
+
+    OS_CRTICAL_BEGIN();
+    OS_TRACE(OS_TRACE_EV_MUTEX_POST, OS_currentTask, pevent);
+
+    if(OS_currentTask != (OS_TASK_TCB*)pevent->OSEventPtr)                  /* Check that the poster is the owner of the Mutex.          */
+    {
+        OS_CRTICAL_END();
+        OS_ERR_SET(OS_ERR_MUTEX_NO_OWNER);
+        return;
+    }
+
+    OS_SRP_SystemCeiling = pevent->OSMutexCeilPrev;                         /* Pop the system ceiling.                                   */
+    pevent->OSMutexCeilPrev = OS_TICK_INFINITE;
+    pevent->OSEventPtr  = ((OS_EVENT*)0U);                                  /* No task is owning the Mutex after post.                   */
+#if (OS_CONFIG_TASK_BUDGET_EN == OS_CONFIG_ENABLE)
+    --OS_currentTask->EDF_params.job_mutexes;
+#endif
+    err = OS_ERR_NONE;
+
+    if (pevent->OSEventsTCBHead != ((OS_TASK_TCB*)0U))                      /* See if any task waiting for Mutex.                        */
+    {
+        ptcb_new_owner = OS_Event_TaskMakeReady(pevent, (void *)0,          /* Make the earliest deadline task waiting on event be ready.*/
+                            OS_TASK_STATE_PEND_MUTEX,
+                            OS_STAT_PEND_OK);                               /* OS_STAT_PEND_OK indicates a post operation.               */
+
+        err = OS_MutexLock(pevent, ptcb_new_owner);                         /* The waited task is owning the Mutex.                      */
+    }
+
+    OS_CRTICAL_END();
+    OS_Sched();
+    OS_ERR_SET(err);
+    (void)err;
+}
+
+#else	/* OS_CONFIG_EDF_EN == OS_CONFIG_DISABLE 							  */
+
+/* ****************************************************************************
+ *																			  *
+ * 			Mutex APIs For Priority Assignment Scheduling based.		  	  *
+ *																			  *
+ * ****************************************************************************
+ * */
+
 /*
  * Function:  OS_MutexCreate
  * --------------------
@@ -180,6 +469,7 @@ OS_MutexPend (OS_MUTEX* pevent, OS_TICK timeout)
     }
 
     OS_CRTICAL_BEGIN();
+    OS_TRACE(OS_TRACE_EV_MUTEX_PEND, OS_currentTask, pevent);
 
     pcp = pevent->OSMutexPrioCeilP;                         /* Get PCP value.                                            */
 
@@ -215,16 +505,11 @@ OS_MutexPend (OS_MUTEX* pevent, OS_TICK timeout)
             {
                 if(ptcb_owner->TASK_Stat == OS_TASK_STAT_READY)
                 {
-                    OS_RemoveReady(ptcb_owner->TASK_priority);
+                    OS_RemoveReady(ptcb_owner);
                     ready = OS_TRUE;
                 }
                 else
-                {
-                    if(ptcb_owner->TASK_Stat & OS_TASK_STAT_DELAY)/* If it waits any delay..                            */
-                    {
-                        OS_UnBlockTime(ptcb_owner->TASK_priority);/* ... Unblock it from delay table.                   */
-                    }
-
+                {                                           /* A pending delay is kept, The delay list is not ordered by priority.  */
                     pevent_owner = ptcb_owner->TASK_Event;
                     if(pevent_owner != ((OS_EVENT*)0U))           /* If it waits any events..                           */
                     {
@@ -240,22 +525,20 @@ OS_MutexPend (OS_MUTEX* pevent, OS_TICK timeout)
 
                 if(ready == OS_TRUE)
                 {
-                    OS_SetReady(pcp);
+                    OS_SetReady(ptcb_owner);
                 }
                 else
                 {
-                    if(ptcb_owner->TASK_Stat & OS_TASK_STAT_DELAY)/* If it was waiting any delay..                      */
-                    {
-                        OS_BlockTime(pcp);                        /* ... block it at PCP priority.                      */
-                    }
-
                     if(pevent_owner != ((OS_EVENT*)0U))
                     {
                         OS_Event_TaskInsert(ptcb_owner, pevent_owner);/* ... Add to event list.                         */
                     }
                 }
 
+                /* With Round Robin, The PCP entry stays reserved and the owner is scheduled from the PCP ready queue.  */
+#if (OS_CONFIG_ROUND_ROBIN_EN == OS_CONFIG_DISABLE)
                 OS_tblTCBPrio[pcp]  = ptcb_owner;               /* Point to the TCB entry of PCP priority.              */
+#endif
 
                 /* Continue to pend the current task and hopefully, the PCP's Task will be scheduled first.             */
             }
@@ -267,7 +550,7 @@ OS_MutexPend (OS_MUTEX* pevent, OS_TICK timeout)
     OS_currentTask->TASK_Ticks      = timeout;
     if(timeout > 0U)
     {
-        OS_BlockTime(OS_currentTask->TASK_priority);        /* Put in a time block state until mutex may be released.   */
+        OS_BlockTime(OS_currentTask);                        /* Put in a time block state until mutex may be released.   */
         OS_currentTask->TASK_Stat |= OS_TASK_STAT_DELAY;
     }
 
@@ -321,6 +604,7 @@ OS_MutexPost (OS_MUTEX* pevent)
     OS_PRIO owner_prio;
     OS_PRIO new_owner_prio;
     OS_TASK_TCB* ptcb_owner;
+    OS_TASK_TCB* ptcb_new_owner;
     CPU_SR_ALLOC();
 
     if (OS_IntNestingLvl > 0U) {
@@ -339,6 +623,7 @@ OS_MutexPost (OS_MUTEX* pevent)
     }
 
     OS_CRTICAL_BEGIN();
+    OS_TRACE(OS_TRACE_EV_MUTEX_POST, OS_currentTask, pevent);
 
     pcp        = pevent->OSMutexPrioCeilP;
     owner_prio = pevent->OSMutexPrio;
@@ -357,13 +642,15 @@ OS_MutexPost (OS_MUTEX* pevent)
         {                                                                   /* Restore the task's original priority.                     */
             /* At this point,
              * We're in a task, raised to PCP, So it's in a ready/runnable state and not pending on any other events or time delay.      */
-            OS_RemoveReady(pcp);                                            /* Remove owner from ready state at PCP priority.            */
+            OS_RemoveReady(OS_currentTask);                                 /* Remove owner from ready state at PCP priority.            */
 
             OS_currentTask->TASK_priority   = owner_prio;                   /* Revert to the original priority.                          */
 
-            OS_SetReady(owner_prio);                                        /* Set the owner to a ready state at the original priority.  */
+            OS_SetReady(OS_currentTask);                                    /* Set the owner to a ready state at the original priority.  */
 
+#if (OS_CONFIG_ROUND_ROBIN_EN == OS_CONFIG_DISABLE)
             OS_tblTCBPrio[owner_prio]       = ptcb_owner;                   /* Reset the original priority to refers to original TCB.    */
+#endif
             OS_tblTCBPrio[pcp]              = OS_TCB_MUTEX_RESERVED;        /* Reserve TCB entry again for a future Mutex use.           */
 
             /* After that: the HPT task, pending on this Mutex will be scheduled.                                                        */
@@ -372,12 +659,13 @@ OS_MutexPost (OS_MUTEX* pevent)
 
     if (pevent->OSEventsTCBHead != ((OS_TASK_TCB*)0U))                      /* See if any task waiting for Mutex.                        */
     {
-        new_owner_prio = OS_Event_TaskMakeReady(pevent, (void *)0,          /* Make Highest priority task waiting on event be ready.     */
+        ptcb_new_owner = OS_Event_TaskMakeReady(pevent, (void *)0,          /* Make Highest priority task waiting on event be ready.     */
                             OS_TASK_STATE_PEND_MUTEX,
                             OS_STAT_PEND_OK);                               /* OS_STAT_PEND_OK indicates a post operation.               */
+        new_owner_prio = ptcb_new_owner->TASK_priority;                     /* The highest priority task waiting is the new owner.       */
 
         pevent->OSMutexPrio = new_owner_prio;                               /* Save task priority which owning the mutex.                */
-        pevent->OSEventPtr  = (OS_EVENT*)OS_tblTCBPrio[new_owner_prio];     /* Point to the new owning task TCB.                         */
+        pevent->OSEventPtr  = (OS_EVENT*)ptcb_new_owner;                    /* Point to the new owning task TCB.                         */
 
         if((pcp != OS_PRIO_RESERVED_MUTEX) && (pcp < new_owner_prio))       /* Is priority ceiling is enabled                            */
         {
@@ -402,7 +690,7 @@ OS_MutexPost (OS_MUTEX* pevent)
     OS_ERR_SET(OS_ERR_NONE);
 }
 
-
+#endif /* OS_CONFIG_EDF_EN */
 
 #endif /* OS_CONFIG_MUTEX_EN */
 
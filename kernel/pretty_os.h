@@ -70,6 +70,7 @@ typedef enum {
     OS_ERR_TASK_DELETE_ISR			=(0x11U),     /* Cannot delete a task from an ISR.               */
     OS_ERR_TASK_DELETE_IDLE		    =(0x12U),     /* Cannot delete the Idle task.                    */
 	OS_ERR_TASK_POOL_EMPTY			=(0x50U),	  /* No more available TCB objects.					 */
+	OS_ERR_TASK_NOT_SCHEDULABLE		=(0x51U),	  /* The task set is not schedulable with the task.	 */
 
     OS_ERR_EVENT_PEVENT_NULL		=(0x13U),     /* OS_EVENT* is a  NULL pointer.                   */
     OS_ERR_EVENT_TYPE				=(0x14U),     /* Invalid event type.                             */
@@ -128,6 +129,14 @@ extern OS_ERR OS_ERRNO;                           /* Holds the last error code r
 
 #define OS_TCB_MUTEX_RESERVED           ((OS_TASK_TCB*)1U)
 
+#define OS_TICK_INFINITE                ((OS_TICK)0xFFFFFFFFU)
+
+#define OS_UTIL_ONE                     ((CPU_t32U)1U << 20U)       /* A CPU utilization of 100% in the admission test fixed point.     */
+
+#define OS_STAT_USAGE_MAX               (10000U)                    /* A CPU usage of 100% as measured by the statistics task.          */
+
+#define OS_TASK_STACK_PAINT             ((CPU_tSTK)0xA5A5A5A5A5A5A5A5ULL)   /* The fill of the never used stack words.              */
+
 /**************************** OS Reserved Priorities *************************/
 /********* Your Application should not assign any of these priorities ********/
 
@@ -208,6 +217,44 @@ extern OS_ERR OS_ERRNO;                           /* Holds the last error code r
 
 #define	 OS_FLAG_WAIT_SET_ANY			(0x08U)			/* Waits for ANY bits in an Event flag group to be SET.						*/
 
+/*
+*******************************************************************************
+*                  OS Trace Events (Event ids of OS_TRACE_RECORD)             *
+*******************************************************************************
+*/
+
+#define  OS_TRACE_EV_TASK_SWITCH		(0x01U)			/* The task is switched in.													*/
+
+#define  OS_TRACE_EV_TASK_READY			(0x02U)			/* The task is made ready.													*/
+
+#define  OS_TRACE_EV_TICK				(0x03U)			/* A system tick (or a number of ticks elapsed at once in tickless).			*/
+
+#define  OS_TRACE_EV_INT_ENTER			(0x04U)			/* An ISR is entered.														*/
+
+#define  OS_TRACE_EV_INT_EXIT			(0x05U)			/* An ISR is exited.															*/
+
+#define  OS_TRACE_EV_SEM_PEND			(0x10U)			/* The task pends on the semaphore 'pObj'.									*/
+
+#define  OS_TRACE_EV_SEM_POST			(0x11U)			/* The semaphore 'pObj' is posted.											*/
+
+#define  OS_TRACE_EV_MUTEX_PEND			(0x12U)			/* The task pends on the mutex 'pObj'.										*/
+
+#define  OS_TRACE_EV_MUTEX_POST			(0x13U)			/* The mutex 'pObj' is released.											*/
+
+#define  OS_TRACE_EV_MAILBOX_PEND		(0x14U)			/* The task pends on the mailbox 'pObj'.									*/
+
+#define  OS_TRACE_EV_MAILBOX_POST		(0x15U)			/* A message is posted to the mailbox 'pObj'.								*/
+
+#define  OS_TRACE_EV_FLAG_PEND			(0x16U)			/* The task pends on the event flag group 'pObj'.							*/
+
+#define  OS_TRACE_EV_FLAG_POST			(0x17U)			/* The event flag group 'pObj' is posted.									*/
+
+#define  OS_TRACE_EV_MEMORY_GET			(0x18U)			/* A block is allocated from the memory partition 'pObj'.					*/
+
+#define  OS_TRACE_EV_MEMORY_PUT			(0x19U)			/* A block is restored to the memory partition 'pObj'.						*/
+
+#define  OS_TRACE_TASK_NONE				(0xFFFFU)		/* The 'task' of a record which isn't related to a task.					*/
+
 /*
 *******************************************************************************
 *                               OS options                                    *
@@ -238,9 +285,24 @@ extern OS_ERR OS_ERRNO;                           /* Holds the last error code r
 
 #define OS_TASK_PERIODIC			(1U)				/* EDF Task Parameter, typical in hard real-time and control applications. 		 					*/
 
-#define OS_TASK_SPORADIC			(2U)				/* EDF Task Parameter, typical in soft real-time and multimedia applications. ( Not Implemented )	*/
+#define OS_TASK_SPORADIC			(2U)				/* EDF Task Parameter, typical in soft real-time and multimedia applications. ( Served by a CBS )	*/
+
+#define OS_TASK_APERIODIC			(3U)				/* EDF Task Parameter, typical for event driven jobs. ( Served by a CBS )							*/
+
+/************************* Periodic Job Overrun Policy *************************/
+/* OR-ed with OS_TASK_PERIODIC, Applied when a job runs longer than its WCET. [OS_CONFIG_TASK_BUDGET_EN]								*/
+
+#define OS_TASK_OVERRUN_NOTIFY		(0x10U)				/* The job keeps running, The overrun is only counted and notified by App_Hook_TaskOverrun().		*/
+
+#define OS_TASK_OVERRUN_DEMOTE		(0x20U)				/* The job keeps running in background (i.e after all the other ready jobs) till it ends.			*/
+
+#define OS_TASK_OVERRUN_SKIP		(0x30U)				/* The job keeps running, And the next job of the task is skipped.									*/
+
+#define OS_TASK_OVERRUN_ABORT		(0x40U)				/* The job is aborted, The task restarts from its entry point at its next period.					*/
+
+#define OS_TASK_OVERRUN_NONE		(0x00U)				/* Default to OS_TASK_OVERRUN_NOTIFY.																*/
 
-#define OS_TASK_APERIODIC			(3U)				/* NOT Implemented yet.																				*/
+#define OS_TASK_OVERRUN_MASK		(0x70U)
 
 /*
 * =============================================================================
@@ -265,6 +327,7 @@ extern OS_ERR OS_ERRNO;                           /* Holds the last error code r
  * Return(s)    :  OS_RET_OK, OS_ERR_PARAM
  *
  * Note(s)		: The First API to be called before calling any of prettyOS APIs.
+ *                It also creates the statistics task if OS_CONFIG_TASK_STAT_EN is enabled.
  */
 extern OS_tRet OS_Init (CPU_tSTK* pStackBaseIdleTask, CPU_tSTK stackSizeIdleTask);
 
@@ -293,6 +356,22 @@ extern void OS_Run (CPU_t32U cpuClockFreq);
  */
 extern void OS_TimerTick (void);
 
+#if (OS_CONFIG_TICKLESS_EN == OS_CONFIG_ENABLE)
+/*
+ * Function:  OS_TimerTickElapsed
+ * --------------------
+ * Signal the occurrence of a number of "system ticks" at once.
+ * A tickless port calls it on wake to catch up the system time after the ticks were suppressed.
+ *
+ * Arguments    : ticks     is the number of ticks elapsed since the last announced tick.
+ *
+ * Returns      : None.
+ *
+ * Notes        : 1) This function must be called from a ticker ISR.
+ */
+extern void OS_TimerTickElapsed (OS_TICK ticks);
+#endif
+
 /*
  * Function:  OS_IntEnter
  * --------------------
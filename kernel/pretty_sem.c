@@ -194,6 +194,7 @@ OS_SemPend (OS_SEM* pevent, OS_TICK timeout)
     }
 
     OS_CRTICAL_BEGIN();
+    OS_TRACE(OS_TRACE_EV_SEM_PEND, OS_currentTask, pevent);
 
     if(pevent->OSEventCount > 0U)                           /* If semaphore resource is available ...                    */
     {
@@ -209,7 +210,7 @@ OS_SemPend (OS_SEM* pevent, OS_TICK timeout)
 
     if(timeout > 0U)
     {
-        OS_BlockTime(OS_currentTask->TASK_priority);
+        OS_BlockTime(OS_currentTask);
         OS_currentTask->TASK_Stat |= OS_TASK_STAT_DELAY;
     }
 
@@ -273,6 +274,7 @@ OS_SemPost (OS_SEM* pevent)
     }
 
     OS_CRTICAL_BEGIN();
+    OS_TRACE(OS_TRACE_EV_SEM_POST, OS_currentTask, pevent);
 
     if (pevent->OSEventsTCBHead != ((OS_TASK_TCB*)0U)) {    /* See if any task waiting for semaphore.                     */
         OS_Event_TaskMakeReady(pevent, (void *)0,           /* Make Highest priority task waiting on event be ready.      */
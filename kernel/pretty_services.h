@@ -71,19 +71,51 @@ extern "C" {
 /*
  * Function:  OS_TaskCreate
  * --------------------
+ * Create a task which is scheduled by its absolute deadline.
  *
- *
- * Arguments    :
- *
- * Returns      :
- *
- * Note(s)		:
- */
+ * Arguments    :   TASK_Handler            is a function pointer to the task code.
+ *                  params                  is a pointer to the user supplied data which is passed to the task.
+ *                  pStackBase              is a pointer to the bottom of the task stack.
+ *                  stackSize               is the task stack size.
+ *                  task_type               = OS_TASK_PERIODIC  A job is released every `task_period` and its deadline is `task_relative_deadline`
+ *                                                              after its release. The job ends by calling OS_TaskYield().
+ *                                                              It can be OR-ed with an overrun policy OS_TASK_OVERRUN_[NOTIFY/DEMOTE/SKIP/ABORT]
+ *                                                              [OS_CONFIG_TASK_BUDGET_EN].
+ *                                          = OS_TASK_SPORADIC or OS_TASK_APERIODIC
+ *                                                              The task is event driven (i.e it pends on kernel services) and is served by
+ *                                                              a Constant Bandwidth Server (CBS) of budget Qs = `task_relative_deadline`
+ *                                                              and period Ts = `task_period`. It can't use more than Qs/Ts of the CPU.
+ *                  task_relative_deadline  is the relative deadline (or the server budget) in ticks.
+ *                  task_period             is the period (or the server period) in ticks.
+ *                  task_wcet               is the worst case execution time of a periodic job in ticks. [OS_CONFIG_TASK_ADMISSION_EN or OS_CONFIG_TASK_BUDGET_EN]
+ *                                              - 0 => The task is not accounted by the admission test and its jobs have no budget.
+ *                                              - It's not used for a server task, Its budget is its execution time.
+ *
+ * Returns      :   OS_ERRNO = { OS_ERR_NONE, OS_ERR_PARAM, OS_ERR_TASK_CREATE_ISR, OS_ERR_TASK_POOL_EMPTY, OS_ERR_TASK_NOT_SCHEDULABLE }
+ *
+ * Note(s)		:	1) When a server task becomes ready, it keeps its current deadline if the remaining budget can be used
+ *                     before it, Otherwise it gets a new deadline = now + Ts and a full budget.
+ *                  2) When the server budget is exhausted, The tick handler postpones its deadline by Ts and recharges the budget.
+ *                  3) With OS_CONFIG_TASK_ADMISSION_EN, The task is refused with OS_ERR_TASK_NOT_SCHEDULABLE if the sum of the
+ *                     densities C/min(D,T) of the tasks (Qs/Ts of the servers) exceeds 1. It's exact for deadlines equal to
+ *                     the periods, and a safe bound for shorter deadlines.
+ *                  4) With OS_CONFIG_TASK_BUDGET_EN, A periodic job which runs for `task_wcet` ticks without yielding is overrun and
+ *                     its task policy is applied. An aborted job has its stack frame rebuilt at its next release, So the task restarts
+ *                     from its entry. The POSIX port restarts the task on its thread at its next switch in.
+ */
+#if (OS_AUTO_CONFIG_TASK_WCET == OS_CONFIG_ENABLE)
+void OS_TaskCreate (void (*TASK_Handler)(void* params),
+                             void *params,
+                             CPU_tSTK* pStackBase,
+                             CPU_tSTK_SIZE  stackSize,
+                             OS_OPT task_type, OS_TICK task_relative_deadline, OS_TICK task_period, OS_TICK task_wcet );
+#else
 void OS_TaskCreate (void (*TASK_Handler)(void* params),
                              void *params,
                              CPU_tSTK* pStackBase,
                              CPU_tSTK_SIZE  stackSize,
                              OS_OPT task_type, OS_TICK task_relative_deadline, OS_TICK task_period );
+#endif
 
 /*
  * Function:  OS_TaskYield
@@ -110,6 +142,20 @@ void OS_TaskYield (void);
  */
 OS_BOOLEAN OS_Is_CurrentTaskMissedDeadline (void);
 
+#if (OS_CONFIG_TASK_BUDGET_EN == OS_CONFIG_ENABLE)
+/*
+ * Function:  OS_TaskJobStatsGet
+ * -----------------------------
+ * Get the deadline misses and the budget overruns of the jobs of the current task.
+ *
+ * Arguments    : 	pmisses		is a pointer to the number of jobs which completed after their deadline.
+ * 					poverruns	is a pointer to the number of jobs which ran out of their execution budget.
+ *
+ * Returns      :	None.
+ */
+void OS_TaskJobStatsGet (CPU_t32U* pmisses, CPU_t32U* poverruns);
+#endif
+
 #endif
 
 /* ****************************************************************************
@@ -129,19 +175,39 @@ OS_BOOLEAN OS_Is_CurrentTaskMissedDeadline (void);
  *                  params                  is a pointer to the user supplied data which is passed to the task.
  *                  pStackBase              is a pointer to the bottom of the task stack.
  *                  stackSize               is the task stack size.
- *                  priority                is the task priority. ( A unique priority must be assigned to each task )
+ *                  priority                is the task priority. ( A unique priority must be assigned to each task,
+ *                                              unless OS_CONFIG_ROUND_ROBIN_EN is enabled )
  *                                              - A greater number means a higher priority
  *                                              - 0 => is reserved for the OS'Idle Task.
  *                                              - 1 => is reserved for OS use.
  *                                              - OS_LOWEST_PRIO_LEVEL(0) < Allowed value <= OS_HIGHEST_PRIO_LEVEL
+ *                  task_wcet               is the worst case execution time of a job in ticks. [OS_CONFIG_TASK_ADMISSION_EN]
+ *                                              - 0 => The task is not accounted by the admission test.
+ *                  task_period             is the period of the task jobs in ticks, It's also their deadline. [OS_CONFIG_TASK_ADMISSION_EN]
  *
- * Returns      :   OS_RET_OK, OS_ERR_PARAM, OS_RET_ERROR_TASK_CREATE_ISR
+ * Returns      :   OS_RET_OK, OS_ERR_PARAM, OS_RET_ERROR_TASK_CREATE_ISR, OS_ERR_TASK_NOT_SCHEDULABLE
+ *
+ * Note(s)		:	1) With OS_CONFIG_TASK_ADMISSION_EN, The task is refused with OS_ERR_TASK_NOT_SCHEDULABLE if the total utilization
+ *                     exceeds 1 or if the response time analysis finds a task of the same or a lower priority which misses its period.
+ *                     The analysis runs with the scheduler locked but the interrupts enabled, It costs O(n) when the tasks pass
+ *                     the response time bound (Ci + Sum(Cj)) / (1 - Sum(Uj)) and is iterated only for the tasks which don't.
+ *                  2) Only the creation and the deletion are accounted, A priority change is not checked.
  */
+#if (OS_CONFIG_TASK_ADMISSION_EN == OS_CONFIG_ENABLE)
+OS_tRet OS_TaskCreate (void (*TASK_Handler)(void* params),
+                             void *params,
+                             CPU_tSTK* pStackBase,
+                             CPU_tSTK_SIZE  stackSize,
+                             OS_PRIO    priority,
+                             OS_TICK    task_wcet,
+                             OS_TICK    task_period);
+#else
 OS_tRet OS_TaskCreate (void (*TASK_Handler)(void* params),
                              void *params,
                              CPU_tSTK* pStackBase,
                              CPU_tSTK_SIZE  stackSize,
                              OS_PRIO    priority);
+#endif
 
 /*
  * Function:  OS_TaskDelete
@@ -212,6 +278,117 @@ OS_STATUS OS_TaskStatus (OS_PRIO prio);
  */
 OS_PRIO OS_TaskRunningPriorityGet (void);
 
+#if (OS_CONFIG_ROUND_ROBIN_EN == OS_CONFIG_ENABLE)
+
+/*
+ * Function:  OS_TaskYield
+ * --------------------
+ * Give up the rest of the current task time quanta to the next ready task of the same priority.
+ *
+ * Arguments    :   None.
+ *
+ * Returns      :   None.
+ *
+ * Note(s)		:	1) The calling task continues to run if there is no other ready task of the same priority.
+ */
+void OS_TaskYield (void);
+
+/*
+ * Function:  OS_TaskTimeQuantaSet
+ * --------------------
+ * Set the time quanta of a task which shares its priority with other tasks.
+ *
+ * Arguments    :   prio    is the task priority. The calling task if it runs at this priority, Otherwise the first
+ * 							created task of this priority.
+ * 					quanta	is the number of ticks the task runs before the next ready task of the same priority.
+ * 							0 means no time slicing, The task runs until it blocks or yields.
+ *
+ * Returns      :   OS_ERR_NONE, OS_ERR_PRIO_INVALID, OS_ERR_TASK_NOT_EXIST
+ */
+OS_tRet OS_TaskTimeQuantaSet (OS_PRIO prio, OS_TICK quanta);
+
+#endif
+
+#endif
+
+#if (OS_CONFIG_TASK_RUNTIME_EN == OS_CONFIG_ENABLE)
+
+/*
+ * Function:  OS_TaskRuntimeGet
+ * --------------------
+ * Get the CPU time consumed by a task since its creation.
+ *
+ * Arguments    :   prio    is the task priority.
+ *                          With the EDF scheduler, It's the task creation order (i.e 0 is the Idle task, Followed by
+ *                          the statistics task if enabled, Then the application tasks).
+ *
+ * Returns      :   The consumed time in units of OS_CPU_TimestampGet() (i.e nanoseconds in the POSIX port,
+ *                  CPU cycles in the ARM Cortex-M4 port).
+ *                  OS_ERRNO = { OS_ERR_NONE, OS_ERR_PRIO_INVALID, OS_ERR_TASK_NOT_EXIST }
+ *
+ * Note(s)      :   1) The runtime is accounted at each context switch, The time spent in the ISRs is charged
+ *                     to the interrupted task.
+ */
+CPU_t64U OS_TaskRuntimeGet (OS_PRIO prio);
+
+#endif
+
+#if (OS_CONFIG_TASK_LATENCY_EN == OS_CONFIG_ENABLE)
+
+/*
+ * Function:  OS_TaskLatencyHistGet
+ * --------------------
+ * Get the histogram of the dispatch latencies of a task, i.e the time from making it ready
+ * (OS_SemPost(), OS_MailBoxPost(), a timeout or a job release, ... etc) till it's switched in.
+ *
+ * Arguments    :   prio    is the task priority.
+ *                          With the EDF scheduler, It's the task creation order (i.e 0 is the Idle task, Followed by
+ *                          the statistics task if enabled, Then the application tasks).
+ *                  phist   is a pointer to an array of OS_CONFIG_TASK_LATENCY_BUCKETS counts to be filled.
+ *                          phist[i] is the number of latencies in [2^i, 2^(i+1)) units of OS_CPU_TimestampGet(),
+ *                          The last one counts all the longer latencies too.
+ *
+ * Returns      :   OS_ERR_NONE, OS_ERR_PARAM, OS_ERR_PRIO_INVALID, OS_ERR_TASK_NOT_EXIST
+ *
+ * Note(s)      :   1) The switch-in time is taken when the kernel requests the context switch from the port.
+ */
+OS_tRet OS_TaskLatencyHistGet (OS_PRIO prio, CPU_t32U* phist);
+
+/*
+ * Function:  OS_TaskLatencyHistReset
+ * --------------------
+ * Clear the histogram of the dispatch latencies of a task.
+ *
+ * Arguments    :   prio    is the task priority (or the task creation order with the EDF scheduler).
+ *
+ * Returns      :   OS_ERR_NONE, OS_ERR_PRIO_INVALID, OS_ERR_TASK_NOT_EXIST
+ */
+OS_tRet OS_TaskLatencyHistReset (OS_PRIO prio);
+
+#endif
+
+#if (OS_CONFIG_TASK_STACK_USAGE_EN == OS_CONFIG_ENABLE)
+
+/*
+ * Function:  OS_TaskStackUsageGet
+ * --------------------
+ * Get the stack high-water mark of a task, i.e the deepest the task stack has been used since its creation.
+ *
+ * Arguments    :   prio    is the task priority.
+ *                          With the EDF scheduler, It's the task creation order (i.e 0 is the Idle task, Followed by
+ *                          the statistics task if enabled, Then the application tasks).
+ *                  pused   is a pointer to be filled with the used bytes of the task stack.
+ *                  pfree   is a pointer to be filled with the never used bytes of the task stack.
+ *
+ * Returns      :   OS_ERR_NONE, OS_ERR_PARAM, OS_ERR_PRIO_INVALID, OS_ERR_TASK_NOT_EXIST
+ *
+ * Note(s)      :   1) The stack is painted with OS_TASK_STACK_PAINT at the task creation, The painted words are
+ *                     counted from the far end of the stack till the first overwritten one.
+ *                  2) A used word which happens to hold OS_TASK_STACK_PAINT is counted as free.
+ *                  3) Only the words which were free at the previous scan are checked again.
+ */
+OS_tRet OS_TaskStackUsageGet (OS_PRIO prio, CPU_tSTK_SIZE* pused, CPU_tSTK_SIZE* pfree);
+
 #endif
 
 /*
@@ -375,6 +552,31 @@ void OS_SemGetCount (OS_SEM* pevent, OS_SEM_COUNT* pCount);
  * ============================================================================
  * */
 
+#if(OS_CONFIG_EDF_EN == OS_CONFIG_ENABLE)
+/*
+ * Function:  OS_MutexCreate
+ * --------------------
+ * Creates a mutual exclusion semaphore which is managed by the Stack Resource Policy (SRP).
+ *
+ * Arguments    :   ceiling is the preemption ceiling of the mutex, It's the shortest relative deadline (in ticks)
+ *                          among ALL of the tasks competing for the mutex.
+ *                          While the mutex is locked, a new job can start only if its relative deadline is shorter than the
+ *                          ceiling (i.e its preemption level is higher). So a job never blocks on the mutex once it starts and
+ *                          the blocking is bounded by one critical section of a job with a longer relative deadline.
+ *
+ *                  opt     Enable/Disable the SRP ceiling.
+ *                          = OS_MUTEX_PRIO_CEIL_DISABLE    (Default) The waiting tasks are served by their absolute deadlines.
+ *                          = OS_MUTEX_PRIO_CEIL_ENABLE
+ *
+ * Returns      :  != (OS_EVENT*)0U  is a pointer to OS_EVENT object of type OS_EVENT_TYPE_MUTEX for the created mutex.
+ *                 == (OS_EVENT*)0U  if error is found.
+ *                 OS_ERRNO = { OS_ERR_NONE, OS_ERR_PARAM, OS_ERR_EVENT_CREATE_ISR, OS_ERR_EVENT_POOL_EMPTY}
+ *
+ * Note(s)      :   1) This function is used only from Task code level.
+ *                  2) 'OSMutexCeil' of returned (OS_EVENT*) is the ceiling or 'OS_TICK_INFINITE' if the SRP ceiling is disabled.
+ */
+OS_MUTEX* OS_MutexCreate (OS_TICK ceiling, OS_OPT opt);
+#else
 /*
  * Function:  OS_MutexCreate
  * --------------------
@@ -401,6 +603,7 @@ void OS_SemGetCount (OS_SEM* pevent, OS_SEM_COUNT* pCount);
  *                     'OSMutexPrioCeilP' of returned (OS_EVENT*)   is the raised priority to reduce the priority inversion or 'OS_PRIO_RESERVED_MUTEX' if priority ceiling promotion is disabled.
  */
 OS_MUTEX* OS_MutexCreate (OS_PRIO prio, OS_OPT opt);
+#endif
 
 /*
  * Function:  OS_MutexPend
@@ -420,6 +623,7 @@ OS_MUTEX* OS_MutexCreate (OS_PRIO prio, OS_OPT opt);
  * Note(s)      :   1) This function must used only from Task code level and not an ISR.
  *                  2) The task that owns the Mutex must not pend on any other events while it's owning the Mutex. Otherwise, you create a possible inversion priority bug.
  *                  3) [For the current implementation], Don't change the priority of the task that owns the Mutex at run time.
+ *                  4) With EDF, The Mutexes must be released in the reverse order of locking them.
  */
 void OS_MutexPend (OS_MUTEX* pevent, OS_TICK timeout);
 
@@ -669,6 +873,117 @@ void* OS_MemoryAllocateBlock (OS_MEMORY* pMemoryPart);
  */
 void OS_MemoryRestoreBlock (OS_MEMORY* pMemoryPart, void* pBlock);
 
+#if (OS_CONFIG_TASK_STAT_EN == OS_CONFIG_ENABLE)
+
+/*
+ * ============================================================================
+ * ============================================================================
+ *
+ * 						 PrettyOS' Statistics APIs
+ *
+ * ============================================================================
+ * ============================================================================
+ * */
+
+/*
+ * Function:  OS_StatCPUUsageGet
+ * --------------------
+ * Get the CPU usage, A moving average of the usage of the last OS_CONFIG_TASK_STAT_RATE_MS windows.
+ *
+ * Arguments    :   None.
+ *
+ * Returns      :   The CPU usage in 1/100 of percent (i.e 0 to OS_STAT_USAGE_MAX).
+ *
+ * Note(s)      :   1) The usage is 0 until the first window after OS_Run() is sampled.
+ *                  2) The idle time is measured and not counted, So an idle hook (or OS_CONFIG_TICKLESS_EN) may sleep the CPU.
+ *                  3) The time of an ISR is charged to the task it interrupted, The ISRs during idling count as idle time.
+ *                  4) It's a single memory read, It can be called from any task or ISR.
+ */
+CPU_t16U OS_StatCPUUsageGet (void);
+
+/*
+ * Function:  OS_StatCPUUsagePeakGet
+ * --------------------
+ * Get the highest CPU usage of a single window since the start or the last OS_StatCPUUsagePeakReset().
+ *
+ * Arguments    :   None.
+ *
+ * Returns      :   The peak CPU usage in 1/100 of percent (i.e 0 to OS_STAT_USAGE_MAX).
+ */
+CPU_t16U OS_StatCPUUsagePeakGet (void);
+
+/*
+ * Function:  OS_StatCPUUsagePeakReset
+ * --------------------
+ * Restart tracking the peak CPU usage from the next window.
+ *
+ * Arguments    :   None.
+ *
+ * Returns      :   None.
+ */
+void OS_StatCPUUsagePeakReset (void);
+
+#endif
+
+#if (OS_CONFIG_TRACE_EN == OS_CONFIG_ENABLE)
+
+/*
+ * ============================================================================
+ * ============================================================================
+ *
+ * 						 PrettyOS' Trace APIs
+ *
+ * ============================================================================
+ * ============================================================================
+ * */
+
+/*
+ * Function:  OS_TraceStart
+ * --------------------
+ * Clear the trace buffer and restart the recording of the kernel events.
+ *
+ * Arguments    :   None.
+ *
+ * Returns      :   None.
+ *
+ * Note(s)      :   1) The recording is started by OS_Init().
+ */
+void OS_TraceStart (void);
+
+/*
+ * Function:  OS_TraceStop
+ * --------------------
+ * Stop the recording of the kernel events, The recorded events are kept.
+ *
+ * Arguments    :   None.
+ *
+ * Returns      :   None.
+ */
+void OS_TraceStop (void);
+
+/*
+ * Function:  OS_TraceDump
+ * --------------------
+ * Copy the newest records of the trace buffer, From the oldest to the newest.
+ *
+ * Arguments    :   pRecords    is a pointer to an array of 'count' records to be filled.
+ *
+ *                  count       is the max. number of records to copy, Up to OS_CONFIG_TRACE_RECORDS.
+ *
+ *                  pStamp      is a pointer to be filled with the time of the newest record in OS_CPU_TimestampGet() units.
+ *
+ * Returns      :   The number of the copied records.
+ *
+ *                  OS_ERRNO = { OS_ERR_NONE, OS_ERR_PARAM }
+ *
+ * Note(s)      :   1) Each record holds the time since its previous record, The time of the record i is the time of
+ *                     the record i+1 minus the 'tsDelta' of the record i+1.
+ *                  2) Interrupts are disabled while copying.
+ */
+CPU_t32U OS_TraceDump (OS_TRACE_RECORD* pRecords, CPU_t32U count, CPU_t64U* pStamp);
+
+#endif
+
 
 #ifdef __cplusplus
 }
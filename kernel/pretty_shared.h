@@ -66,6 +66,7 @@ extern OS_ERR                       OS_ERRNO;
 	extern List OS_InactiveList;
 	extern List_Item OS_TCBList [OS_CONFIG_TASK_COUNT];
 	extern OS_TASK_COUNT volatile OS_SystemTasksCount;
+	extern OS_TICK volatile OS_SRP_SystemCeiling;
 #endif
 
 /*
@@ -86,21 +87,41 @@ extern void OS_EVENT_free       (OS_EVENT* pevent);
 extern void OS_Event_TaskInsert (OS_TASK_TCB* ptcb, OS_EVENT *pevent);
 extern void OS_Event_TaskRemove (OS_TASK_TCB* ptcb, OS_EVENT *pevent);
 extern void OS_Event_TaskPend   (OS_EVENT* pevent);
-extern OS_PRIO OS_Event_TaskMakeReady(OS_EVENT* pevent,
-                                      void* pmsg,
-                                      OS_STATUS TASK_StatEventMask,
-                                      OS_STATUS TASK_PendStat);
+extern OS_TASK_TCB* OS_Event_TaskMakeReady(OS_EVENT* pevent,
+                                           void* pmsg,
+                                           OS_STATUS TASK_StatEventMask,
+                                           OS_STATUS TASK_PendStat);
 
-extern void OS_SetReady    (OS_PRIO prio);
-extern void OS_RemoveReady (OS_PRIO prio);
+extern void OS_SetReady    (OS_TASK_TCB* ptcb);
+extern void OS_RemoveReady (OS_TASK_TCB* ptcb);
 
-extern void OS_BlockTime   (OS_PRIO prio);
-extern void OS_UnBlockTime (OS_PRIO prio);
+extern void OS_BlockTime   (OS_TASK_TCB* ptcb);
+extern void OS_UnBlockTime (OS_TASK_TCB* ptcb);
 
 extern void OS_TCB_ListInit (void);
 
+#if(OS_CONFIG_EDF_EN == OS_CONFIG_ENABLE)
+	extern void OS_TaskJobNext (OS_TASK_TCB* ptcb);
+#endif
+
+#if (OS_CONFIG_TASK_STAT_EN == OS_CONFIG_ENABLE)
+	extern OS_tRet OS_StatTaskInit (void);
+#endif
+
 extern void OS_Memory_Init (void);
 
+#if (OS_CONFIG_TASK_STACK_USAGE_EN == OS_CONFIG_ENABLE) && (OS_CONFIG_TASK_STACK_SCAN_WORDS > 0U)
+	extern void OS_TaskStackScan (void);
+#endif
+
+#if (OS_CONFIG_TRACE_EN == OS_CONFIG_ENABLE)
+	extern void OS_TraceInit   (void);
+	extern void OS_TraceRecord (CPU_t08U event, OS_TASK_TCB* ptcb, void* pObj);
+	#define OS_TRACE(event, ptcb, pObj)		OS_TraceRecord((CPU_t08U)(event), (ptcb), (void*)(pObj))	/* Interrupts must be disabled.	*/
+#else
+	#define OS_TRACE(event, ptcb, pObj)		do { } while(0)
+#endif
+
 extern void list_Init(List * const list);
 extern void listItem_Init(List_Item * const listItem);
 extern void listItemInsert (List * const list, List_Item * const listItem);
@@ -0,0 +1,278 @@
+/*****************************************************************************
+MIT License
+
+Copyright (c) 2020 Yahia Farghaly Ashour
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+/*
+ * Author   : 	Yahia Farghaly Ashour
+ *
+ * Purpose  :	Implementation of the statistics task which measures the CPU usage in prettyOS.
+ *
+ *              The idle task runtime (OS_CONFIG_TASK_RUNTIME_EN) is the CPU time left for idling. The statistics task
+ *              compares its increase in each window with the elapsed time, So an idle hook may sleep the CPU.
+ *
+ * Language	:  	C
+ *
+ * Set 1 tab = 4 spaces for better comments readability.
+ */
+
+/*
+*******************************************************************************
+*                               Includes Files                                *
+*******************************************************************************
+*/
+#include "pretty_os.h"
+#include "pretty_shared.h"
+
+#if (OS_CONFIG_TASK_STAT_EN == OS_CONFIG_ENABLE)
+
+/*
+*******************************************************************************
+*                               Local Macros                                  *
+*******************************************************************************
+*/
+
+#define OS_STAT_WINDOW_TICKS	(((OS_CONFIG_TASK_STAT_RATE_MS * OS_CONFIG_TICKS_PER_SEC) + 999U) / 1000U)	/* At least a tick.	*/
+
+/*
+*******************************************************************************
+*                               Local Variables                               *
+*******************************************************************************
+*/
+
+static OS_tSTACK			OS_StatTaskStk [OS_CONFIG_TASK_STAT_STACK_SIZE];
+
+static CPU_t64U				OS_StatIdleLast;		/* The runtime of the idle task at the last sample.						*/
+static CPU_t64U				OS_StatStampLast;		/* The port timestamp of the last sample.								*/
+
+static CPU_t16U	volatile	OS_StatCPUUsage;		/* Smoothed CPU usage, in 1/100 of percent.								*/
+static CPU_t16U	volatile	OS_StatCPUUsagePeak;	/* The highest CPU usage of a window.									*/
+static OS_BOOLEAN volatile	OS_StatRdy;				/* The first window was sampled.										*/
+
+/*
+*******************************************************************************
+*                                                                             *
+*                         PrettyOS Statistics Functions                       *
+*                                                                             *
+*******************************************************************************
+*/
+
+/*
+ * Function:  OS_StatSample
+ * --------------------
+ * Compute the CPU usage of the window since the last sample.
+ *
+ * Arguments    :   None.
+ *
+ * Returns      :   None.
+ *
+ * Notes        :   1) The usage is the part of the elapsed time not consumed by the idle task, So a late sample still
+ *                     gives the usage of its window.
+ *                  2) The time of the ISRs is charged to the task they interrupted.
+ */
+static void
+OS_StatSample (void)
+{
+	CPU_t64U idle;
+	CPU_t64U now;
+	CPU_t64U idle_delta;
+	CPU_t64U elapsed;
+	CPU_t16U usage;
+
+	now  = OS_CPU_TimestampGet();
+	idle = OS_TaskRuntimeGet(OS_IDLE_TASK_PRIO_LEVEL);		/* The idle task is not running, Its runtime is up to date.			*/
+
+	idle_delta       = idle - OS_StatIdleLast;
+	elapsed          = now  - OS_StatStampLast;
+	OS_StatIdleLast  = idle;
+	OS_StatStampLast = now;
+
+	if(elapsed == 0U)
+	{
+		return;
+	}
+
+	if(idle_delta >= elapsed)
+	{
+		usage = 0U;
+	}
+	else
+	{
+		usage = (CPU_t16U)(((elapsed - idle_delta) * OS_STAT_USAGE_MAX) / elapsed);
+	}
+
+	if(OS_StatRdy == OS_FAlSE)
+	{
+		OS_StatCPUUsage = usage;
+		OS_StatRdy      = OS_TRUE;
+	}
+	else
+	{
+		OS_StatCPUUsage = (CPU_t16U)((((CPU_t32U)OS_StatCPUUsage * 3U) + usage) / 4U);	/* Exponential moving average.		*/
+	}
+
+	if(usage > OS_StatCPUUsagePeak)
+	{
+		OS_StatCPUUsagePeak = usage;
+	}
+}
+
+/*
+ * Function:  OS_StatTask
+ * --------------------
+ * The statistics task, It samples the CPU usage every OS_CONFIG_TASK_STAT_RATE_MS.
+ *
+ * Arguments    :   args    is not used.
+ *
+ * Returns      :   None.
+ */
+static void
+OS_StatTask (void* args)
+{
+	(void)args;
+
+	OS_StatStampLast = OS_CPU_TimestampGet();				/* The first window starts now.										*/
+	OS_StatIdleLast  = OS_TaskRuntimeGet(OS_IDLE_TASK_PRIO_LEVEL);
+
+#if (OS_CONFIG_EDF_EN == OS_CONFIG_ENABLE)
+	OS_TaskYield();											/* End of the first job.											*/
+#endif
+
+	while(1)
+	{
+#if (OS_CONFIG_EDF_EN == OS_CONFIG_DISABLE)
+		OS_DelayTicks(OS_STAT_WINDOW_TICKS);
+#endif
+
+		OS_StatSample();
+
+#if (OS_CONFIG_EDF_EN == OS_CONFIG_ENABLE)
+		OS_TaskYield();										/* A job every window.												*/
+#endif
+	}
+}
+
+/*
+ * Function:  OS_StatTaskInit
+ * --------------------
+ * Create the statistics task.
+ *
+ * Arguments    :   None.
+ *
+ * Returns      :   OS_ERR_NONE or the error of OS_TaskCreate().
+ *
+ * Notes        :   1) Called by OS_Init() after the creation of the idle task.
+ *                  2) With the EDF scheduler, It's a periodic task with a window as its period and relative deadline.
+ */
+OS_tRet
+OS_StatTaskInit (void)
+{
+	OS_StatIdleLast     = 0U;
+	OS_StatStampLast    = 0U;
+	OS_StatCPUUsage     = 0U;
+	OS_StatCPUUsagePeak = 0U;
+	OS_StatRdy          = OS_FAlSE;
+
+#if (OS_CONFIG_EDF_EN == OS_CONFIG_DISABLE)
+
+	return OS_TaskCreate(OS_StatTask,
+						 OS_NULL(void),
+						 OS_StatTaskStk,
+						 sizeof(OS_StatTaskStk),
+#if (OS_CONFIG_TASK_ADMISSION_EN == OS_CONFIG_ENABLE)
+						 OS_CONFIG_TASK_STAT_PRIO,
+						 0U,						/* Not accounted by the admission test.								*/
+						 0U);
+#else
+						 OS_CONFIG_TASK_STAT_PRIO);
+#endif
+
+#else
+
+	OS_TaskCreate(OS_StatTask,
+				  OS_NULL(void),
+				  OS_StatTaskStk,
+				  sizeof(OS_StatTaskStk),
+				  OS_TASK_PERIODIC,
+				  OS_STAT_WINDOW_TICKS,
+#if (OS_AUTO_CONFIG_TASK_WCET == OS_CONFIG_ENABLE)
+				  OS_STAT_WINDOW_TICKS,
+				  0U);								/* Not accounted by the admission test and has no budget.			*/
+#else
+				  OS_STAT_WINDOW_TICKS);
+#endif
+
+#if(OS_CONFIG_ERRNO_EN == OS_CONFIG_ENABLE)
+	return (OS_ERRNO);
+#else
+	return (OS_ERR_NONE);
+#endif
+
+#endif
+}
+
+/*
+ * Function:  OS_StatCPUUsageGet
+ * --------------------
+ * Get the smoothed CPU usage.
+ *
+ * Arguments    :   None.
+ *
+ * Returns      :   The CPU usage in 1/100 of percent (i.e 0 to OS_STAT_USAGE_MAX).
+ */
+CPU_t16U
+OS_StatCPUUsageGet (void)
+{
+	return (OS_StatCPUUsage);
+}
+
+/*
+ * Function:  OS_StatCPUUsagePeakGet
+ * --------------------
+ * Get the highest CPU usage of a window since the start or the last OS_StatCPUUsagePeakReset().
+ *
+ * Arguments    :   None.
+ *
+ * Returns      :   The peak CPU usage in 1/100 of percent (i.e 0 to OS_STAT_USAGE_MAX).
+ */
+CPU_t16U
+OS_StatCPUUsagePeakGet (void)
+{
+	return (OS_StatCPUUsagePeak);
+}
+
+/*
+ * Function:  OS_StatCPUUsagePeakReset
+ * --------------------
+ * Restart tracking the peak CPU usage from the next window.
+ *
+ * Arguments    :   None.
+ *
+ * Returns      :   None.
+ */
+void
+OS_StatCPUUsagePeakReset (void)
+{
+	OS_StatCPUUsagePeak = 0U;
+}
+
+#endif
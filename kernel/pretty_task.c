@@ -50,6 +50,11 @@ SOFTWARE.
 static OS_TASK_TCB OS_TblTask[OS_CONFIG_TASK_COUNT];
 static OS_TASK_TCB* volatile pTCBFreeList;
 
+#if (OS_CONFIG_TASK_ADMISSION_EN == OS_CONFIG_ENABLE)
+/* Sum of the admitted tasks utilization (density under EDF) in 1/OS_UTIL_ONE units.*/
+static CPU_t32U OS_TaskUtilSum;
+#endif
+
 
 /*
 *******************************************************************************
@@ -76,6 +81,357 @@ OS_TCB_free (OS_TASK_TCB* ptcb)
 	pTCBFreeList 					= ptcb;
 }
 
+#if (OS_CONFIG_TASK_STACK_USAGE_EN == OS_CONFIG_ENABLE)
+
+/* The i-th stack word from the far end, i.e the end which is reached last as the stack grows.					*/
+#if (CPU_CONFIG_STACK_GROWTH == CPU_STACK_GROWTH_HIGH_TO_LOW)
+	#define OS_TASK_STACK_WORD(ptcb, i)			((ptcb)->TASK_StkUsageBase + (i))
+	#define OS_TASK_STACK_IS_FRAME(ptcb, pword)	((pword) >= (CPU_tSTK*)(ptcb)->TASK_SP)
+#else
+	#define OS_TASK_STACK_WORD(ptcb, i)			((ptcb)->TASK_StkUsageBase + ((ptcb)->TASK_StkUsageWords - 1U - (i)))
+	#define OS_TASK_STACK_IS_FRAME(ptcb, pword)	((pword) <= (CPU_tSTK*)(ptcb)->TASK_SP)
+#endif
+
+/*
+ * Function:  OS_TaskStackPaint
+ * --------------------
+ * Fill the unused part of a new task stack with OS_TASK_STACK_PAINT.
+ *
+ * Arguments    : ptcb    is a pointer to the TCB of the created task.
+ *
+ * Returns      : None.
+ *
+ * Notes        :   1) The words are painted from the far end up to the initial frame built by OS_CPU_TaskStackInit().
+ *                  2) Interrupts are assumed to be disabled.
+ */
+static void
+OS_TaskStackPaint (OS_TASK_TCB* ptcb)
+{
+	CPU_tSTK_SIZE idx;
+	CPU_tSTK*     pword;
+
+	for(idx = 0U; idx < ptcb->TASK_StkUsageWords; ++idx)
+	{
+		pword = OS_TASK_STACK_WORD(ptcb, idx);
+		if(OS_TASK_STACK_IS_FRAME(ptcb, pword))
+		{
+			break;
+		}
+		*pword = OS_TASK_STACK_PAINT;
+	}
+
+	ptcb->TASK_StkFreeWords = idx;
+	ptcb->TASK_StkScanIdx   = 0U;
+}
+
+/*
+ * Function:  OS_TaskStackFreeScan
+ * --------------------
+ * Find the first overwritten word of a task stack in a range of words counted from its far end.
+ *
+ * Arguments    : ptcb    is a pointer to the TCB of the task.
+ *                from    is the first word to be checked.
+ *                to      is the word after the last one to be checked.
+ *
+ * Returns      : The index of the first word which doesn't hold OS_TASK_STACK_PAINT, Or 'to' if all of them do.
+ */
+static CPU_tSTK_SIZE
+OS_TaskStackFreeScan (OS_TASK_TCB* ptcb, CPU_tSTK_SIZE from, CPU_tSTK_SIZE to)
+{
+	while(from < to && *OS_TASK_STACK_WORD(ptcb, from) == OS_TASK_STACK_PAINT)
+	{
+		++from;
+	}
+	return (from);
+}
+
+#endif
+
+#if(OS_CONFIG_EDF_EN == OS_CONFIG_DISABLE)
+
+/*
+ * Function:  OS_TCB_PrioGet
+ * --------------------
+ * Get the TCB of a task given its priority.
+ *
+ * Arguments    : prio    is the task priority.
+ *
+ * Returns      : A pointer to the TCB, OS_TCB_MUTEX_RESERVED or OS_NULL(OS_TASK_TCB).
+ *
+ * Notes        :   1) With Round Robin, A priority may be shared by many tasks. The calling task is returned
+ *                     if it runs at this priority, Otherwise the first created task of this priority.
+ *                  2) Interrupts are assumed to be disabled.
+ */
+static OS_TASK_TCB*
+OS_TCB_PrioGet (OS_PRIO prio)
+{
+#if (OS_CONFIG_ROUND_ROBIN_EN == OS_CONFIG_ENABLE)
+	if(OS_currentTask != OS_NULL(OS_TASK_TCB) && OS_currentTask->TASK_priority == prio)
+	{
+		return (OS_currentTask);
+	}
+#endif
+	return (OS_tblTCBPrio[prio]);
+}
+
+#if (OS_CONFIG_ROUND_ROBIN_EN == OS_CONFIG_ENABLE)
+
+/*
+ * Function:  OS_TCB_PrioInsert
+ * --------------------
+ * Append a TCB to the list of tasks created at a priority. OS_tblTCBPrio[] points to the first one.
+ *
+ * Arguments    : ptcb    is a pointer to the TCB.
+ *                prio    is the priority.
+ *
+ * Returns      : None.
+ */
+static void
+OS_TCB_PrioInsert (OS_TASK_TCB* ptcb, OS_PRIO prio)
+{
+	OS_TASK_TCB* pprev = OS_tblTCBPrio[prio];
+
+	ptcb->OSTCB_PrioNextPtr = OS_NULL(OS_TASK_TCB);
+
+	if(pprev == OS_NULL(OS_TASK_TCB))
+	{
+		OS_tblTCBPrio[prio] = ptcb;
+		return;
+	}
+
+	while(pprev->OSTCB_PrioNextPtr != OS_NULL(OS_TASK_TCB))
+	{
+		pprev = pprev->OSTCB_PrioNextPtr;
+	}
+	pprev->OSTCB_PrioNextPtr = ptcb;
+}
+
+/*
+ * Function:  OS_TCB_PrioRemove
+ * --------------------
+ * Remove a TCB from the list of tasks created at a priority.
+ *
+ * Arguments    : ptcb    is a pointer to the TCB.
+ *                prio    is the priority.
+ *
+ * Returns      : None.
+ */
+static void
+OS_TCB_PrioRemove (OS_TASK_TCB* ptcb, OS_PRIO prio)
+{
+	OS_TASK_TCB* pprev = OS_tblTCBPrio[prio];
+
+	if(pprev == ptcb)
+	{
+		OS_tblTCBPrio[prio] = ptcb->OSTCB_PrioNextPtr;				/* The next task (if any) is the first one of this priority.	*/
+	}
+	else if(pprev != OS_NULL(OS_TASK_TCB) && pprev != OS_TCB_MUTEX_RESERVED)
+	{
+		while(pprev->OSTCB_PrioNextPtr != OS_NULL(OS_TASK_TCB) &&
+			  pprev->OSTCB_PrioNextPtr != ptcb)
+		{
+			pprev = pprev->OSTCB_PrioNextPtr;
+		}
+		if(pprev->OSTCB_PrioNextPtr == ptcb)
+		{
+			pprev->OSTCB_PrioNextPtr = ptcb->OSTCB_PrioNextPtr;
+		}
+	}
+
+	ptcb->OSTCB_PrioNextPtr = OS_NULL(OS_TASK_TCB);
+}
+
+#endif
+
+#if (OS_CONFIG_TASK_ADMISSION_EN == OS_CONFIG_ENABLE)
+
+/*
+ * Function:  OS_TCB_PrioNext
+ * --------------------
+ * Get the next TCB created at the same priority of a TCB.
+ *
+ * Arguments    : ptcb    is a pointer to the TCB.
+ *
+ * Returns      : A pointer to the next TCB or OS_NULL(OS_TASK_TCB).
+ */
+static OS_TASK_TCB*
+OS_TCB_PrioNext (OS_TASK_TCB* ptcb)
+{
+#if (OS_CONFIG_ROUND_ROBIN_EN == OS_CONFIG_ENABLE)
+	return (ptcb->OSTCB_PrioNextPtr);
+#else
+	(void)ptcb;
+	return (OS_NULL(OS_TASK_TCB));
+#endif
+}
+
+/*
+ * Function:  OS_TaskInterference
+ * --------------------
+ * Compute the execution time of the tasks of a higher or the same priority released in a time window.
+ *
+ * Arguments    : prio    is the priority of the task under analysis.
+ *                pself   is the TCB of the task under analysis, It's not counted.
+ *                window  is the time window in ticks.
+ *
+ * Returns      : The sum of ceil(window/Tj) * Cj of these tasks.
+ *
+ * Notes        :   1) Tasks of the same priority are counted since they can run before the task in Round Robin.
+ */
+static CPU_t64U
+OS_TaskInterference (OS_PRIO prio, OS_TASK_TCB* pself, CPU_t64U window)
+{
+	OS_PRIO      lvl;
+	OS_TASK_TCB* ptcb;
+	CPU_t64U     interference = 0U;
+
+	for(lvl = OS_HIGHEST_PRIO_LEVEL; lvl >= prio; --lvl)
+	{
+		for(ptcb = OS_tblTCBPrio[lvl]; ptcb != OS_NULL(OS_TASK_TCB) && ptcb != OS_TCB_MUTEX_RESERVED; ptcb = OS_TCB_PrioNext(ptcb))
+		{
+			if(ptcb != pself && ptcb->TASK_WCET != 0U)
+			{
+				interference += ((window + ptcb->TASK_Period - 1U) / ptcb->TASK_Period) * ptcb->TASK_WCET;
+			}
+		}
+	}
+
+	return (interference);
+}
+
+/*
+ * Function:  OS_TaskResponseFits
+ * --------------------
+ * Run the response time analysis of a task, Its worst case response time R is the fixed point of
+ * R = C + OS_TaskInterference(R) + The interference of the new task, It must not exceed the task period.
+ *
+ * Arguments    : lvl         is the priority of the task under analysis.
+ *                pself       is the TCB of the task under analysis, OS_NULL(OS_TASK_TCB) for the new task.
+ *                wcet        is the worst case execution time of the task under analysis.
+ *                period      is the period of the task under analysis.
+ *                new_wcet    is the worst case execution time of the new task, 0 if it's the task under analysis.
+ *                new_period  is the period of the new task.
+ *
+ * Returns      : OS_TRUE if the task meets its deadline, otherwise OS_FAlSE.
+ *
+ * Notes        :   1) Every iteration costs O(n), So it's only run when OS_TaskIsSchedulable() can't bound R.
+ */
+static OS_BOOLEAN
+OS_TaskResponseFits (OS_PRIO lvl, OS_TASK_TCB* pself, OS_TICK wcet, OS_TICK period, OS_TICK new_wcet, OS_TICK new_period)
+{
+	CPU_t64U     resp = wcet;
+	CPU_t64U     resp_prev;
+
+	do
+	{
+		resp_prev = resp;
+		resp      = wcet + OS_TaskInterference(lvl, pself, resp_prev);
+		if(new_wcet != 0U)
+		{
+			resp += ((resp_prev + new_period - 1U) / new_period) * new_wcet;
+		}
+		if(resp > period)
+		{
+			return (OS_FAlSE);
+		}
+	} while(resp != resp_prev);
+
+	return (OS_TRUE);
+}
+
+/*
+ * Function:  OS_TaskIsSchedulable
+ * --------------------
+ * Check that a new task and the tasks of a lower or the same priority meet their deadlines.
+ * The response time of a task i is bounded by R <= (Ci + Sum(Cj)) / (1 - Sum(Uj)) over the tasks j which can run before it,
+ * So the sums are kept while the priority levels are walked down once. The exact response time analysis of
+ * OS_TaskResponseFits() is only run for the tasks whose bound exceeds their period.
+ *
+ * Arguments    : prio    is the priority of the new task.
+ *                wcet    is the worst case execution time of the new task.
+ *                period  is the period of the new task.
+ *                util    is the utilization of the new task.
+ *
+ * Returns      : OS_TRUE if all the analyzed tasks meet their deadlines, otherwise OS_FAlSE.
+ *
+ * Notes        :   1) The tasks of a higher priority than `prio` are not affected by the new task, So they are not analyzed.
+ *                  2) It runs with the interrupts enabled, The scheduler is assumed to be locked so the tasks can't change.
+ */
+static OS_BOOLEAN
+OS_TaskIsSchedulable (OS_PRIO prio, OS_TICK wcet, OS_TICK period, CPU_t32U util)
+{
+	OS_PRIO      lvl;
+	OS_TASK_TCB* ptcb;
+	CPU_t64U     sum_wcet = 0U;										/* Of the tasks at and above the level, Including the new task.	*/
+	CPU_t64U     sum_util = 0U;
+
+	for(lvl = OS_HIGHEST_PRIO_LEVEL; lvl > OS_IDLE_TASK_PRIO_LEVEL; --lvl)
+	{
+		if(lvl == prio)
+		{
+			sum_wcet += wcet;
+			sum_util += util;
+		}
+		for(ptcb = OS_tblTCBPrio[lvl]; ptcb != OS_NULL(OS_TASK_TCB) && ptcb != OS_TCB_MUTEX_RESERVED; ptcb = OS_TCB_PrioNext(ptcb))
+		{
+			sum_wcet += ptcb->TASK_WCET;
+			sum_util += ptcb->TASK_Util;
+		}
+
+		if(lvl > prio)
+		{
+			continue;
+		}
+
+		if(lvl == prio &&
+		   (sum_util - util >= OS_UTIL_ONE || sum_wcet * OS_UTIL_ONE > period * (OS_UTIL_ONE - (sum_util - util))) &&
+		   OS_TaskResponseFits(lvl, OS_NULL(OS_TASK_TCB), wcet, period, 0U, 0U) == OS_FAlSE)
+		{
+			return (OS_FAlSE);
+		}
+
+		for(ptcb = OS_tblTCBPrio[lvl]; ptcb != OS_NULL(OS_TASK_TCB) && ptcb != OS_TCB_MUTEX_RESERVED; ptcb = OS_TCB_PrioNext(ptcb))
+		{
+			if(ptcb->TASK_WCET == 0U)
+			{
+				continue;
+			}
+			if((sum_util - ptcb->TASK_Util >= OS_UTIL_ONE ||
+			    sum_wcet * OS_UTIL_ONE > ptcb->TASK_Period * (OS_UTIL_ONE - (sum_util - ptcb->TASK_Util))) &&
+			   OS_TaskResponseFits(lvl, ptcb, ptcb->TASK_WCET, ptcb->TASK_Period, wcet, period) == OS_FAlSE)
+			{
+				return (OS_FAlSE);
+			}
+		}
+	}
+
+	return (OS_TRUE);
+}
+
+#endif
+
+#endif
+
+#if (OS_CONFIG_TASK_ADMISSION_EN == OS_CONFIG_ENABLE)
+
+/*
+ * Function:  OS_TaskUtil
+ * --------------------
+ * Compute the share of the CPU of a task.
+ *
+ * Arguments    : wcet    is the worst case execution time of the task jobs.
+ *                period  is the period (or the relative deadline if it's shorter) of the task jobs.
+ *
+ * Returns      : wcet/period in 1/OS_UTIL_ONE units, Rounded up to keep the admission test safe.
+ */
+static CPU_t32U
+OS_TaskUtil (OS_TICK wcet, OS_TICK period)
+{
+	return ((CPU_t32U)((((CPU_t64U)wcet * OS_UTIL_ONE) + period - 1U) / period));
+}
+
+#endif
+
 
 /*
 *******************************************************************************
@@ -102,10 +458,9 @@ OS_TCB_ListInit (void)
     for(idx = 0; idx < OS_CONFIG_TASK_COUNT - 1; ++idx)
     {
         OS_TblTask[idx].TASK_Stat   = OS_TASK_STAT_DELETED;
-
-#if(OS_CONFIG_EDF_EN == OS_CONFIG_DISABLE)
         OS_TblTask[idx].TASK_Ticks  = 0U;
-#endif
+        OS_TblTask[idx].OSTCB_DelayNextPtr = OS_NULL(OS_TASK_TCB);
+        OS_TblTask[idx].OSTCB_DelayPrevPtr = OS_NULL(OS_TASK_TCB);
 
 #if (OS_AUTO_CONFIG_INCLUDE_EVENTS == OS_CONFIG_ENABLE)
 
@@ -118,10 +473,9 @@ OS_TCB_ListInit (void)
     }
 
     OS_TblTask[OS_CONFIG_TASK_COUNT - 1].TASK_Stat   	= OS_TASK_STAT_DELETED;
-
-#if(OS_CONFIG_EDF_EN == OS_CONFIG_DISABLE)
     OS_TblTask[OS_CONFIG_TASK_COUNT - 1].TASK_Ticks  	= 0U;
-#endif
+    OS_TblTask[OS_CONFIG_TASK_COUNT - 1].OSTCB_DelayNextPtr = OS_NULL(OS_TASK_TCB);
+    OS_TblTask[OS_CONFIG_TASK_COUNT - 1].OSTCB_DelayPrevPtr = OS_NULL(OS_TASK_TCB);
 
 #if (OS_AUTO_CONFIG_INCLUDE_EVENTS == OS_CONFIG_ENABLE)
 
@@ -134,6 +488,10 @@ OS_TCB_ListInit (void)
     OS_tblTCBPrio[OS_CONFIG_TASK_COUNT - 1]          	= OS_NULL(OS_TASK_TCB);
 
     pTCBFreeList = &OS_TblTask[0];						/* Point to the first free TCB's task object.	*/
+
+#if (OS_CONFIG_TASK_ADMISSION_EN == OS_CONFIG_ENABLE)
+    OS_TaskUtilSum = 0U;								/* No task is admitted yet.						*/
+#endif
 }
 
 /* ****************************************************************************
@@ -145,19 +503,86 @@ OS_TCB_ListInit (void)
 
 #if(OS_CONFIG_EDF_EN == OS_CONFIG_ENABLE)
 
+/*
+ * Function:  OS_TaskJobNext
+ * --------------------
+ * End the current job of a periodic task and queue its next job.
+ *
+ * Arguments    : ptcb    is a pointer to the TCB of the task. It's the running task.
+ *
+ * Returns      : None.
+ *
+ * Notes        :   1) Interrupts are assumed to be disabled.
+ *                  2) This function is internal to PrettyOS functions.
+ */
+void
+OS_TaskJobNext (OS_TASK_TCB* ptcb)
+{
+	/* The next call should be in its next period.										*/
+	ptcb->EDF_params.tick_arrive += ptcb->EDF_params.task_period;
+	/* The new absolute deadline. 														*/
+	ptcb->EDF_params.tick_absolute_deadline = ptcb->EDF_params.tick_arrive + ptcb->EDF_params.tick_relative_deadline;
+	/* Indicate the the current task wants to yield (give up) the CPU resources.		*/
+	ptcb->EDF_params.task_yield	  = OS_TRUE;
+	/* The next job has to pass the SRP ceiling test before it starts.					*/
+	ptcb->EDF_params.task_started = OS_FAlSE;
+
+#if (OS_CONFIG_TASK_BUDGET_EN == OS_CONFIG_ENABLE)
+	ptcb->EDF_params.job_budget_left = ptcb->TASK_WCET;	/* A full budget for the next job.			*/
+	ptcb->EDF_params.job_overrun	 = OS_TASK_OVERRUN_NONE;
+#endif
+
+	if(ptcb->EDF_params.tick_arrive > OS_TickTime)
+	{
+	/* Insert the task in an inactive state till the next arrive time.					*/
+		ptcb->pListItemOwner->itemVal = ptcb->EDF_params.tick_arrive;
+		listItemInsert(&OS_InactiveList,ptcb->pListItemOwner);
+	}
+	else
+	{
+	/* Its next job has already arrived (i.e overrun), So release it at once.			*/
+		ptcb->pListItemOwner->itemVal = ptcb->EDF_params.tick_absolute_deadline;
+		listItemInsert(&OS_ReadyList,ptcb->pListItemOwner);
+	}
+}
+
 void
 OS_TaskCreate (void (*TASK_Handler)(void* params),
                              void *params,
                              CPU_tSTK* pStackBase,
                              CPU_tSTK_SIZE  stackSize,
+#if (OS_AUTO_CONFIG_TASK_WCET == OS_CONFIG_ENABLE)
+                             OS_OPT task_type, OS_TICK task_relative_deadline, OS_TICK task_period, OS_TICK task_wcet )
+#else
                              OS_OPT task_type, OS_TICK task_relative_deadline, OS_TICK task_period )
+#endif
 {
 
 	CPU_tWORD* stack_top;
 	OS_TASK_TCB* ptcb;
+#if (OS_CONFIG_TASK_ADMISSION_EN == OS_CONFIG_ENABLE)
+	CPU_t32U util;
+#endif
+#if (OS_CONFIG_TASK_BUDGET_EN == OS_CONFIG_ENABLE)
+	OS_OPT task_overrun = task_type & OS_TASK_OVERRUN_MASK;	/* The overrun policy is OR-ed with the task type.		*/
+#endif
 
 	CPU_SR_ALLOC();
 
+#if (OS_CONFIG_TASK_BUDGET_EN == OS_CONFIG_ENABLE)
+	task_type = task_type & (OS_OPT)(~OS_TASK_OVERRUN_MASK);
+	if(task_overrun > OS_TASK_OVERRUN_ABORT ||
+	   (task_type != OS_TASK_PERIODIC && task_overrun != OS_TASK_OVERRUN_NONE))	/* A server is limited by its budget.	*/
+	{
+		OS_ERR_SET(OS_ERR_PARAM);
+		return;
+	}
+	if(task_overrun == OS_TASK_OVERRUN_NONE)
+	{
+		task_overrun = OS_TASK_OVERRUN_NOTIFY;
+	}
+#endif
+
 	if(TASK_Handler == OS_NULL(void) || pStackBase == OS_NULL(CPU_tWORD) ||
 			stackSize == 0U )
 	{
@@ -165,12 +590,46 @@ OS_TaskCreate (void (*TASK_Handler)(void* params),
 		return;
 	}
 
-	if(task_type != OS_TASK_PERIODIC)	/* Current Implementation for the periodic tasks.			*/
+	if(task_type != OS_TASK_PERIODIC && task_type != OS_TASK_SPORADIC && task_type != OS_TASK_APERIODIC)
 	{
 		OS_ERR_SET(OS_ERR_PARAM);
 		return;
 	}
 
+	if(task_type != OS_TASK_PERIODIC &&	/* A server budget must fit in the server period.			*/
+	   (task_relative_deadline == 0U || task_relative_deadline > task_period))
+	{
+		OS_ERR_SET(OS_ERR_PARAM);
+		return;
+	}
+
+#if (OS_AUTO_CONFIG_TASK_WCET == OS_CONFIG_ENABLE)
+	if(task_type != OS_TASK_PERIODIC)	/* The execution time of a server is its budget Qs.			*/
+	{
+		task_wcet = task_relative_deadline;
+	}
+	else if(task_wcet > task_relative_deadline || task_wcet > task_period)
+	{
+		OS_ERR_SET(OS_ERR_PARAM);
+		return;
+	}
+#endif
+
+#if (OS_CONFIG_TASK_ADMISSION_EN == OS_CONFIG_ENABLE)
+	if(task_type != OS_TASK_PERIODIC)	/* A server takes Qs/Ts of the CPU whatever its jobs are.	*/
+	{
+		util      = OS_TaskUtil(task_relative_deadline, task_period);
+	}
+	else if(task_wcet == 0U)			/* Not accounted by the admission test.						*/
+	{
+		util      = 0U;
+	}
+	else								/* The density C/min(D,T), Enough for deadlines shorter than the period.	*/
+	{
+		util      = OS_TaskUtil(task_wcet, (task_relative_deadline < task_period) ? task_relative_deadline : task_period);
+	}
+#endif
+
 	OS_CRTICAL_BEGIN();
 
 	if(OS_IntNestingLvl > 0U)
@@ -180,6 +639,15 @@ OS_TaskCreate (void (*TASK_Handler)(void* params),
 		return;
 	}
 
+#if (OS_CONFIG_TASK_ADMISSION_EN == OS_CONFIG_ENABLE)
+	if(util > OS_UTIL_ONE - OS_TaskUtilSum)	/* EDF meets all the deadlines as long as the total density doesn't exceed 1.	*/
+	{
+		OS_CRTICAL_END();
+		OS_ERR_SET(OS_ERR_TASK_NOT_SCHEDULABLE);
+		return;
+	}
+#endif
+
 	stack_top = OS_CPU_TaskStackInit(TASK_Handler, params, pStackBase, stackSize);
 
 	ptcb = OS_TCB_allocate();
@@ -197,6 +665,11 @@ OS_TaskCreate (void (*TASK_Handler)(void* params),
 	ptcb->TASK_SP_Limit = (void*)pStackBase;
 #endif
 
+#if (OS_CONFIG_TASK_STACK_USAGE_EN == OS_CONFIG_ENABLE)
+	ptcb->TASK_StkUsageBase  = pStackBase;
+	ptcb->TASK_StkUsageWords = stackSize / sizeof(CPU_tSTK);
+#endif
+
 	ptcb->TASK_Stat     = OS_TASK_STAT_READY;
 
 #if (OS_AUTO_CONFIG_INCLUDE_EVENTS == OS_CONFIG_ENABLE)
@@ -212,19 +685,61 @@ OS_TaskCreate (void (*TASK_Handler)(void* params),
 	ptcb->TASK_EntryArg  = params;
 #endif
 
+#if (OS_CONFIG_TASK_RUNTIME_EN == OS_CONFIG_ENABLE)
+	ptcb->TASK_Runtime   = 0U;
+#endif
+
+#if (OS_CONFIG_TASK_LATENCY_EN == OS_CONFIG_ENABLE)
+	ptcb->TASK_ReadyStamp = 0U;
+	OS_MemoryByteClear((CPU_t08U*)ptcb->TASK_LatencyHist, sizeof(ptcb->TASK_LatencyHist));
+#endif
+
 	/* Fill The EDF Parameters in the TCB task.																					 */
 	ptcb->EDF_params.tick_relative_deadline = task_relative_deadline;
 	ptcb->EDF_params.task_period			= task_period;
 	ptcb->EDF_params.task_type				= task_type;
 	ptcb->EDF_params.task_yield				= OS_FAlSE;
+	ptcb->EDF_params.task_started			= OS_FAlSE;
+	ptcb->EDF_params.tick_arrive			= OS_TickTime;	/* The first job arrives at the creation time.		*/
+	ptcb->EDF_params.server_budget			= 0U;
+	ptcb->EDF_params.server_budget_left		= 0U;
+
+#if (OS_AUTO_CONFIG_TASK_WCET == OS_CONFIG_ENABLE)
+	ptcb->TASK_WCET							= task_wcet;
+#endif
+
+#if (OS_CONFIG_TASK_ADMISSION_EN == OS_CONFIG_ENABLE)
+	ptcb->TASK_Util							= util;
+	OS_TaskUtilSum						   += util;
+#endif
+
+#if (OS_CONFIG_TASK_BUDGET_EN == OS_CONFIG_ENABLE)
+	ptcb->TASK_StkBase						= pStackBase;
+	ptcb->TASK_StkSize						= stackSize;
+	ptcb->EDF_params.task_overrun			= task_overrun;
+	ptcb->EDF_params.job_overrun			= OS_TASK_OVERRUN_NONE;
+	ptcb->EDF_params.job_budget_left		= (task_type == OS_TASK_PERIODIC) ? task_wcet : 0U;
+	ptcb->EDF_params.job_overruns			= 0U;
+	ptcb->EDF_params.job_misses				= 0U;
+	ptcb->EDF_params.job_mutexes			= 0U;
+#endif
 
 	if(task_type == OS_TASK_PERIODIC)
 	{
 		ptcb->EDF_params.tick_absolute_deadline = OS_TickTime + task_relative_deadline;
 	}
+	else
+	{
+	/* A sporadic/aperiodic task is served by a Constant Bandwidth Server of budget Qs = task_relative_deadline and
+	 * period Ts = task_period, The server deadlines are relative to Ts. 														 */
+		ptcb->EDF_params.tick_relative_deadline = task_period;
+		ptcb->EDF_params.server_budget			= task_relative_deadline;
+		ptcb->EDF_params.server_budget_left		= task_relative_deadline;
+		ptcb->EDF_params.tick_absolute_deadline = OS_TickTime + task_period;
+	}
 
-	/* Insert into the Ready List with relative deadlines.																		 */
-	OS_TCBList[OS_SystemTasksCount].itemVal = task_relative_deadline;
+	/* Insert into the Ready List with absolute deadlines.																		 */
+	OS_TCBList[OS_SystemTasksCount].itemVal = ptcb->EDF_params.tick_absolute_deadline;
 	/* Link the List Item object to the allocated TCB.																			 */
 	OS_TCBList[OS_SystemTasksCount].pOwner  = (void*)ptcb;
 	/* Link TCB to its List Item.																								 */
@@ -248,6 +763,10 @@ OS_TaskCreate (void (*TASK_Handler)(void* params),
 		App_Hook_TaskCreated (ptcb);
 #endif
 
+#if (OS_CONFIG_TASK_STACK_USAGE_EN == OS_CONFIG_ENABLE)
+	OS_TaskStackPaint(ptcb);							/* After the port hook, Which may move the measured stack.			 */
+#endif
+
 	if(OS_TRUE == OS_Running)
 	{
 	/* Schedule whose deadline is nearest.   																				     */
@@ -281,16 +800,17 @@ OS_TaskYield (void)
 	{
 		if(OS_currentTask->EDF_params.task_type == OS_TASK_PERIODIC)
 		{
-			/* For a periodic task ...															*/
-			/* ... The next call should be in its next period.									*/
-			OS_currentTask->EDF_params.tick_arrive += OS_currentTask->EDF_params.task_period;
-			/* ... The new absolute deadline. 													*/
-			OS_currentTask->EDF_params.tick_absolute_deadline = OS_currentTask->EDF_params.tick_arrive + OS_currentTask->EDF_params.tick_relative_deadline;
-			/* ... Indicate the the current task wants to yield (give up) the CPU resources.	*/
-			OS_currentTask->EDF_params.task_yield	= OS_TRUE;
-			/* Insert the current task in an inactive state till the next arrive time.			*/
-			OS_currentTask->pListItemOwner->itemVal = OS_currentTask->EDF_params.tick_arrive;
-			listItemInsert(&OS_InactiveList,OS_currentTask->pListItemOwner);
+#if (OS_CONFIG_TASK_BUDGET_EN == OS_CONFIG_ENABLE)
+			if(OS_TickTime > OS_currentTask->EDF_params.tick_arrive + OS_currentTask->EDF_params.tick_relative_deadline)
+			{
+				++OS_currentTask->EDF_params.job_misses;	/* The job completed after its deadline.		*/
+			}
+			if(OS_currentTask->EDF_params.job_overrun == OS_TASK_OVERRUN_SKIP)
+			{
+				OS_currentTask->EDF_params.tick_arrive += OS_currentTask->EDF_params.task_period;
+			}
+#endif
+			OS_TaskJobNext(OS_currentTask);
 		}
 	}
 
@@ -318,7 +838,8 @@ OS_TaskYield (void)
  *                  params                  is a pointer to the user supplied data which is passed to the task.
  *                  pStackBase              is a pointer to the bottom of the task stack.
  *                  stackSize               is the task stack size.
- *                  priority                is the task priority. ( A unique priority must be assigned to each task )
+ *                  priority                is the task priority. ( A unique priority must be assigned to each task,
+ *                                              unless OS_CONFIG_ROUND_ROBIN_EN is enabled )
  *                                              - A greater number means a higher priority
  *                                              - 0 => is reserved for the OS'Idle Task.
  *                                              - 1 => is reserved for OS use.
@@ -331,10 +852,18 @@ OS_TaskCreate (void (*TASK_Handler)(void* params),
                              void *params,
                              CPU_tSTK* pStackBase,
                              CPU_tSTK_SIZE  stackSize,
+#if (OS_CONFIG_TASK_ADMISSION_EN == OS_CONFIG_ENABLE)
+                             OS_PRIO priority, OS_TICK task_wcet, OS_TICK task_period)
+#else
                              OS_PRIO priority)
+#endif
 
 {
     CPU_tWORD* stack_top;
+    OS_TASK_TCB* ptcb;
+#if (OS_CONFIG_TASK_ADMISSION_EN == OS_CONFIG_ENABLE)
+    CPU_t32U util = 0U;
+#endif
     CPU_SR_ALLOC();
 
     if(TASK_Handler == OS_NULL(void) || pStackBase == OS_NULL(CPU_tWORD) ||
@@ -344,63 +873,142 @@ OS_TaskCreate (void (*TASK_Handler)(void* params),
         return (OS_ERR_PARAM);
     }
 
-    OS_CRTICAL_BEGIN();
+#if (OS_CONFIG_TASK_ADMISSION_EN == OS_CONFIG_ENABLE)
+    if(task_wcet != 0U)                                                           /* 0 => Not accounted by the admission test.                                               */
+    {
+        if(task_wcet > task_period)
+        {
+            OS_ERR_SET(OS_ERR_PARAM);
+            return (OS_ERR_PARAM);
+        }
+        util = OS_TaskUtil(task_wcet, task_period);
+    }
+#endif
 
     if(OS_IntNestingLvl > 0U)                                                     /* Don't Create a task from an ISR.                                                        */
     {
-        OS_CRTICAL_END();
     	OS_ERR_SET(OS_ERR_TASK_CREATE_ISR);
         return (OS_ERR_TASK_CREATE_ISR);
     }
 
+#if (OS_CONFIG_TASK_ADMISSION_EN == OS_CONFIG_ENABLE)
+    OS_SchedLock();                                                               /* No other task can change the task set, While it's analyzed with the interrupts enabled. */
+
+    if(util > OS_UTIL_ONE - OS_TaskUtilSum ||                                      /* No task set above 100% of the CPU can be scheduled.                                     */
+       (task_wcet != 0U && OS_IS_VALID_PRIO(priority) &&
+        OS_TaskIsSchedulable(priority, task_wcet, task_period, util) == OS_FAlSE)) /* A task of the same or a lower priority would miss its deadline.                         */
+    {
+        OS_SchedUnlock();
+        OS_ERR_SET(OS_ERR_TASK_NOT_SCHEDULABLE);
+        return (OS_ERR_TASK_NOT_SCHEDULABLE);
+    }
+#endif
+
+    OS_CRTICAL_BEGIN();
+
     stack_top = OS_CPU_TaskStackInit(TASK_Handler, params, pStackBase, stackSize);     /* Call low level function to Initialize the stack frame of the task.                      */
 
     if(OS_IS_VALID_PRIO(priority))
     {
 
+#if (OS_CONFIG_ROUND_ROBIN_EN == OS_CONFIG_ENABLE)
+        if(OS_tblTCBPrio[priority] == OS_TCB_MUTEX_RESERVED)         				 	/* A priority can be shared by tasks but not with a mutex.                                 */
+#else
         if(OS_tblTCBPrio[priority] != OS_NULL(OS_TASK_TCB))            				 	/* Check that the task is not in use.                                                      */
+#endif
         {
             OS_CRTICAL_END();
+#if (OS_CONFIG_TASK_ADMISSION_EN == OS_CONFIG_ENABLE)
+            OS_SchedUnlock();
+#endif
             OS_ERR_SET(OS_ERR_TASK_CREATE_EXIST);
             return (OS_ERR_TASK_CREATE_EXIST);
         }
 
-        OS_tblTCBPrio[priority] = OS_TCB_allocate();
+        ptcb = OS_TCB_allocate();
+
+        if(ptcb == OS_NULL(OS_TASK_TCB))                                             /* No more free TCB objects.                                                                 */
+        {
+            OS_CRTICAL_END();
+#if (OS_CONFIG_TASK_ADMISSION_EN == OS_CONFIG_ENABLE)
+            OS_SchedUnlock();
+#endif
+            OS_ERR_SET(OS_ERR_TASK_POOL_EMPTY);
+            return (OS_ERR_TASK_POOL_EMPTY);
+        }
 
-        OS_tblTCBPrio[priority]->TASK_SP       = stack_top;
+        ptcb->TASK_SP       = stack_top;
 
 #if (OS_CONFIG_CPU_SOFT_STK_OVERFLOW_DETECTION == OS_CONFIG_ENABLE)
-        OS_tblTCBPrio[priority]->TASK_SP_Limit = (void*)pStackBase;
+        ptcb->TASK_SP_Limit = (void*)pStackBase;
+#endif
+#if (OS_CONFIG_TASK_STACK_USAGE_EN == OS_CONFIG_ENABLE)
+        ptcb->TASK_StkUsageBase  = pStackBase;
+        ptcb->TASK_StkUsageWords = stackSize / sizeof(CPU_tSTK);
 #endif
-        OS_tblTCBPrio[priority]->TASK_priority = priority;
-        OS_tblTCBPrio[priority]->TASK_Stat     = OS_TASK_STAT_READY;
+        ptcb->TASK_priority = priority;
+        ptcb->TASK_Stat     = OS_TASK_STAT_READY;
 
 #if (OS_AUTO_CONFIG_INCLUDE_EVENTS == OS_CONFIG_ENABLE)
 
-        OS_tblTCBPrio[priority]->TASK_PendStat = OS_STAT_PEND_OK;
-        OS_tblTCBPrio[priority]->OSTCB_NextPtr = OS_NULL(OS_TASK_TCB);
-        OS_tblTCBPrio[priority]->TASK_Event    = OS_NULL(OS_EVENT);
+        ptcb->TASK_PendStat = OS_STAT_PEND_OK;
+        ptcb->OSTCB_NextPtr = OS_NULL(OS_TASK_TCB);
+        ptcb->TASK_Event    = OS_NULL(OS_EVENT);
 
 #endif
 
 #if (OS_CONFIG_TCB_TASK_ENTRY_STORE_EN == OS_CONFIG_ENABLE)
-        OS_tblTCBPrio[priority]->TASK_EntryAddr = TASK_Handler;
-        OS_tblTCBPrio[priority]->TASK_EntryArg  = params;
+        ptcb->TASK_EntryAddr = TASK_Handler;
+        ptcb->TASK_EntryArg  = params;
+#endif
+
+#if (OS_CONFIG_TASK_RUNTIME_EN == OS_CONFIG_ENABLE)
+        ptcb->TASK_Runtime   = 0U;
+#endif
+
+#if (OS_CONFIG_TASK_LATENCY_EN == OS_CONFIG_ENABLE)
+        ptcb->TASK_ReadyStamp = 0U;
+        OS_MemoryByteClear((CPU_t08U*)ptcb->TASK_LatencyHist, sizeof(ptcb->TASK_LatencyHist));
+#endif
+
+#if (OS_CONFIG_ROUND_ROBIN_EN == OS_CONFIG_ENABLE)
+        ptcb->OSTCB_ReadyNextPtr = OS_NULL(OS_TASK_TCB);
+        ptcb->OSTCB_ReadyPrevPtr = OS_NULL(OS_TASK_TCB);
+        ptcb->TASK_TimeQuanta    = OS_CONFIG_ROUND_ROBIN_QUANTA_DEFAULT;
+        ptcb->TASK_TimeQuantaCtr = OS_CONFIG_ROUND_ROBIN_QUANTA_DEFAULT;
+
+        OS_TCB_PrioInsert(ptcb, priority);                                       /* Join the other tasks of this priority (if any).                                           */
+#else
+        OS_tblTCBPrio[priority] = ptcb;
+#endif
+
+#if (OS_CONFIG_TASK_ADMISSION_EN == OS_CONFIG_ENABLE)
+        ptcb->TASK_WCET   = task_wcet;
+        ptcb->TASK_Period = task_period;
+        ptcb->TASK_Util   = util;
+        OS_TaskUtilSum   += util;
 #endif
 
 #if(OS_CONFIG_CPU_TASK_CREATED == OS_CONFIG_ENABLE)
-        OS_CPU_Hook_TaskCreated (OS_tblTCBPrio[priority]);						 /* Call port specific task creation code.													  */
+        OS_CPU_Hook_TaskCreated (ptcb);											 /* Call port specific task creation code.													  */
 #endif
 
 #if (OS_CONFIG_APP_TASK_CREATED == OS_CONFIG_ENABLE)
-        App_Hook_TaskCreated (OS_tblTCBPrio[priority]);							 /* Calls Application specific code for a successfully created task.						  */
+        App_Hook_TaskCreated (ptcb);												 /* Calls Application specific code for a successfully created task.						  */
+#endif
+
+#if (OS_CONFIG_TASK_STACK_USAGE_EN == OS_CONFIG_ENABLE)
+        OS_TaskStackPaint(ptcb);													 /* After the port hook, Which may move the measured stack.									  */
 #endif
 
-        OS_SetReady(priority);                                                   /* Put in ready state.                                                                       */
+        OS_SetReady(ptcb);                                                       /* Put in ready state.                                                                       */
     }
     else
     {
         OS_CRTICAL_END();
+#if (OS_CONFIG_TASK_ADMISSION_EN == OS_CONFIG_ENABLE)
+        OS_SchedUnlock();
+#endif
         OS_ERR_SET(OS_ERR_PRIO_INVALID);
         return (OS_ERR_PRIO_INVALID);
     }
@@ -412,6 +1020,10 @@ OS_TaskCreate (void (*TASK_Handler)(void* params),
 
     OS_CRTICAL_END();
 
+#if (OS_CONFIG_TASK_ADMISSION_EN == OS_CONFIG_ENABLE)
+    OS_SchedUnlock();                                                           /* Switches to the new task if it has a higher priority.                                      */
+#endif
+
     OS_ERR_SET(OS_ERR_NONE);
     return (OS_ERR_NONE);
 }
@@ -450,16 +1062,17 @@ OS_TaskDelete (OS_PRIO prio)
 
     OS_CRTICAL_BEGIN();
 
-    ptcb = OS_tblTCBPrio[prio];
+    ptcb = OS_TCB_PrioGet(prio);
 
-    if(ptcb == OS_NULL(OS_TASK_TCB) || ptcb->TASK_Stat == OS_TASK_STAT_DELETED)   /* Task must exist.                           */
+    if(ptcb == OS_NULL(OS_TASK_TCB) || ptcb == OS_TCB_MUTEX_RESERVED ||
+       ptcb->TASK_Stat == OS_TASK_STAT_DELETED)                                   /* Task must exist.                           */
     {
         OS_CRTICAL_END();
         OS_ERR_SET(OS_ERR_TASK_NOT_EXIST);
         return (OS_ERR_TASK_NOT_EXIST);
     }
 
-    OS_RemoveReady(prio);                                                         /* Remove the task from ready state.          */
+    OS_RemoveReady(ptcb);                                                         /* Remove the task from ready state.          */
 
 #if (OS_AUTO_CONFIG_INCLUDE_EVENTS == OS_CONFIG_ENABLE)
 
@@ -472,7 +1085,7 @@ OS_TaskDelete (OS_PRIO prio)
 
     if(ptcb->TASK_Stat & OS_TASK_STAT_DELAY)                                      /* If it's waiting due to a delay             */
     {
-        OS_UnBlockTime(prio);                                                     /* Remove from the time blocked state.        */
+        OS_UnBlockTime(ptcb);                                                     /* Remove from the time blocked state.        */
     }
 
     ptcb->TASK_Ticks    = 0U;                                                     /* Remove any remaining ticks.                */
@@ -485,13 +1098,17 @@ OS_TaskDelete (OS_PRIO prio)
 
     ptcb->TASK_Stat     = OS_TASK_STAT_DELETED;                                   /* Make the task be Dormant.                  */
 
+#if (OS_CONFIG_TASK_ADMISSION_EN == OS_CONFIG_ENABLE)
+    OS_TaskUtilSum     -= ptcb->TASK_Util;                                        /* Its share of the CPU is free for new tasks.*/
+#endif
+
+#if (OS_CONFIG_ROUND_ROBIN_EN == OS_CONFIG_ENABLE)
+    OS_TCB_PrioRemove(ptcb, prio);                                                /* The task is no longer exist. 				*/
+#else
     OS_tblTCBPrio[prio] = OS_NULL(OS_TASK_TCB);                                   /* The task is no longer exist. 				*/
+#endif
 
     /* At this point, the task is prevented from resuming or made ready from another higher task or an ISR.                     */
-    if(OS_TRUE == OS_Running)
-    {
-        OS_Sched();                                                               /* Schedule a new higher priority task.       */
-    }
 
 #if(OS_CONFIG_CPU_TASK_DELETED == OS_CONFIG_ENABLE)
     OS_CPU_Hook_TaskDeleted (ptcb);												  /* Call port specific task deletion code.		*/
@@ -503,6 +1120,14 @@ OS_TaskDelete (OS_PRIO prio)
 
     OS_TCB_free(ptcb);															  /* Return the TCB object to the Tasks pool.	*/
 
+    if(OS_TRUE == OS_Running)
+    {
+        OS_Sched();                                                               /* Schedule a new higher priority task. The
+                                                                                     TCB is freed first, Since a port which
+                                                                                     switches at once never returns here if
+                                                                                     the task deleted itself.                   */
+    }
+
     OS_CRTICAL_END();
 
     OS_ERR_SET(OS_ERR_NONE);
@@ -552,28 +1177,34 @@ OS_TaskChangePriority (OS_PRIO oldPrio, OS_PRIO newPrio)
 
     OS_CRTICAL_BEGIN();
 
-    if(OS_tblTCBPrio[oldPrio] == OS_NULL(OS_TASK_TCB))                       /* Check that the old task is Created.          */
+    ptcb   = OS_TCB_PrioGet(oldPrio);                                      /* Store a pointer to TCB entry at old priority.  */
+
+    if(ptcb == OS_NULL(OS_TASK_TCB))                                       /* Check that the old task is Created.          */
     {
         OS_CRTICAL_END();
         OS_ERR_SET(OS_ERR_TASK_NOT_EXIST);
         return OS_ERR_TASK_NOT_EXIST;
     }
 
-    if(OS_tblTCBPrio[oldPrio] == OS_TCB_MUTEX_RESERVED)
+    if(ptcb == OS_TCB_MUTEX_RESERVED)
     {
         OS_CRTICAL_END();                                                  /* old prio should not be reserved for a mutex.   */
         OS_ERR_SET(OS_ERR_TASK_NOT_EXIST);
         return OS_ERR_TASK_NOT_EXIST;
     }
 
-    if(OS_tblTCBPrio[oldPrio]->TASK_Stat == OS_TASK_STAT_DELETED)          /* Be dummy in the checks !                       */
+    if(ptcb->TASK_Stat == OS_TASK_STAT_DELETED)                            /* Be dummy in the checks !                       */
     {
         OS_CRTICAL_END();
         OS_ERR_SET(OS_ERR_TASK_NOT_EXIST);
         return OS_ERR_TASK_NOT_EXIST;
     }
 
+#if (OS_CONFIG_ROUND_ROBIN_EN == OS_CONFIG_ENABLE)
+    if(OS_tblTCBPrio[newPrio] == OS_TCB_MUTEX_RESERVED)                    /* The new priority can be shared but not with a mutex. */
+#else
     if(OS_tblTCBPrio[newPrio] != OS_NULL(OS_TASK_TCB))                      /* The new priority must be available.           */
+#endif
     {
         OS_CRTICAL_END();
         OS_ERR_SET(OS_ERR_TASK_CREATE_EXIST);
@@ -587,8 +1218,6 @@ OS_TaskChangePriority (OS_PRIO oldPrio, OS_PRIO newPrio)
         return OS_ERR_TASK_NOT_EXIST;
     }
 
-    ptcb   = OS_tblTCBPrio[oldPrio];                                       /* Store a pointer to TCB entry at old priority.  */
-
 #if (OS_AUTO_CONFIG_INCLUDE_EVENTS == OS_CONFIG_ENABLE)
 
     pevent = ptcb->TASK_Event;
@@ -597,17 +1226,12 @@ OS_TaskChangePriority (OS_PRIO oldPrio, OS_PRIO newPrio)
 
     if(ptcb->TASK_Stat == OS_TASK_STAT_READY)
     {
-        OS_RemoveReady(oldPrio);
-        OS_SetReady(newPrio);
+        OS_RemoveReady(ptcb);
+        ptcb->TASK_priority    = newPrio;
+        OS_SetReady(ptcb);
     }
     else
-    {
-        if(ptcb->TASK_Stat & OS_TASK_STAT_DELAY)
-        {
-            OS_UnBlockTime(oldPrio);
-            OS_BlockTime(newPrio);
-        }
-
+    {                                                                      /* A pending delay is kept, The delay list is not ordered by priority. */
 #if (OS_AUTO_CONFIG_INCLUDE_EVENTS == OS_CONFIG_ENABLE)
 
         if(ptcb->TASK_Event != OS_NULL(OS_EVENT))                          /* If old priority is waiting for an event.        */
@@ -615,7 +1239,7 @@ OS_TaskChangePriority (OS_PRIO oldPrio, OS_PRIO newPrio)
             OS_Event_TaskRemove(ptcb, pevent);                             /* ... Remove at the old priority.                 */
 
             ptcb->TASK_priority    = newPrio;
-            OS_Event_TaskInsert(OS_tblTCBPrio[newPrio], pevent);           /* ... Place event at the new priority.            */
+            OS_Event_TaskInsert(ptcb, pevent);                             /* ... Place event at the new priority.            */
         }
 
 #endif
@@ -623,8 +1247,13 @@ OS_TaskChangePriority (OS_PRIO oldPrio, OS_PRIO newPrio)
     }
 
     ptcb->TASK_priority    = newPrio;                                      /* Store new priority in TCB entry.                */
+#if (OS_CONFIG_ROUND_ROBIN_EN == OS_CONFIG_ENABLE)
+    OS_TCB_PrioRemove(ptcb, oldPrio);                                      /* Unlink from the tasks of the old priority...    */
+    OS_TCB_PrioInsert(ptcb, newPrio);                                      /* ... Link to the tasks of the new priority.      */
+#else
     OS_tblTCBPrio[oldPrio] = OS_NULL(OS_TASK_TCB);                         /* Unlink old priority pointer to TCB entry...     */
     OS_tblTCBPrio[newPrio] = ptcb;                                         /* ... Link to the new priority.                   */
+#endif
 
     OS_CRTICAL_END();
 
@@ -673,9 +1302,9 @@ OS_TaskSuspend (OS_PRIO prio)
             selfTask = OS_FAlSE;
         }
 
-        thisTask = OS_tblTCBPrio[prio];
+        thisTask = OS_TCB_PrioGet(prio);
 
-        if(thisTask == OS_NULL(OS_TASK_TCB) ||
+        if(thisTask == OS_NULL(OS_TASK_TCB) || thisTask == OS_TCB_MUTEX_RESERVED ||
           thisTask->TASK_Stat == OS_TASK_STAT_DELETED)     /* Check that the suspended task is actually exist.                         */
         {
             OS_CRTICAL_END();
@@ -692,7 +1321,7 @@ OS_TaskSuspend (OS_PRIO prio)
 
         thisTask->TASK_Stat |= OS_TASK_STAT_SUSPENDED;
 
-        OS_RemoveReady(prio);
+        OS_RemoveReady(thisTask);
 
         OS_CRTICAL_END();
 
@@ -734,16 +1363,27 @@ OS_TaskResume (OS_PRIO prio)
     {
         OS_CRTICAL_BEGIN();
 
+#if (OS_CONFIG_ROUND_ROBIN_EN == OS_CONFIG_ENABLE)
+        thisTask = OS_tblTCBPrio[prio];                                             /* Resume the first suspended task of this priority.                          */
+        while(thisTask != OS_NULL(OS_TASK_TCB) && thisTask != OS_TCB_MUTEX_RESERVED &&
+             (thisTask->TASK_Stat & OS_TASK_STAT_SUSPENDED) == OS_TASK_STAT_READY)
+        {
+            thisTask = thisTask->OSTCB_PrioNextPtr;
+        }
+
+        if(thisTask == OS_currentTask)                                              /* Resume self !                                                              */
+#else
+        thisTask = OS_tblTCBPrio[prio];
+
         if(prio == OS_currentTask->TASK_priority)                                   /* Resume self !                                                              */
+#endif
         {
             OS_CRTICAL_END();
             OS_ERR_SET(OS_ERR_TASK_RESUME_PRIO);
             return (OS_ERR_TASK_RESUME_PRIO);
         }
 
-        thisTask = OS_tblTCBPrio[prio];
-
-        if(thisTask == OS_NULL(OS_TASK_TCB) ||
+        if(thisTask == OS_NULL(OS_TASK_TCB) || thisTask == OS_TCB_MUTEX_RESERVED ||
           thisTask->TASK_Stat == OS_TASK_STAT_DELETED)                              /* Check that the resumed task is actually exist.                             */
         {
             OS_CRTICAL_END();
@@ -756,10 +1396,9 @@ OS_TaskResume (OS_PRIO prio)
             thisTask->TASK_Stat &= ~(OS_TASK_STAT_SUSPENDED);                       /* Clear the suspend state.                                                   */
            if((thisTask->TASK_Stat & OS_TASK_STATE_PEND_ANY) == OS_TASK_STAT_READY) /* If it's not pending on any events ... */
            {
-               if(thisTask->TASK_Ticks == 0U)                                       /* If it's not waiting a delay ...                                            */
+               if((thisTask->TASK_Stat & OS_TASK_STAT_DELAY) == 0U)                 /* If it's not waiting a delay ...                                            */
                {
-                   OS_SetReady(prio);
-                   OS_CRTICAL_END();
+                   OS_SetReady(thisTask);
                    if(OS_TRUE == OS_Running)
                    {
                        OS_Sched();                                                  /* Call the scheduler, it may be a higher priority task.                      */
@@ -788,12 +1427,14 @@ OS_TaskResume (OS_PRIO prio)
 OS_STATUS inline
 OS_TaskStatus (OS_PRIO prio)
 {
-	if(OS_tblTCBPrio[prio] == OS_NULL(OS_TASK_TCB))
+	OS_TASK_TCB* ptcb = OS_TCB_PrioGet(prio);
+
+	if(ptcb == OS_NULL(OS_TASK_TCB) || ptcb == OS_TCB_MUTEX_RESERVED)
 	{
 		return OS_TASK_STAT_DELETED;
 	}
 
-	return OS_tblTCBPrio[prio]->TASK_Stat;
+	return ptcb->TASK_Stat;
 }
 
 /*
@@ -820,6 +1461,221 @@ OS_TaskRunningPriorityGet (void)
 	return (running_prio);
 }
 
+#if (OS_CONFIG_ROUND_ROBIN_EN == OS_CONFIG_ENABLE)
+
+/*
+ * Function:  OS_TaskYield
+ * --------------------
+ * Give up the rest of the current task time quanta to the next ready task of the same priority.
+ *
+ * Arguments    :   None.
+ *
+ * Returns      :   None.
+ *
+ * Note(s)		:	1) The calling task is moved to the tail of its priority ready queue and continues
+ * 					   to run if there is no other ready task of the same priority.
+ * 					2) This function must be called from a task code.
+ */
+void
+OS_TaskYield (void)
+{
+	CPU_SR_ALLOC();
+
+	if(OS_IntNestingLvl > 0U)								/* Don't yield from an ISR.									*/
+	{
+		return;
+	}
+
+	OS_CRTICAL_BEGIN();
+
+	if(OS_currentTask->OSTCB_ReadyNextPtr != OS_NULL(OS_TASK_TCB) &&
+	   OS_currentTask->OSTCB_ReadyNextPtr != OS_currentTask)	/* Other tasks are ready at the same priority ?				*/
+	{
+		OS_RemoveReady(OS_currentTask);						/* Move to the tail of its ready queue.						*/
+		OS_SetReady(OS_currentTask);
+	}
+
+	OS_currentTask->TASK_TimeQuantaCtr = OS_currentTask->TASK_TimeQuanta;	/* A full time quanta on its next turn.		*/
+
+	OS_CRTICAL_END();
+
+	OS_Sched();
+}
+
+/*
+ * Function:  OS_TaskTimeQuantaSet
+ * --------------------
+ * Set the time quanta of a task which shares its priority with other tasks.
+ *
+ * Arguments    :   prio    is the task priority. The calling task if it runs at this priority, Otherwise the first
+ * 							created task of this priority.
+ * 					quanta	is the number of ticks the task runs before the next ready task of the same priority.
+ * 							0 means no time slicing, The task runs until it blocks or yields.
+ *
+ * Returns      :   OS_ERR_NONE, OS_ERR_PRIO_INVALID, OS_ERR_TASK_NOT_EXIST
+ */
+OS_tRet
+OS_TaskTimeQuantaSet (OS_PRIO prio, OS_TICK quanta)
+{
+	OS_TASK_TCB* ptcb;
+	CPU_SR_ALLOC();
+
+	if(!OS_IS_VALID_PRIO(prio))
+	{
+		OS_ERR_SET(OS_ERR_PRIO_INVALID);
+		return (OS_ERR_PRIO_INVALID);
+	}
+
+	OS_CRTICAL_BEGIN();
+
+	ptcb = OS_TCB_PrioGet(prio);
+
+	if(ptcb == OS_NULL(OS_TASK_TCB) || ptcb == OS_TCB_MUTEX_RESERVED)
+	{
+		OS_CRTICAL_END();
+		OS_ERR_SET(OS_ERR_TASK_NOT_EXIST);
+		return (OS_ERR_TASK_NOT_EXIST);
+	}
+
+	ptcb->TASK_TimeQuanta    = quanta;
+	ptcb->TASK_TimeQuantaCtr = quanta;
+
+	OS_CRTICAL_END();
+
+	OS_ERR_SET(OS_ERR_NONE);
+	return (OS_ERR_NONE);
+}
+
+#endif
+
+#endif
+
+#if (OS_CONFIG_TASK_STACK_USAGE_EN == OS_CONFIG_ENABLE)
+
+/*
+ * Function:  OS_TaskStackUsageGet
+ * --------------------
+ * Get the stack high-water mark of a task.
+ *
+ * Arguments    :   prio    is the task priority.
+ *                          With the EDF scheduler, It's the task creation order (i.e 0 is the Idle task, Followed by
+ *                          the statistics task if enabled, Then the application tasks).
+ *                  pused   is a pointer to be filled with the used bytes of the task stack.
+ *                  pfree   is a pointer to be filled with the never used bytes of the task stack.
+ *
+ * Returns      :   OS_ERR_NONE, OS_ERR_PARAM, OS_ERR_PRIO_INVALID, OS_ERR_TASK_NOT_EXIST
+ *
+ * Notes        :   1) Only the words which were painted at the previous scan are checked, Interrupts are disabled
+ *                     during the scan.
+ *                  2) With Round Robin, The calling task is used if it runs at this priority,
+ *                     Otherwise the first created task of this priority.
+ */
+OS_tRet
+OS_TaskStackUsageGet (OS_PRIO prio, CPU_tSTK_SIZE* pused, CPU_tSTK_SIZE* pfree)
+{
+	OS_TASK_TCB* ptcb;
+	CPU_SR_ALLOC();
+
+	if(pused == OS_NULL(CPU_tSTK_SIZE) || pfree == OS_NULL(CPU_tSTK_SIZE))
+	{
+		OS_ERR_SET(OS_ERR_PARAM);
+		return (OS_ERR_PARAM);
+	}
+
+	if(prio >= OS_CONFIG_TASK_COUNT)
+	{
+		OS_ERR_SET(OS_ERR_PRIO_INVALID);
+		return (OS_ERR_PRIO_INVALID);
+	}
+
+	OS_CRTICAL_BEGIN();
+
+#if(OS_CONFIG_EDF_EN == OS_CONFIG_DISABLE)
+	ptcb = OS_TCB_PrioGet(prio);
+#else
+	ptcb = OS_tblTCBPrio[prio];
+#endif
+	if(ptcb == OS_NULL(OS_TASK_TCB) || ptcb == OS_TCB_MUTEX_RESERVED)
+	{
+		OS_CRTICAL_END();
+		OS_ERR_SET(OS_ERR_TASK_NOT_EXIST);
+		return (OS_ERR_TASK_NOT_EXIST);
+	}
+
+	ptcb->TASK_StkFreeWords = OS_TaskStackFreeScan(ptcb, 0U, ptcb->TASK_StkFreeWords);
+	if(ptcb->TASK_StkScanIdx > ptcb->TASK_StkFreeWords)
+	{
+		ptcb->TASK_StkScanIdx = 0U;
+	}
+
+	*pfree = ptcb->TASK_StkFreeWords * sizeof(CPU_tSTK);
+	*pused = (ptcb->TASK_StkUsageWords - ptcb->TASK_StkFreeWords) * sizeof(CPU_tSTK);
+
+	OS_CRTICAL_END();
+
+	OS_ERR_SET(OS_ERR_NONE);
+	return (OS_ERR_NONE);
+}
+
+#if (OS_CONFIG_TASK_STACK_SCAN_WORDS > 0U)
+
+/*
+ * Function:  OS_TaskStackScan
+ * --------------------
+ * Refresh the stack high-water marks in the background, A few words per call.
+ *
+ * Arguments    :   None.
+ *
+ * Returns      :   None.
+ *
+ * Notes        :   1) Called by the idle task every loop, Up to OS_CONFIG_TASK_STACK_SCAN_WORDS words of one task are
+ *                     checked with interrupts disabled, Then the scan moves to the next task of the TCB pool.
+ */
+void
+OS_TaskStackScan (void)
+{
+	static CPU_t32U OS_TaskStackScanNext;
+	OS_TASK_TCB*    ptcb;
+	CPU_tSTK_SIZE   end;
+	CPU_tSTK_SIZE   idx;
+	CPU_SR_ALLOC();
+
+	OS_CRTICAL_BEGIN();
+
+	ptcb = &OS_TblTask[OS_TaskStackScanNext];
+
+	if(ptcb->TASK_Stat != OS_TASK_STAT_DELETED)
+	{
+		end = ptcb->TASK_StkScanIdx + OS_CONFIG_TASK_STACK_SCAN_WORDS;
+		if(end > ptcb->TASK_StkFreeWords)
+		{
+			end = ptcb->TASK_StkFreeWords;
+		}
+
+		idx = OS_TaskStackFreeScan(ptcb, ptcb->TASK_StkScanIdx, end);
+
+		if(idx < end)								/* The task has used its stack deeper.				*/
+		{
+			ptcb->TASK_StkFreeWords = idx;
+		}
+
+		if(idx < ptcb->TASK_StkFreeWords)			/* Not yet the end of the painted words.			*/
+		{
+			ptcb->TASK_StkScanIdx = idx;
+			OS_CRTICAL_END();
+			return;
+		}
+
+		ptcb->TASK_StkScanIdx = 0U;
+	}
+
+	OS_TaskStackScanNext = (OS_TaskStackScanNext + 1U) % OS_CONFIG_TASK_COUNT;
+
+	OS_CRTICAL_END();
+}
+
+#endif
+
 #endif
 
 /*
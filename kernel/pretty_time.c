@@ -77,8 +77,8 @@ OS_DelayTicks (OS_TICK ticks)
         OS_currentTask->TASK_Ticks = ticks;
         OS_currentTask->TASK_Stat |= OS_TASK_STAT_DELAY;
 
-        OS_RemoveReady(OS_currentTask->TASK_priority);
-        OS_BlockTime(OS_currentTask->TASK_priority);
+        OS_RemoveReady(OS_currentTask);
+        OS_BlockTime(OS_currentTask);
 
         OS_Sched();                                             /* Preempt Another Task.                        */
     }
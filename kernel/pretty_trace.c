@@ -0,0 +1,249 @@
+/*****************************************************************************
+MIT License
+
+Copyright (c) 2020 Yahia Farghaly Ashour
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+/*
+ * Author   : 	Yahia Farghaly Ashour
+ *
+ * Purpose  :	Implementation of the trace recorder of the kernel events in prettyOS.
+ *
+ *              The kernel writes a fixed size binary record for each event in a ring buffer, The oldest records are
+ *              overwritten. A record holds the time since the previous record, So the absolute times are rebuilt
+ *              backwards from the time of the newest record which is returned by OS_TraceDump().
+ *
+ *              A record is written with interrupts disabled by its caller, So on a single core there is no
+ *              concurrent writer and the write is a few stores without any loop or lock (i.e wait-free).
+ *
+ * Language	:  	C
+ *
+ * Set 1 tab = 4 spaces for better comments readability.
+ */
+
+/*
+*******************************************************************************
+*                               Includes Files                                *
+*******************************************************************************
+*/
+#include "pretty_os.h"
+#include "pretty_shared.h"
+
+#if (OS_CONFIG_TRACE_EN == OS_CONFIG_ENABLE)
+
+#if ((OS_CONFIG_TRACE_RECORDS & (OS_CONFIG_TRACE_RECORDS - 1U)) != 0U) || (OS_CONFIG_TRACE_RECORDS == 0U)
+	#error "OS_CONFIG_TRACE_RECORDS is required to be a power of 2"
+#endif
+
+/*
+*******************************************************************************
+*                               Local Macros                                  *
+*******************************************************************************
+*/
+
+#define OS_TRACE_INDEX_MASK		(OS_CONFIG_TRACE_RECORDS - 1U)
+
+/*
+*******************************************************************************
+*                               Local Variables                               *
+*******************************************************************************
+*/
+
+static OS_TRACE_RECORD		OS_TraceBuffer [OS_CONFIG_TRACE_RECORDS];
+
+static CPU_t32U				OS_TraceCount;			/* The number of the written records, The next record is at (count & mask).	*/
+static CPU_t64U				OS_TraceLastStamp;		/* The time of the newest record.											*/
+static OS_BOOLEAN volatile	OS_TraceOn;				/* The recording is started.												*/
+
+/*
+*******************************************************************************
+*                                                                             *
+*                           PrettyOS Trace Functions                          *
+*                                                                             *
+*******************************************************************************
+*/
+
+/*
+ * Function:  OS_TraceInit
+ * --------------------
+ * Clear the trace buffer and start the recording.
+ *
+ * Arguments    :   None.
+ *
+ * Returns      :   None.
+ *
+ * Notes        :   1) This function is internal to PrettyOS functions, Called by OS_Init().
+ */
+void
+OS_TraceInit (void)
+{
+	OS_TraceCount     = 0U;
+	OS_TraceLastStamp = 0U;
+	OS_TraceOn        = OS_TRUE;
+}
+
+/*
+ * Function:  OS_TraceRecord
+ * --------------------
+ * Write a record of a kernel event in the trace buffer.
+ *
+ * Arguments    :   event   is one of OS_TRACE_EV_xxx.
+ *
+ *                  ptcb    is a pointer to the TCB of the task related to the event, Or OS_NULL(OS_TASK_TCB).
+ *
+ *                  pObj    is a pointer to the kernel object of the event, Or OS_NULL(void).
+ *
+ * Returns      :   None.
+ *
+ * Notes        :   1) Interrupts are assumed to be disabled.
+ *                  2) The time delta is saturated to 0xFFFFFFFF, i.e a gap longer than that (~4.3 seconds in the POSIX
+ *                     port, the same number of CPU cycles in the ARM Cortex-M4 port) isn't accurate.
+ *                     The delta of the oldest record is meaningless.
+ *                  3) Use OS_TRACE() in the kernel code, It expands to nothing if OS_CONFIG_TRACE_EN is disabled.
+ */
+void
+OS_TraceRecord (CPU_t08U event, OS_TASK_TCB* ptcb, void* pObj)
+{
+	OS_TRACE_RECORD* prec;
+	CPU_t64U         now;
+	CPU_t64U         delta;
+
+	if(OS_TraceOn == OS_FAlSE)
+	{
+		return;
+	}
+
+	now               = OS_CPU_TimestampGet();
+	delta             = now - OS_TraceLastStamp;
+	OS_TraceLastStamp = now;
+
+	prec = &OS_TraceBuffer[OS_TraceCount & OS_TRACE_INDEX_MASK];
+	++OS_TraceCount;
+
+	prec->tsDelta    = (delta > 0xFFFFFFFFU) ? 0xFFFFFFFFU : (CPU_t32U)delta;
+	prec->event      = event;
+	prec->intNesting = OS_IntNestingLvl;
+	prec->pObj       = pObj;
+
+	if(ptcb == OS_NULL(OS_TASK_TCB) || ptcb == OS_TCB_MUTEX_RESERVED)
+	{
+		prec->task = OS_TRACE_TASK_NONE;
+	}
+	else
+	{
+#if(OS_CONFIG_EDF_EN == OS_CONFIG_ENABLE)
+		prec->task = (CPU_t16U)(ptcb->pListItemOwner - OS_TCBList);	/* The creation order.							*/
+#else
+		prec->task = (CPU_t16U)ptcb->TASK_priority;
+#endif
+	}
+}
+
+/*
+ * Function:  OS_TraceStart
+ * --------------------
+ * Clear the trace buffer and restart the recording.
+ *
+ * Arguments    :   None.
+ *
+ * Returns      :   None.
+ */
+void
+OS_TraceStart (void)
+{
+	CPU_SR_ALLOC();
+
+	OS_CRTICAL_BEGIN();
+	OS_TraceInit();
+	OS_CRTICAL_END();
+}
+
+/*
+ * Function:  OS_TraceStop
+ * --------------------
+ * Stop the recording, The records are kept till the next OS_TraceStart().
+ *
+ * Arguments    :   None.
+ *
+ * Returns      :   None.
+ */
+void
+OS_TraceStop (void)
+{
+	OS_TraceOn = OS_FAlSE;
+}
+
+/*
+ * Function:  OS_TraceDump
+ * --------------------
+ * Copy the newest records of the trace buffer from the oldest to the newest.
+ *
+ * Arguments    :   pRecords    is a pointer to an array of 'count' records to be filled.
+ *
+ *                  count       is the max. number of records to copy.
+ *
+ *                  pStamp      is a pointer to be filled with the time of the newest record in OS_CPU_TimestampGet()
+ *                              units. The time of a record i is the time of the record i+1 minus the delta of i+1.
+ *
+ * Returns      :   The number of the copied records.
+ *
+ *                  OS_ERRNO = { OS_ERR_NONE, OS_ERR_PARAM }
+ *
+ * Notes        :   1) Interrupts are disabled while copying.
+ *                  2) Call OS_TraceStop() first to keep the records of interest from being overwritten.
+ */
+CPU_t32U
+OS_TraceDump (OS_TRACE_RECORD* pRecords, CPU_t32U count, CPU_t64U* pStamp)
+{
+	CPU_t32U first;
+	CPU_t32U idx;
+	CPU_SR_ALLOC();
+
+	if(pRecords == OS_NULL(OS_TRACE_RECORD) || pStamp == OS_NULL(CPU_t64U))
+	{
+		OS_ERR_SET(OS_ERR_PARAM);
+		return (0U);
+	}
+
+	OS_CRTICAL_BEGIN();
+
+	if(count > OS_TraceCount)
+	{
+		count = OS_TraceCount;
+	}
+	if(count > OS_CONFIG_TRACE_RECORDS)
+	{
+		count = OS_CONFIG_TRACE_RECORDS;
+	}
+
+	first = OS_TraceCount - count;
+	for(idx = 0U; idx < count; ++idx)
+	{
+		pRecords[idx] = OS_TraceBuffer[(first + idx) & OS_TRACE_INDEX_MASK];
+	}
+	*pStamp = OS_TraceLastStamp;
+
+	OS_CRTICAL_END();
+
+	OS_ERR_SET(OS_ERR_NONE);
+	return (count);
+}
+
+#endif
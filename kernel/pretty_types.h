@@ -116,6 +116,9 @@ typedef struct LIST_ITEM
   void * pList;                    		/* Pointer to the list in which this list item is placed (if any). 				*/
   struct LIST_ITEM * next;     			/* Pointer to the next 		ListItem in the list.  								*/
   struct LIST_ITEM * prev;   			/* Pointer to the previous 	ListItem in the list. 								*/
+#if (OS_CONFIG_LIST_HEAP_EN == OS_CONFIG_ENABLE)
+  CPU_tWORD heapIdx;					/* The position of the list item in the heap array of its list.					*/
+#endif
 }List_Item;
 
 typedef struct LIST
@@ -123,6 +126,9 @@ typedef struct LIST
   List_Item* head;						/* The head of the list item linked list.										*/
   List_Item* end;						/* The tail of the list item linked list.										*/
   CPU_tWORD  itemsCnt;					/* The Number of Items in the list items.										*/
+#if (OS_CONFIG_LIST_HEAP_EN == OS_CONFIG_ENABLE)
+  List_Item* heap [OS_CONFIG_TASK_COUNT];/* A binary min-heap of the list items, The head is heap[0].					*/
+#endif
 } List;
 
 /* ---------------------- OS EDF Scheduler Params --------------------------- */
@@ -136,6 +142,17 @@ struct os_edf_sched_params
 	OS_OPT	task_type;					/* The task type ( OS_TASK_[PERIODIC/SPORADIC/APERIODIC]						*/
 	OS_TICK task_period;				/* The task periodicity in Ticks if it's periodic task.							*/
 	OS_BOOLEAN task_yield;				/* A True/False value for indicating that this Task should be yielding the CPU. */
+	OS_BOOLEAN task_started;			/* OS_TRUE once the current job is dispatched, Started jobs are not blocked by the SRP ceiling. */
+	OS_TICK server_budget;				/* The budget (Qs) of the Constant Bandwidth Server of a sporadic/aperiodic task.	*/
+	OS_TICK server_budget_left;			/* The remaining budget (Cs) of the server for its current deadline.			*/
+#if (OS_CONFIG_TASK_BUDGET_EN == OS_CONFIG_ENABLE)
+	OS_OPT	task_overrun;				/* The overrun policy of the task jobs ( OS_TASK_OVERRUN_[NOTIFY/DEMOTE/SKIP/ABORT] ).	*/
+	OS_OPT	job_overrun;				/* The overrun policy applied to the current job, OS_TASK_OVERRUN_NONE if it has not overrun.	*/
+	OS_TICK job_budget_left;			/* The remaining execution budget of the current periodic job.					*/
+	CPU_t32U job_overruns;				/* Number of the task jobs which ran out of their budget.						*/
+	CPU_t32U job_misses;				/* Number of the task jobs which completed after their deadline.				*/
+	CPU_t08U job_mutexes;				/* Number of the mutexes owned by the task, An overrun job which owns one is not aborted.	*/
+#endif
 };
 
 /* ------------------------ OS Task TCB Structure --------------------------- */
@@ -149,12 +166,48 @@ struct os_task_tcb
     OS_TASK_TCB* OSTCB_NextPtr;      		/* Pointer to a TCB, In case of multiple TCBs pending on the same event object.	*/
     OS_STATUS   TASK_Stat;      			/* Task Status 																	*/
 
+    OS_TICK     TASK_Ticks;     			/* Current Task's timeout, Relative to the previous TCB in the delay list.		*/
+    OS_TASK_TCB* OSTCB_DelayNextPtr;		/* Pointer to the next 	   TCB in the delay list (Sorted by expiry time).		*/
+    OS_TASK_TCB* OSTCB_DelayPrevPtr;		/* Pointer to the previous TCB in the delay list.								*/
+
 #if (OS_CONFIG_EDF_EN == OS_CONFIG_ENABLE)
     OS_EDF_SCHED_PARAMS	EDF_params;
     List_Item* 			pListItemOwner;
 #else
     OS_PRIO     TASK_priority;  			/* Task Priority																*/
-    OS_TICK     TASK_Ticks;     			/* Current Task's timeout    													*/
+
+#if (OS_CONFIG_ROUND_ROBIN_EN 			== OS_CONFIG_ENABLE)
+    OS_TASK_TCB* OSTCB_ReadyNextPtr;		/* Pointer to the next 	   TCB in the ready queue, NULL if it's not ready.		*/
+    OS_TASK_TCB* OSTCB_ReadyPrevPtr;		/* Pointer to the previous TCB in the ready queue (Circular).					*/
+    OS_TASK_TCB* OSTCB_PrioNextPtr;			/* Pointer to the next TCB created at the same priority.						*/
+    OS_TICK     TASK_TimeQuanta;			/* Task's time slice in ticks, 0 means no time slicing.							*/
+    OS_TICK     TASK_TimeQuantaCtr;			/* Remaining ticks of the current time slice.									*/
+#endif
+#endif
+
+#if (OS_AUTO_CONFIG_TASK_WCET 			== OS_CONFIG_ENABLE)
+    OS_TICK     TASK_WCET;					/* Worst case execution time of a job in ticks, 0 => Not accounted.				*/
+#endif
+
+#if (OS_CONFIG_TASK_BUDGET_EN 			== OS_CONFIG_ENABLE)
+    CPU_tSTK*   	TASK_StkBase;			/* The task stack, An aborted job restarts on a new stack frame.				*/
+    CPU_tSTK_SIZE	TASK_StkSize;
+#endif
+
+#if (OS_CONFIG_TASK_ADMISSION_EN 		== OS_CONFIG_ENABLE)
+    CPU_t32U    TASK_Util;					/* Admitted share of the CPU in 1/OS_UTIL_ONE units.							*/
+#if (OS_CONFIG_EDF_EN 					== OS_CONFIG_DISABLE)
+    OS_TICK     TASK_Period;				/* Period (and relative deadline) of the task jobs in ticks.					*/
+#endif
+#endif
+
+#if (OS_CONFIG_TASK_RUNTIME_EN 			== OS_CONFIG_ENABLE)
+    CPU_t64U    TASK_Runtime;				/* CPU time consumed by the task in units of the port timestamp.				*/
+#endif
+
+#if (OS_CONFIG_TASK_LATENCY_EN 			== OS_CONFIG_ENABLE)
+    CPU_t64U    TASK_ReadyStamp;			/* The port timestamp when the task was made ready, 0 => Not waiting the CPU.	*/
+    CPU_t32U    TASK_LatencyHist [OS_CONFIG_TASK_LATENCY_BUCKETS];	/* Counts of the ready to running latencies.			*/
 #endif
 
 
@@ -162,6 +215,13 @@ struct os_task_tcb
     void*       TASK_SP_Limit;              /* Task's stack pointer limit to for stack overflow detection.                  */
 #endif
 
+#if (OS_CONFIG_TASK_STACK_USAGE_EN 		== OS_CONFIG_ENABLE)
+    CPU_tSTK*   	TASK_StkUsageBase;		/* The measured stack, The port may move it to the stack the task runs on.		*/
+    CPU_tSTK_SIZE	TASK_StkUsageWords;		/* Size of the measured stack in CPU_tSTK words.								*/
+    CPU_tSTK_SIZE	TASK_StkFreeWords;		/* Painted words left at its far end as of the last scan (never used).			*/
+    CPU_tSTK_SIZE	TASK_StkScanIdx;		/* The next word from the far end to be checked by the idle task.				*/
+#endif
+
 
 #if (OS_AUTO_CONFIG_INCLUDE_EVENTS 		== OS_CONFIG_ENABLE)
     OS_STATUS   TASK_PendStat;  			/* Task Pend Status 															*/
@@ -200,6 +260,15 @@ struct os_task_event
 
     union{
         OS_SEM_COUNT    OSEventCount;       /* Semaphore Count                                                    			*/
+#if (OS_CONFIG_EDF_EN == OS_CONFIG_ENABLE)
+        struct{
+            OS_TICK    OSMutexCeil;         /* The preemption ceiling of the Mutex for the Stack Resource Policy, It's the
+            									shortest relative deadline of the tasks using the Mutex.
+            									or 'OS_TICK_INFINITE' if the ceiling is disabled.							*/
+
+            OS_TICK    OSMutexCeilPrev;     /* The system ceiling before the Mutex was locked, Restored when it's released. */
+        };
+#else
         struct{
             OS_PRIO    OSMutexPrio;         /* The original priority task that owning the Mutex.
             									or 'OS_PRIO_RESERVED_MUTEX' if no task is owning the Mutex.                 */
@@ -207,6 +276,7 @@ struct os_task_event
             OS_PRIO    OSMutexPrioCeilP;    /* The raised priority to reduce the priority inversion bug.
             								 	 or 'OS_PRIO_RESERVED_MUTEX' if priority ceiling promotion is disabled.		*/
         };
+#endif
     };
 };
 
@@ -261,6 +331,18 @@ struct os_task_time
     CPU_t16U milliseconds;
 };
 
+/* --------------------------- OS Trace Record ----------------------------- */
+
+typedef struct os_trace_record     			OS_TRACE_RECORD;
+struct os_trace_record
+{
+    CPU_t32U		tsDelta;				/* Time since the previous record in OS_CPU_TimestampGet() units (Saturated).	*/
+    CPU_t16U		task;					/* Priority (Or creation order in EDF) of the task, OS_TRACE_TASK_NONE if any.	*/
+    CPU_t08U		event;					/* One of OS_TRACE_EV_xxx.														*/
+    CPU_t08U		intNesting;				/* The ISR nesting level at the event, 0 at task level.							*/
+    void*			pObj;					/* The kernel object of the event, OS_NULL(void) if any.						*/
+};
+
 #ifdef __cplusplus
 }
 #endif
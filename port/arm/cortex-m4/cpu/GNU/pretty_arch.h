@@ -412,6 +412,19 @@ void OS_CPU_SystemTimerHandler (void);
  */
 void  OS_CPU_SystemTimerSetup (CPU_t32U ticks);
 
+/*
+ * Function:  OS_CPU_TimestampGet
+ * --------------------
+ * Read a free-running high resolution counter which is used to account the tasks runtime.
+ *
+ * Arguments    :   None.
+ *
+ * Returns      :   The current counter value in CPU cycles (DWT cycle counter extended to 64-bit).
+ *
+ * Note(s)      :   1) Used by the kernel when OS_CONFIG_TASK_RUNTIME_EN, OS_CONFIG_TASK_LATENCY_EN or OS_CONFIG_TRACE_EN is enabled.
+ */
+CPU_t64U OS_CPU_TimestampGet (void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -59,6 +59,16 @@ typedef struct
 
 #define SysTick                   ((SysTick_Type*)(SYSTICK_BASE))
 
+/*  Data Watchpoint and Trace (DWT) cycle counter registers. */
+#define DWT_CTRL                  (*((volatile CPU_t32U*)0xE0001000U))
+#define DWT_CYCCNT                (*((volatile CPU_t32U*)0xE0001004U))
+#define DEMCR                     (*((volatile CPU_t32U*)0xE000EDFCU))
+#define DEMCR_TRCENA              (1U << 24U)
+#define DWT_CTRL_CYCCNTENA        (1U << 0U)
+
+static CPU_t32U CPU_CycleCountHigh;     /* Number of times the 32-bit cycle counter wrapped.            */
+static CPU_t32U CPU_CycleCountLast;     /* The last read cycle count, To detect a wrap.                 */
+
 /*
  * Function:  OS_CPU_TaskInit
  * --------------------
@@ -134,6 +144,8 @@ void OS_CPU_SystemTimerHandler  (void)
 
     OS_CRTICAL_END();
 
+    (void)OS_CPU_TimestampGet();    /* Keep track of the cycle counter wraps.   */
+
     OS_TimerTick();         /* Signal the tick to the OS_timerTick().       */
 
     OS_IntExit();           /* Notify that we are leaving the ISR.          */
@@ -160,6 +172,47 @@ void  OS_CPU_SystemTimerSetup (CPU_t32U ticks)
     SysTick->CTRL |= (0x02U);           /* Finally, Enable Interrupt generation when count reaches 0     */
 }
 
+/*
+ * Function:  OS_CPU_TimestampGet
+ * --------------------
+ * Read the DWT cycle counter, extended to 64-bit.
+ *
+ * Arguments    :   None.
+ *
+ * Returns      :   The number of CPU cycles since the first call.
+ *
+ * Note(s)      :   1) The counter is enabled on the first call.
+ *                  2) A wrap is detected only if it's read at least once every 2^32 cycles, Which is done by the
+ *                     kernel at every context switch and by the tick handler.
+ */
+CPU_t64U OS_CPU_TimestampGet (void)
+{
+    CPU_t32U  cnt;
+    CPU_t64U  ts;
+    CPU_SR_ALLOC();
+
+    OS_CRTICAL_BEGIN();
+
+    if((DWT_CTRL & DWT_CTRL_CYCCNTENA) == 0U)
+    {
+        DEMCR      |= DEMCR_TRCENA;     /* Enable the trace and debug blocks (i.e DWT).                  */
+        DWT_CYCCNT  = 0U;
+        DWT_CTRL   |= DWT_CTRL_CYCCNTENA;
+    }
+
+    cnt = DWT_CYCCNT;
+    if(cnt < CPU_CycleCountLast)        /* The counter has wrapped since the last read.                  */
+    {
+        ++CPU_CycleCountHigh;
+    }
+    CPU_CycleCountLast = cnt;
+    ts = ((CPU_t64U)CPU_CycleCountHigh << 32U) | cnt;
+
+    OS_CRTICAL_END();
+
+    return (ts);
+}
+
 /*
 *******************************************************************************
 *                           CPU Hook Functions                                *
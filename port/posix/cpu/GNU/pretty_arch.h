@@ -65,6 +65,10 @@ extern "C" {
 #define  CPU_ENDIAN_TYPE_BIG                        (1U)   /* Big-endian order, Store most significant byte in the lowest memory address.     */
 #define  CPU_ENDIAN_TYPE_LITTLE                     (2U)   /* Little-endian order, Store most significant byte in the highest memory address. */
 
+/*------------------------- POSIX Port Execution Engines ---------------------*/
+#define  CPU_POSIX_ENGINE_PTHREAD                   (1U)   /* Every task runs on its own host thread, Switched by a futex word per thread.    */
+#define  CPU_POSIX_ENGINE_UCONTEXT                  (2U)   /* All the tasks run on one host thread, Switched in user space on their stacks.  */
+
 
 /*
 *******************************************************************************
@@ -116,14 +120,38 @@ typedef void*               CPU_tPtr;                    /* Pointer Type
  * */
 #define CPU_CONFIG_COUNT_LEAD_ZEROS_ASM_PRESENT     (0U)
 
+/*------------------- Count Lead Zeros Compiler Builtin ----------------------*/
+/*
+ * Used only if CPU_CONFIG_COUNT_LEAD_ZEROS_ASM_PRESENT is (0U).
+ * (0U) This will use the table based implementation in pretty_clz.c .
+ * (1U) This will use the compiler builtin (i.e GCC/Clang __builtin_clz) in pretty_clz.c .
+ * */
+#define CPU_CONFIG_COUNT_LEAD_ZEROS_BUILTIN_PRESENT (1U)
+
 /*----------------------- CPU Data word sizes in bits ------------------------*/
 #define CPU_CONFIG_DATA_SIZE_BITS                   (CPU_WORD_SIZE_32)              /*  Assume that a system with POSIX runs on a 32-bit processor.         */
 
 /*--------------------- CPU Address word sizes in bits -----------------------*/
 #define CPU_CONFIG_ADDR_SIZE_BITS                   (CPU_WORD_SIZE_32)              /*  Assume that a system with POSIX runs on a 32-bit processor.         */
 
+/*-------------------------- Task Execution Engine ---------------------------*/
+/*
+ * CPU_POSIX_ENGINE_PTHREAD  : Each task is wrapped in a POSIX thread, And only the switched-in thread is allowed to run.
+ *                             The user stacks are not used. Requires the realtime priority limit (see README.txt).
+ * CPU_POSIX_ENGINE_UCONTEXT : All the tasks run on the main thread and switch on the stacks passed to OS_TaskCreate(),
+ *                             Like a single core target. The tick is a POSIX timer signal. (see pretty_os_cpu_ucontext.c)
+ * */
+#define CPU_CONFIG_POSIX_ENGINE                     (CPU_POSIX_ENGINE_PTHREAD)
+
+/*------------------- pthread Engine Context Switch Spinning -----------------*/
+/*
+ * Number of checks of its futex word a switched-out thread spins before it sleeps in the host kernel.
+ * It shortens the switch back to a task on a multi core host. Keep (0U) on a single core host.
+ * */
+#define CPU_CONFIG_POSIX_HANDOFF_SPIN               (0U)
+
 /*----------------------- CPU Stack Growth Direction -------------------------*/
-#define CPU_CONFIG_STACK_GROWTH                     (CPU_STACK_GROWTH_NONE)  		/*  Doesn't make a difference.					                        */
+#define CPU_CONFIG_STACK_GROWTH                     (CPU_STACK_GROWTH_HIGH_TO_LOW)  /*  The tasks run on their stacks as the host does.                     */
 
 /*----------------------- CPU Data word memory order -------------------------*/
 #define CPU_CONFIG_ENDIAN_TYPE                      (CPU_ENDIAN_TYPE_LITTLE)        /*  Doesn't make a difference.					                        */
@@ -132,7 +160,29 @@ typedef void*               CPU_tPtr;                    /* Pointer Type
 #define CPU_CONFIG_STACK_ALIGN_BYTES                  (8U)                          /*  Doesn't make a difference.					                        */
 
 /*----------------------- CPU Critical Section Method ------------------------*/
-#define CPU_CONFIG_CRITICAL_METHOD                  (CPU_CRITICAL_METHOD_TRIVIAL)
+#if (CPU_CONFIG_POSIX_ENGINE == CPU_POSIX_ENGINE_UCONTEXT)
+#define CPU_CONFIG_CRITICAL_METHOD                  (CPU_CRITICAL_METHOD_LOCAL)     /*  A software interrupt mask, No system calls.                         */
+#else
+#define CPU_CONFIG_CRITICAL_METHOD                  (CPU_CRITICAL_METHOD_TRIVIAL)   /*  A nesting software interrupt mask per thread, No system calls.      */
+#endif
+
+/*------------------------- Task Minimum Stack Size --------------------------*/
+/*
+ * A task stack smaller than this (in bytes) is replaced by a host allocated stack of this size,
+ * Since the host library calls and the tick signal frames need far more than a target task does.
+ * */
+#define CPU_CONFIG_TASK_STACK_MIN_BYTES             (65536U)
+
+/*------------------- ucontext Engine Context Switch Code --------------------*/
+/*
+ * (0U) Use swapcontext() of the C library, Which also saves the signal mask by a system call.
+ * (1U) Use the hand written x86-64 switch code, Which only saves the callee-saved registers.
+ *      swapcontext() is still used on other host CPUs.
+ * */
+#define CPU_CONFIG_UCONTEXT_SWITCH_ASM              (1U)
+
+/*-------------------- Tick Lateness Histogram Buckets -----------------------*/
+#define CPU_CONFIG_TICK_LATENESS_BUCKETS            (24U)                           /*  Bucket i counts [2^i, 2^(i+1)) nanoseconds.                         */
 
 
 
@@ -176,6 +226,25 @@ typedef CPU_t32U    CPU_tSR;    	/* Define size of CPU status register.    */
 typedef CPU_t32U	CPU_tSTK;		/* Define CPU stack data type.			  */
 typedef CPU_t32U	CPU_tSTK_SIZE; 	/* Define CPU stack size data type.		  */
 
+/*
+*******************************************************************************
+*                             POSIX Port Data Types                           *
+*******************************************************************************
+*/
+
+typedef struct cpu_tick_lateness CPU_TICK_LATENESS;
+
+struct cpu_tick_lateness
+{
+	CPU_t64U	ticks;										/* Number of the timer expiries measured.									*/
+	CPU_t64U	missed;										/* Ticks which expired while waking up late, Announced with the late one.	*/
+	CPU_t64U	min;										/* Minimum lateness in nanoseconds.											*/
+	CPU_t64U	max;										/* Maximum lateness in nanoseconds.											*/
+	CPU_t64U	sum;										/* Sum of the latenesses, The average is sum/ticks.							*/
+	CPU_t32U	hist [CPU_CONFIG_TICK_LATENESS_BUCKETS];	/* hist[i] counts the latenesses in [2^i, 2^(i+1)) ns, The last one also
+	 	 	 	 	 	 	 	 	 	 	 	 	 	 	   counts the longer ones, And hist[0] counts 0 too.						*/
+};
+
 /*
 *******************************************************************************
 *                             Critical Section Management                     *
@@ -231,6 +300,14 @@ typedef CPU_t32U	CPU_tSTK_SIZE; 	/* Define CPU stack size data type.		  */
  *                      }
  */
 
+#if(CPU_CONFIG_CRITICAL_METHOD == CPU_CRITICAL_METHOD_LOCAL)
+
+    #define CPU_SR_ALLOC()         CPU_tSR cpu_sr = (CPU_tSR)0U                /* Local CPU status word variable.                   */
+    #define OS_CRTICAL_BEGIN()     do { cpu_sr = CPU_SR_Save(); } while (0)    /* Save CPU interrupt status and disable interrupts. */
+    #define OS_CRTICAL_END()       do { CPU_SR_Restore(cpu_sr); } while (0)    /* Restore CPU interrupts status.                    */
+
+#endif
+
 #if(CPU_CONFIG_CRITICAL_METHOD == CPU_CRITICAL_METHOD_TRIVIAL)
 
     #define CPU_SR_ALLOC()          /* CPU_SR_ALLOC(); To give a completeness for the compiler.                                     */
@@ -285,7 +362,10 @@ typedef CPU_t32U	CPU_tSTK_SIZE; 	/* Define CPU stack size data type.		  */
 */
 
 /*=========  Enable/Disable OS Software Stack Overflow Detection. =========*/
-
+/*
+ * The lowest page of every task stack is protected by mprotect() instead of checking the stack pointer at the
+ * context switch. An overflow faults on it and the SIGSEGV handler reports the task to OS_StackOverflow_Detected().
+ * */
 #define OS_CONFIG_CPU_SOFT_STK_OVERFLOW_DETECTION   (OS_CONFIG_DISABLE)
 
 /*
@@ -294,6 +374,30 @@ typedef CPU_t32U	CPU_tSTK_SIZE; 	/* Define CPU stack size data type.		  */
 *******************************************************************************
 */
 
+#if(CPU_CONFIG_CRITICAL_METHOD == CPU_CRITICAL_METHOD_LOCAL)
+/*
+ * Function:  CPU_SR_Save
+ * --------------------
+ * Save the interrupt status and disable the system interrupts.
+ *
+ * Arguments    :   None.
+ *
+ * Returns      :   The interrupt status register value.
+ */
+CPU_tSR CPU_SR_Save     (void);
+/*
+ * Function:  CPU_SR_Restore
+ * --------------------
+ * Restore the interrupt status, The interrupts which came while disabled are serviced once enabled.
+ *
+ * Arguments    :   cpu_sr      is the previous CPU interrupt status value prior to 'CPU_SR_Save' call.
+ *
+ * Returns      :   None.
+ */
+void    CPU_SR_Restore  (CPU_tSR cpu_sr);
+
+#endif
+
 void CPU_InterruptDisable (void);
 
 void CPU_InterruptEnable (void);
@@ -384,6 +488,75 @@ void OS_CPU_SystemTimerHandler (void);
  */
 void  OS_CPU_SystemTimerSetup (CPU_t32U ticks);
 
+/*
+ * Function:  OS_CPU_SystemTimerNextExpiry
+ * --------------------
+ * Program the system timer to fire once after a number of ticks instead of every tick.
+ * The periodic tick is resumed after the timer fires.
+ *
+ * Arguments    :   ticks   is the number of ticks till the next timed-wait expiry.
+ *
+ * Returns      :   None.
+ *
+ * Note(s)      :   1) Called by the idle task when OS_CONFIG_TICKLESS_EN is enabled.
+ */
+void  OS_CPU_SystemTimerNextExpiry (CPU_t32U ticks);
+
+/*
+ * Function:  OS_CPU_TimestampGet
+ * --------------------
+ * Read a free-running high resolution counter which is used to account the tasks runtime.
+ *
+ * Arguments    :   None.
+ *
+ * Returns      :   The current counter value in nanoseconds (CLOCK_MONOTONIC).
+ *
+ * Note(s)      :   1) Used by the kernel when OS_CONFIG_TASK_RUNTIME_EN, OS_CONFIG_TASK_LATENCY_EN or OS_CONFIG_TRACE_EN is enabled.
+ */
+CPU_t64U OS_CPU_TimestampGet (void);
+
+/*
+ * Function:  OS_CPU_TickLatenessGet
+ * --------------------
+ * Get the statistics of the tick lateness, i.e the time from the absolute expiry of a tick till the port
+ * timer has woken up to raise its interrupt.
+ *
+ * Arguments    :   pLateness   is a pointer to the statistics to be filled.
+ *
+ * Returns      :   None.
+ *
+ * Note(s)      :   1) The ticks are generated on absolute expiries from the start, So a lateness doesn't accumulate as drift.
+ *                  2) Ticks which expired while the timer was late are announced with it, And counted as missed.
+ */
+void OS_CPU_TickLatenessGet (CPU_TICK_LATENESS* pLateness);
+
+/*
+ * Function:  OS_CPU_TickLatenessReset
+ * --------------------
+ * Clear the statistics of the tick lateness.
+ *
+ * Arguments    :   None.
+ *
+ * Returns      :   None.
+ */
+void OS_CPU_TickLatenessReset (void);
+
+/*
+ * Function:  OS_CPU_TraceExport
+ * --------------------
+ * Write the records of the trace buffer as a Chrome/Perfetto trace JSON file, Which can be opened
+ * by https://ui.perfetto.dev or chrome://tracing.
+ *
+ * Arguments    :   pPath   is the path of the JSON file to be written.
+ *
+ * Returns      :   The number of the exported records, -1 if the file can't be written.
+ *
+ * Note(s)      :   1) Available when OS_CONFIG_TRACE_EN is enabled.
+ *                  2) Each task is a thread track of its running slices, The other events are instants on it.
+ *                     The ISRs and ticks are on a separate "Interrupts" track.
+ */
+CPU_t32S OS_CPU_TraceExport (const char* pPath);
+
 #ifdef __cplusplus
 }
 #endif
@@ -60,7 +60,7 @@ SOFTWARE.
 #include  <pthread.h>
 #include  <stdint.h>
 #include  <signal.h>
-#include  <semaphore.h>
+#include  <ucontext.h>
 #include  <time.h>
 #include  <string.h>
 #include  <unistd.h>
@@ -69,9 +69,12 @@ SOFTWARE.
 #include  <sys/syscall.h>
 #include  <sys/resource.h>
 #include  <errno.h>
+#include  <linux/futex.h>
 #include "pretty_arch.h"
 #include "../../../../kernel/pretty_os.h"
 
+#if (CPU_CONFIG_POSIX_ENGINE == CPU_POSIX_ENGINE_PTHREAD)	/* See pretty_os_cpu_ucontext.c for the single thread engine.									*/
+
 #if  (_POSIX_C_SOURCE < 199309L)	/* Minimal requirement: POSIX.1b standard (IEEE Standard 1003.1b-1993) which includes
  	 	 	 	 	 	 	 	 	 	Priority Scheduling, Real-Time Signals, Clocks, Semaphores ... etc */
 #error  "_POSIX_C_SOURCE is required to be at least 199309L"
@@ -97,6 +100,20 @@ extern void OS_TimerTick  (void);
 extern void OS_IntEnter   (void);
 extern void OS_IntExit    (void);
 
+extern void*     CPU_HostStackGet (CPU_tSTK* pStackBase);				/* See pretty_os_cpu_stack.c.	*/
+#if (OS_CONFIG_CPU_SOFT_STK_OVERFLOW_DETECTION == OS_CONFIG_ENABLE)
+extern void      CPU_StackGuardInit       (void);
+extern void      CPU_StackGuardThreadInit (void);
+extern CPU_t08U* CPU_StackGuardSet        (CPU_tSTK* pStackBase, CPU_t08U* pBottom, CPU_tSTK_SIZE stackSize);
+extern void      CPU_StackGuardBind       (OS_TASK_TCB* ptcb);
+extern void      CPU_StackGuardRelease    (OS_TASK_TCB* ptcb);
+#endif
+#if (OS_CONFIG_TASK_STACK_USAGE_EN == OS_CONFIG_ENABLE)
+extern void      CPU_StackRegionSet       (OS_TASK_TCB* ptcb);
+#endif
+
+extern long syscall       (long number, ...);	/* Not declared by <unistd.h> for _XOPEN_SOURCE only, It's used for the futex calls.	*/
+
 /*
 *******************************************************************************
 *                               Local Macros                                  *
@@ -104,6 +121,7 @@ extern void OS_IntExit    (void);
 */
 
 #define PRIO_THREAD_CREATION	50U					/* Priority value for all POSIX threads.														*/
+#define CPU_THREAD_STACK_BYTES	(65536U)			/* The own stack of a thread, Where it only waits for its task. The task runs on its stack.		*/
 
 													/* A common macro to terminate in case if error is returned.									*/
 #define ERROR_CHECK(func)      do {	int res = func; \
@@ -117,6 +135,10 @@ extern void OS_IntExit    (void);
 
 #define CPU_IRQ_SIG        	  (SIGURG) 				/* Urgent data POSIX signal to be used as IRQ trigger signal.           						*/
 
+#define CPU_HANDOFF_WAIT		(0U)				/* The thread is running, Or it's about to wait for its turn.									*/
+#define CPU_HANDOFF_GO			(1U)				/* The thread is switched in.																	*/
+#define CPU_HANDOFF_SLEEP		(2U)				/* The thread sleeps in the kernel on its futex word, So it must be woken up.					*/
+
 #define __DEBUG_CPU_PORT		0U
 
 #if (__DEBUG_CPU_PORT == 1U)
@@ -136,8 +158,15 @@ typedef struct os_task_tcb_posix	OS_TCB_POSIX;
 struct os_task_tcb_posix
 {
 	pthread_t 	thread;								/*POSIX thread that acts as a wrapper for PrettyOS task.										*/
-	sem_t		sem_TaskCreated;					/*Protect task creation critical section.														*/
-	sem_t		sem_CtxSW;							/* Stop/Resume POSIX thread using a semaphore, acting like a context switcher to other threads. */
+	CPU_t32U	futex_CtxSW;						/* Stop/Resume POSIX thread using a futex word, acting like a context switcher to other threads.*/
+	CPU_t32U	futex_Restart;						/* Set when the task is deleted by another task, Cleared once the thread is back to its start.	*/
+#if (OS_CONFIG_TASK_BUDGET_EN == OS_CONFIG_ENABLE)
+	CPU_t08U	ctx_Rebuilt;						/* Set when the task context is built again (i.e an aborted job), The thread switches to it.	*/
+#endif
+	ucontext_t	ctx_Thread;							/* The thread on its own stack, Where it goes back from the task stack to wait for a new task.	*/
+	OS_TASK_TCB*  ptcb;								/* The task which is bound to the thread.														*/
+	OS_TCB_POSIX* pNextFree;						/* The next free shell in CPU_TaskShellFreeList.												*/
+	OS_TCB_POSIX* pSwitchTo;						/* The task to switch in once the thread has left the stack of its deleted task.				*/
 #ifdef __DEBUG_CPU_PORT
 	pid_t		thread_pid;
 	OS_PRIO		thread_prio;
@@ -151,6 +180,22 @@ struct os_task_tcb_posix
 */
 
 static  sigset_t              CPU_IRQ_SigSet;		/* The set which will contain the signals we which to capture as a CPU IRQ.						*/
+static  pthread_t             CPU_RunningThread;	/* The thread of the switched-in task, Which represents the CPU for the tick IRQ.				*/
+
+static  __thread volatile CPU_t32U CPU_IntNesting;	/* The software interrupt mask of the calling thread, Interrupts are disabled while not 0.		*/
+static  volatile CPU_t32U     CPU_IntPending;		/* Set when an IRQ came while the CPU had the interrupts disabled, Serviced at the enable.		*/
+
+static  volatile OS_TICK      CPU_TickPending;		/* Number of ticks elapsed but not yet announced to the kernel.									*/
+#if (OS_CONFIG_TICKLESS_EN == OS_CONFIG_ENABLE)
+static  volatile OS_TICK      CPU_TickCount;		/* Number of ticks elapsed as counted by the timer thread.										*/
+static  volatile OS_TICK      CPU_TickNextExpiry;	/* The tick count (in CPU_TickCount) of the next one-shot expiry.								*/
+#endif
+
+static  OS_TCB_POSIX          CPU_TaskShells [OS_CONFIG_TASK_COUNT];	/* A thread for each TCB, Spawned once by OS_Init().										*/
+static  OS_TCB_POSIX*         CPU_TaskShellFreeList;
+
+static  CPU_TICK_LATENESS     CPU_TickLateness;		/* Updated by the timer thread.																	*/
+static  pthread_mutex_t       CPU_TickLatenessLock = PTHREAD_MUTEX_INITIALIZER;
 
 /*
 *******************************************************************************
@@ -162,8 +207,17 @@ static void* OS_TaskPosixWrapper 		 (void  *p_arg);
 static void* CPU_TaskPosixTimerInterrupt (void  *p_arg);
 
 static void  CPU_IRQ_Handler (int sig);
+static void  CPU_IRQ_Dispatch (void);
 static void  CPU_IRQ_TimerInterruptTrigger (void);
 
+static void  CPU_TickLatenessRecord (CPU_t64U lateness, OS_TICK missed);
+
+static void  CPU_HandoffPost (OS_TCB_POSIX* ptcbPosix);
+static void  CPU_HandoffWait (OS_TCB_POSIX* ptcbPosix);
+static CPU_t08U CPU_TaskSwitchIn (OS_TCB_POSIX* ptcbPosix);
+static void  CPU_TaskStart (void);
+static void  CPU_TaskContextMake (ucontext_t* puc, CPU_t08U* pBottom);
+
 /*
 *******************************************************************************
 *                         Critical Section Functions	   					  *
@@ -176,6 +230,8 @@ static void  CPU_IRQ_TimerInterruptTrigger (void);
  * This function installs a fake scheme for protect critical sections code.
  *
  * Note(s)	:	1)	This function must be called prior to use of any CPU_InterruptDisable() and CPU_InterruptEnable().
+ * 				2)	The IRQ signal is never blocked in the task threads, The handler checks the software interrupt mask
+ * 					of the interrupted thread instead. So a critical section doesn't make any system call.
  *
  */
 void CPU_InterruptInit (void)
@@ -199,23 +255,34 @@ void CPU_InterruptInit (void)
  * Function:  CPU_InterruptDisable
  * --------------------------------
  * This function is used to disables interrupts before critical sections of code.
+ *
+ * Note(s)	:	1)	The calls nest, The interrupts are enabled again by the outermost CPU_InterruptEnable().
  */
 void CPU_InterruptDisable (void)
 {
-	//__print_debug("Disable INT for %u\n",pthread_self());
-	/* The signal mask is the set of signals whose delivery is currently blocked for the caller. */
-    pthread_sigmask(SIG_BLOCK, &CPU_IRQ_SigSet, NULL);					/* Block CPU_IRQ_SigSet (has CPU_IRQ_SIG) from being deliverable to the calling thread.	*/
+	++CPU_IntNesting;
+	__atomic_signal_fence(__ATOMIC_SEQ_CST);							/* Keep the critical section code after the mask.										*/
 }
 
 /*
  * Function:  CPU_InterruptEnable
  * --------------------------------
- * This function is used to enable interrupts after critical sections of code.
+ * This function is used to enable interrupts after critical sections of code, And to service the IRQ which came
+ * while they were disabled.
+ *
+ * Note(s)	:	1)	An enable while the interrupts are enabled is ignored, As the CPU does.
  */
 void CPU_InterruptEnable (void)
 {
-	//__print_debug("Enable INT for %u\n",pthread_self());
-    pthread_sigmask(SIG_UNBLOCK, &CPU_IRQ_SigSet, NULL);				/* Remove CPU_IRQ_SIG from blocked signals of the calling thread.						*/
+	__atomic_signal_fence(__ATOMIC_SEQ_CST);							/* Keep the critical section code before the unmask.									*/
+	if (CPU_IntNesting == 0U)
+	{
+		return;
+	}
+	if ((--CPU_IntNesting == 0U) && (__atomic_load_n(&CPU_IntPending, __ATOMIC_ACQUIRE) != 0U))
+	{
+		CPU_IRQ_Dispatch();												/* Service it now as the hardware does at the unmask.									*/
+	}
 }
 
 /*
@@ -225,25 +292,79 @@ void CPU_InterruptEnable (void)
  *
  * Arguments:	sig		is the signal number which invoked this handler ( i.e CPU_IRQ_SIG ).
  *
+ * Note(s)	:	1)	The IRQ is pended if the interrupted thread has the interrupts disabled.
+ * 				2)	A signal which is taken by a thread which is not the running one anymore (e.g it has just switched
+ * 					to another task) is pended and sent again to the running thread, Which may have the interrupts
+ * 					enabled already.
  */
-void CPU_IRQ_Handler (int sig)
+static void CPU_IRQ_Handler (int sig)
 {
+	int			errno_saved;
+	pthread_t	running;
+
+	errno_saved = errno;												/* errno belongs to the interrupted task.												*/
+
 	__print_debug("%u received IRQ sig, Calling OS_CPU_SystemTimerHandler() \n",pthread_self());
 
-	OS_CPU_SystemTimerHandler();										/* Call the timer handler which is the only handler in this port.						*/
+	running = __atomic_load_n(&CPU_RunningThread, __ATOMIC_ACQUIRE);
+	if (!pthread_equal(pthread_self(), running))
+	{
+		__atomic_store_n(&CPU_IntPending, 1U, __ATOMIC_RELEASE);
+		pthread_kill(running, sig);
+	}
+	else if (CPU_IntNesting != 0U)										/* Pend it if the interrupted code is in a critical section.							*/
+	{
+		__atomic_store_n(&CPU_IntPending, 1U, __ATOMIC_RELEASE);
+	}
+	else
+	{
+		CPU_IRQ_Dispatch();
+	}
+
+	errno = errno_saved;
+}
+
+/*
+ * Function:  CPU_IRQ_Dispatch
+ * --------------------------------
+ * Call the timer handler which is the only handler in this port with the interrupts disabled. It's called with
+ * the interrupts enabled.
+ *
+ * Note(s)	:	1)	The tick ISR may switch to another task, The loop continues when this task is switched in again.
+ */
+static void CPU_IRQ_Dispatch (void)
+{
+	do {
+		CPU_InterruptDisable();											/* The ISR can't be interrupted by itself, Like a single priority level.				*/
+		__atomic_store_n(&CPU_IntPending, 0U, __ATOMIC_SEQ_CST);
+		OS_CPU_SystemTimerHandler();
+		__atomic_signal_fence(__ATOMIC_SEQ_CST);
+		--CPU_IntNesting;
+		__atomic_signal_fence(__ATOMIC_SEQ_CST);
+	} while (__atomic_load_n(&CPU_IntPending, __ATOMIC_ACQUIRE) != 0U);	/* An IRQ came just before the interrupts are enabled.									*/
 }
 
 /*
  * Function:  CPU_IRQ_TimerInterruptTrigger
  * --------------------------------
  * Sends IRQ signal to the CPU to trigger the system timer tick.
+ *
+ * Note(s)	:	1)	The signal is directed to the thread of the running task. A process directed signal is taken by any
+ * 					thread which doesn't block it, So the interrupted task and the latency would depend on the host.
+ * 				2)	The running thread is set before the switched-in thread is woken up, Which has the interrupts
+ * 					disabled till it ends the switch. So a tick at a context switch is only delayed till the switch ends.
+ * 				3)	No tick is sent till the OS runs.
  */
 void  CPU_IRQ_TimerInterruptTrigger (void)
 {
 	__print_debug("Send IRQ sig from %u\n",pthread_self());
 
-    kill(getpid(), CPU_IRQ_SIG);										/* Send an CPU_IRQ_SIG signal via kill function. 										*/
+	if (__atomic_load_n(&OS_Running, __ATOMIC_ACQUIRE) == OS_TRUE)
+	{
+		pthread_kill(__atomic_load_n(&CPU_RunningThread, __ATOMIC_ACQUIRE), CPU_IRQ_SIG);	/* Send an CPU_IRQ_SIG signal to the running task.				*/
+	}
 }
+
 /*
 *******************************************************************************
 *                           	Hook Functions	   							  *
@@ -260,7 +381,11 @@ void  CPU_IRQ_TimerInterruptTrigger (void)
  */
 void OS_CPU_Hook_Init (void)
 {
-    struct  rlimit  rtprio_limits;
+    struct  rlimit  		rtprio_limits;
+    pthread_attr_t       	attr;
+    struct sched_param   	param_sched;
+    OS_TCB_POSIX*			ptcbPosix;
+    CPU_t32U				i;
 
     ERROR_CHECK(getrlimit(RLIMIT_RTPRIO, &rtprio_limits));
     if (rtprio_limits.rlim_cur != RLIM_INFINITY) {
@@ -271,12 +396,50 @@ void OS_CPU_Hook_Init (void)
     }
 
     CPU_InterruptInit();													/* Setup the fake critical section scheme.													*/
+#if (OS_CONFIG_CPU_SOFT_STK_OVERFLOW_DETECTION == OS_CONFIG_ENABLE)
+    CPU_StackGuardInit();													/* Catch the faults on the guard pages of the task stacks.									*/
+#endif
+
+    if (PRIO_THREAD_CREATION < sched_get_priority_min(SCHED_RR) ||			/* Is the priority value in the allowable range. ? 											*/
+    		PRIO_THREAD_CREATION > sched_get_priority_max(SCHED_RR)) {
+        printf("Cannot Create a POSIX thread with the specified priority = %d\n",PRIO_THREAD_CREATION);
+        raise(SIGABRT);
+    }
+
+    param_sched.__sched_priority = PRIO_THREAD_CREATION;					/* Set the priority of the POSIX thread.													*/
+
+    ERROR_CHECK(pthread_attr_init(&attr));
+    ERROR_CHECK(pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED));	/*Take scheduling attributes from &attr object.											*/
+    ERROR_CHECK(pthread_attr_setschedpolicy(&attr, SCHED_RR));				/* Set Round-Robin Scheduler for the created Thread.										*/
+    ERROR_CHECK(pthread_attr_setschedparam(&attr, &param_sched));			/* Set the scheduling attributes from &param object.										*/
+    ERROR_CHECK(pthread_attr_setstacksize(&attr, CPU_THREAD_STACK_BYTES));	/* The tasks don't run on the thread stacks, So they are kept small.						*/
+
+    CPU_TaskShellFreeList = OS_NULL(OS_TCB_POSIX);
+    for (i = OS_CONFIG_TASK_COUNT; i > 0U; --i)								/* Spawn a thread for every TCB, So a task creation only binds a free one to the task.		*/
+    {
+    	ptcbPosix = &CPU_TaskShells[i - 1U];
+    	ptcbPosix->futex_CtxSW   = CPU_HANDOFF_WAIT;							/* Not switched in yet.																		*/
+    	ptcbPosix->futex_Restart = 0U;
+#if (OS_CONFIG_TASK_BUDGET_EN == OS_CONFIG_ENABLE)
+    	ptcbPosix->ctx_Rebuilt   = 0U;
+#endif
+    	ptcbPosix->ptcb          = OS_NULL(OS_TASK_TCB);
+    	ptcbPosix->pSwitchTo     = OS_NULL(OS_TCB_POSIX);
+
+        ERROR_CHECK(pthread_create(&ptcbPosix->thread, &attr,
+        		OS_TaskPosixWrapper, (void*)ptcbPosix));
+
+    	ptcbPosix->pNextFree  = CPU_TaskShellFreeList;
+    	CPU_TaskShellFreeList = ptcbPosix;
+    }
+
+    ERROR_CHECK(pthread_attr_destroy(&attr));
 }
 
 /*
  * Function:  OS_CPU_Hook_TaskCreated
  * --------------------------------
- * This function is called when a task is created.
+ * This function is called when a task is created. It binds the task to a thread of the pool which is spawned by OS_CPU_Hook_Init().
  *
  * Arguments:	ptcb	is a Pointer to the task TCB of the task being created.
  *
@@ -288,48 +451,32 @@ void OS_CPU_Hook_Init (void)
 void OS_CPU_Hook_TaskCreated (OS_TASK_TCB*	ptcb)
 {
 	OS_TCB_POSIX*			ptcbPosix;
-    pthread_attr_t       	attr;
-    struct sched_param   	param_sched;
-    int 					ret;
 
-	ptcbPosix	=	(OS_TCB_POSIX*)malloc(sizeof(OS_TCB_POSIX));			/* Allocate a storage for OS_TCB_POSIX Object.												*/
+	ptcbPosix	=	CPU_TaskShellFreeList;									/* Take a free thread.																		*/
 
 	if(ptcbPosix == OS_NULL(OS_TCB_POSIX))
 	{
-		printf("Cannot Allocate a memory for OS_TCB_POSIX object\n");
+		printf("No free POSIX thread for the created task\n");
 		raise(SIGABRT);
 	}
 
-	ptcb->OSTCBExtension = (void*)ptcbPosix;								/* Save OS_TCB_POSIX object for later use.		 											*/
-	ERROR_CHECK(sem_init(&ptcbPosix->sem_TaskCreated, 0u, 0u));				/* Initial semaphore value to 0.															*/
-	ERROR_CHECK(sem_init(&ptcbPosix->sem_CtxSW, 0u, 0u));					/* Initial semaphore value to 0.															*/
-
-
-    if (PRIO_THREAD_CREATION < sched_get_priority_min(SCHED_RR) ||			/* Is the priority value in the allowable range. ? 											*/
-    		PRIO_THREAD_CREATION > sched_get_priority_max(SCHED_RR)) {
-        printf("Cannot Create a POSIX thread with the specified priority = %d\n",PRIO_THREAD_CREATION);
-        raise(SIGABRT);
-    }
-
-    param_sched.__sched_priority = PRIO_THREAD_CREATION;					/* Set the priority of the POSIX thread.													*/
-
-    ERROR_CHECK(pthread_attr_init(&attr));
-    ERROR_CHECK(pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED));	/*Take scheduling attributes from &attr object.											*/
-    ERROR_CHECK(pthread_attr_setschedpolicy(&attr, SCHED_RR));				/* Set Round-Robin Scheduler for the created Thread.										*/
-    ERROR_CHECK(pthread_attr_setschedparam(&attr, &param_sched));			/* Set the scheduling attributes from &param object.										*/
-
-    ERROR_CHECK(pthread_setcancelstate(PTHREAD_CANCEL_ENABLE, NULL));		/* Enable the receiving of cancellation request for the created thread.						*/
-
-    ERROR_CHECK(pthread_create(&ptcbPosix->thread, &attr,					/* Create a POSIX thread for the created OS_TASK_TCB object.								*/
-    		OS_TaskPosixWrapper, (void*)ptcb));
-
-    do {
-        ret = sem_wait(&ptcbPosix->sem_TaskCreated);                    	/* Wait for the POSIX thread to pass its initial critical section. 							*/
-        if (ret != 0 && errno != EINTR) {									/* Continue to wait even if you're interrupted by another system call errno	value.			*/
-			ERROR_CHECK(ret);												/* This explains the possible issue:
-            																 * https://stackoverflow.com/questions/41474299/checking-if-errno-eintr-what-does-it-mean	*/
-        }
-    } while (ret != 0);
+	CPU_TaskShellFreeList	= ptcbPosix->pNextFree;
+#if (OS_CONFIG_TASK_BUDGET_EN == OS_CONFIG_ENABLE)
+	ptcbPosix->ctx_Rebuilt	= 0U;
+#endif
+	ptcbPosix->ptcb			= ptcb;											/* Bind the task to the thread, It runs the task at its first context switch.				*/
+	ptcb->OSTCBExtension	= (void*)ptcbPosix;								/* Save OS_TCB_POSIX object for later use.		 											*/
+#if (OS_CONFIG_CPU_SOFT_STK_OVERFLOW_DETECTION == OS_CONFIG_ENABLE)
+	CPU_StackGuardBind(ptcb);
+#endif
+#if (OS_CONFIG_TASK_STACK_USAGE_EN == OS_CONFIG_ENABLE)
+	CPU_StackRegionSet(ptcb);												/* The kernel measures the stack which the task runs on.									*/
+#endif
+#ifdef __DEBUG_CPU_PORT
+#if(OS_CONFIG_EDF_EN == OS_CONFIG_DISABLE)
+	ptcbPosix->thread_prio 	= ptcb->TASK_priority;
+#endif
+#endif
 }
 
 /*
@@ -342,32 +489,66 @@ void OS_CPU_Hook_TaskCreated (OS_TASK_TCB*	ptcb)
  * Returns	:	None.
  *
  * Note(s)	:	1)	Interrupts should be disabled during this call.
+ * 				2)	The thread of the deleted task leaves the task stack back to its start without any cleanup.
+ * 					So a task shouldn't be deleted while it's inside a host library call which holds a lock (e.g printf).
  *
  */
 void OS_CPU_Hook_TaskDeleted (OS_TASK_TCB*	ptcb)
 {
 	OS_TCB_POSIX* ptcbPosix = (OS_TCB_POSIX*)ptcb->OSTCBExtension;
 
-	if (pthread_equal(pthread_self(), ptcbPosix->thread)) { 				/* If current thread is the requested ptcbPosix thread, then ... 	  						*/
-		ERROR_CHECK(pthread_cancel(ptcbPosix->thread));						/* ... Send a cancellation request to ptcbPosix thread to terminate.						*/
-	 }
+	if (!pthread_equal(pthread_self(), ptcbPosix->thread)) { 				/* Another task is deleted, Its thread waits for its turn somewhere in its call stack ...	*/
+		__atomic_store_n(&ptcbPosix->futex_Restart, 1U, __ATOMIC_SEQ_CST);
+		CPU_HandoffPost(ptcbPosix);											/* ... So wake it up to leave the task stack ...											*/
+		while (__atomic_load_n(&ptcbPosix->futex_Restart, __ATOMIC_SEQ_CST) != 0U)
+		{
+			syscall(SYS_futex, &ptcbPosix->futex_Restart, FUTEX_WAIT_PRIVATE, 1U, NULL, NULL, 0);	/* ... And wait till it's there.					*/
+		}
+	}																		/* A task which deletes itself leaves its stack when it's switched out.						*/
 
-	free(ptcb->OSTCBExtension);												/* Deallocate the object from the memory.													*/
-	sleep(1000);        													/* Should get canceled while we sleep 														*/
+#if (OS_CONFIG_CPU_SOFT_STK_OVERFLOW_DETECTION == OS_CONFIG_ENABLE)
+	CPU_StackGuardRelease(ptcb);
+#endif
+
+	ptcbPosix->ptcb			= OS_NULL(OS_TASK_TCB);
+	ptcbPosix->pNextFree	= CPU_TaskShellFreeList;						/* Free the thread for the next created task.												*/
+	CPU_TaskShellFreeList	= ptcbPosix;
 }
 
 /*
  * Function:  OS_CPU_Hook_Idle
  * --------------------------------
- * This function is called by the OS_IdleTask().
+ * This function is called by the OS_IdleTask(). It waits for the next interrupt like a WFI instruction.
  *
  * Arguments:	None.
  *
  * Returns	:	None.
+ *
+ * Note(s)	:	1)	The signal is blocked before checking for a pending IRQ and sigsuspend() unblocks it and sleeps
+ * 					atomically. So an IRQ which comes in between is taken by sigsuspend() at once instead of being
+ * 					lost till the next one. The handler only pends it, Since the interrupts are disabled.
+ * 				2)	The tick ISR may switch to another task, The hook returns when the idle task is switched in again.
+ * 				3)	The time blocked in sigsuspend() is runtime of the idle task, Which the statistics task counts as idle.
  */
 void OS_CPU_Hook_Idle (void)
 {
-	sleep(1);																/* For some reason, this solve a possible deadlock in this porting code :) 					*/
+	sigset_t	old_set;
+	sigset_t	wait_set;
+
+	CPU_InterruptDisable();
+
+	ERROR_CHECK(pthread_sigmask(SIG_BLOCK, &CPU_IRQ_SigSet, &old_set));
+
+	if (__atomic_load_n(&CPU_IntPending, __ATOMIC_ACQUIRE) == 0U)
+	{
+		wait_set = old_set;
+		sigdelset(&wait_set, CPU_IRQ_SIG);
+		sigsuspend(&wait_set);											/* Sleep till the IRQ signal comes.														*/
+	}
+
+	ERROR_CHECK(pthread_sigmask(SIG_SETMASK, &old_set, NULL));
+
+	CPU_InterruptEnable();												/* Service the IRQ.																		*/
 }
 
 void OS_CPU_Hook_ContextSwitch (void)
@@ -386,12 +567,93 @@ void OS_CPU_Hook_TimeTick (void)
 *******************************************************************************
 */
 
+/*
+ * Function:  OS_CPU_TaskStackInit
+ * --------------------
+ * Build the first context of the task on its stack, Such that the thread which runs the task switches to it
+ * and calls CPU_TaskStart().
+ *
+ * Arguments:
+ *          TASK_Handler            is a function pointer to the task code.
+ *          params                  is a pointer to the user supplied data which is passed to the task.
+ *          pStackBase              is a pointer to the bottom of the task stack.
+ *          stackSize               is the task stack size in bytes.
+ *
+ * Returns: The ucontext_t of the task at the top of its stack.
+ *
+ * Notes:   1) The task entry and argument are read from the TCB at the first switch.
+ *          2) A stack smaller than CPU_CONFIG_TASK_STACK_MIN_BYTES is replaced by a host stack.
+ *          3) The interrupts are disabled in the context, CPU_TaskStart() enables them.
+ *          4) The lowest page of the stack is the guard page if OS_CONFIG_CPU_SOFT_STK_OVERFLOW_DETECTION is enabled.
+ *          5) A context built again for a task which has a thread (i.e an aborted job) is switched to by the thread
+ *             at the next switch in of the task, Instead of resuming the aborted job.
+ */
 CPU_tSTK* OS_CPU_TaskStackInit(void (*TASK_Handler)(void* params),
                              	 void *params,
 								 CPU_tSTK* pStackBase,
 								 CPU_tSTK_SIZE  stackSize)
 {
-    return (pStackBase);									/* Return the base address of the stack since we're not need the defined user stack area.  				*/
+	CPU_t08U*	pBottom;
+	uintptr_t	top;
+	ucontext_t*	puc;
+#if (OS_CONFIG_TASK_BUDGET_EN == OS_CONFIG_ENABLE)
+	CPU_t32U	idx;
+#endif
+
+	(void)TASK_Handler;
+	(void)params;
+
+	pBottom = (CPU_t08U*)pStackBase;
+	if (stackSize < CPU_CONFIG_TASK_STACK_MIN_BYTES)
+	{
+		pBottom   = (CPU_t08U*)CPU_HostStackGet(pStackBase);
+		stackSize = CPU_CONFIG_TASK_STACK_MIN_BYTES;
+	}
+
+	top = ((uintptr_t)pBottom + stackSize) & ~(uintptr_t)0xFU;			/* The x86-64 and AArch64 ABIs require a 16 bytes aligned stack.						*/
+	puc = (ucontext_t*)((top - sizeof(ucontext_t)) & ~(uintptr_t)0xFU);	/* The context is kept at the top of the stack.											*/
+#if (OS_CONFIG_CPU_SOFT_STK_OVERFLOW_DETECTION == OS_CONFIG_ENABLE)
+	pBottom = CPU_StackGuardSet(pStackBase, pBottom, stackSize);		/* The task can't grow below the guard page.											*/
+#endif
+
+	CPU_TaskContextMake(puc, pBottom);
+
+#if (OS_CONFIG_TASK_BUDGET_EN == OS_CONFIG_ENABLE)
+	for (idx = 0U; idx < OS_CONFIG_TASK_COUNT; ++idx)					/* Built again for a task which is bound to a thread (i.e an aborted job) ?				*/
+	{
+		if ((CPU_TaskShells[idx].ptcb != OS_NULL(OS_TASK_TCB)) &&
+			(CPU_TaskShells[idx].ptcb->TASK_StkBase == pStackBase))
+		{
+			CPU_TaskShells[idx].ctx_Rebuilt = 1U;							/* ... Yes, Its thread leaves the aborted job at the next switch in.					*/
+		}
+	}
+#endif
+
+	return ((CPU_tSTK*)puc);
+}
+
+/*
+ * Function:  CPU_TaskContextMake
+ * --------------------
+ * Make a context which calls CPU_TaskStart() on the stack from pBottom till the context itself.
+ *
+ * Arguments:
+ *          puc                     is a pointer to the context, It's kept at the top of the stack.
+ *          pBottom                 is a pointer to the lowest usable byte of the stack.
+ *
+ * Returns: None.
+ *
+ * Notes:   1) It's a separate function since getcontext() returns twice, The locals of its caller which are
+ *             assigned before the call might be clobbered.
+ */
+static void CPU_TaskContextMake (ucontext_t* puc, CPU_t08U* pBottom)
+{
+	ERROR_CHECK(getcontext(puc));
+	puc->uc_stack.ss_sp   = pBottom;
+	puc->uc_stack.ss_size = (size_t)((CPU_t08U*)puc - pBottom);
+	puc->uc_link          = NULL;
+	sigdelset(&puc->uc_sigmask, CPU_IRQ_SIG);							/* The task takes the IRQ signal at any time, The software interrupt mask defers it.	*/
+	makecontext(puc, CPU_TaskStart, 0);
 }
 
 /*
@@ -414,7 +676,20 @@ void OS_CPU_SystemTimerHandler  (void)
 
     OS_CRTICAL_END();
 
-    OS_TimerTick();         												/* Signal the tick to the OS_timerTick().       						*/
+#if (OS_CONFIG_TICKLESS_EN == OS_CONFIG_ENABLE)
+    OS_TimerTickElapsed(__atomic_exchange_n(&CPU_TickPending, 0U,			/* Signal all the elapsed ticks since the last handler call.			*/
+    					__ATOMIC_SEQ_CST));
+#else
+    {
+    	OS_TICK ticks = __atomic_exchange_n(&CPU_TickPending, 0U, __ATOMIC_SEQ_CST);
+
+    	while (ticks > 0U)													/* Missed ticks are signaled one by one, Like on time ones.				*/
+    	{
+    		OS_TimerTick();         										/* Signal the tick to the OS_timerTick().       						*/
+    		--ticks;
+    	}
+    }
+#endif
 
     OS_IntExit();           												/* Notify that we are leaving the ISR.          						*/
 }
@@ -446,12 +721,39 @@ void  OS_CPU_SystemTimerSetup (CPU_t32U ticks)
     		CPU_TaskPosixTimerInterrupt, (void*)&ticks));					/* Create the timer thread.												*/
 }
 
+#if (OS_CONFIG_TICKLESS_EN == OS_CONFIG_ENABLE)
+/*
+ * Function:  OS_CPU_SystemTimerNextExpiry
+ * --------------------
+ * Make the timer thread sleep until the next timed-wait expiry instead of firing every tick.
+ *
+ * Arguments    :   ticks   is the number of ticks till the next expiry, counted from the last announced tick.
+ *
+ * Returns      :   None.
+ *
+ * Note(s)      :   1) Ticks which are elapsed but still pending are not announced yet, So they are subtracted
+ *                     from the timer thread count to not wake up late.
+ */
+void  OS_CPU_SystemTimerNextExpiry (CPU_t32U ticks)
+{
+	OS_TICK announced;
+
+	if (ticks > (OS_TICK_INFINITE >> 1U)) {									/* Keep the expiry comparable with the tick count.						*/
+		ticks = (OS_TICK_INFINITE >> 1U);
+	}
+
+	announced  = __atomic_load_n(&CPU_TickCount, __ATOMIC_SEQ_CST);
+	announced -= __atomic_load_n(&CPU_TickPending, __ATOMIC_SEQ_CST);
+
+	__atomic_store_n(&CPU_TickNextExpiry, announced + ticks, __ATOMIC_SEQ_CST);
+}
+#endif
+
 void OS_CPU_ContexSwitch (void)
 {
 	OS_TCB_POSIX*	ptcbPosix_old;
 	OS_TCB_POSIX*	ptcbPosix_new;
     CPU_t08U        current_deleted;
-    int             ret;
 
     OS_CPU_Hook_ContextSwitch();											/* Call Task Context Switch Hook.										*/
 
@@ -465,19 +767,27 @@ void OS_CPU_ContexSwitch (void)
 
     OS_currentTask = OS_nextTask;											/* Set the next scheduled task to be the current.				 		*/
     __print_debug("%s(): [%d] will switch in\n",__FUNCTION__,ptcbPosix_new->thread_prio);
-    ERROR_CHECK(sem_post(&ptcbPosix_new->sem_CtxSW));						/* Post Context Switch semaphore to switch to the new task.				*/
-
-    if (current_deleted == OS_FAlSE) {										/* If we're not switched out from a deleted task ...					*/
-        do {
-            __print_debug("%s(): [%d] will switch out\n",__FUNCTION__,ptcbPosix_old->thread_prio);
-            ret = sem_wait(&ptcbPosix_old->sem_CtxSW);						/* ... pend on it until it's scheduled again.					 		*/
-            if (ret != 0 && errno != EINTR) {								/* even we're interrupted a by another system call errno value.			*/
-                raise(SIGABRT);
-            }
-        } while (ret != 0);
-    }																		/* If it was deleted or accidentally returned, OS_TaskDelete() is called
-     	 	 	 	 	 	 	 	 	 	 	 	 	 	 	 	 	 	 * whether in OS_TaskPosixWrapper() or OS_TaskDelete_CPU_Hook() which is
-    																		 * called by OS_TaskDelete().											*/
+    __atomic_store_n(&CPU_RunningThread, ptcbPosix_new->thread, __ATOMIC_RELEASE);	/* Direct the ticks to the new task.							*/
+
+    if (current_deleted == OS_TRUE) {										/* The new task may create a task on the stack of the deleted one ...	*/
+    	ptcbPosix_old->pSwitchTo = ptcbPosix_new;							/* ... So the thread leaves it first, Then it wakes the new task.		*/
+    	ERROR_CHECK(setcontext(&ptcbPosix_old->ctx_Thread));
+    }
+
+    CPU_HandoffPost(ptcbPosix_new);											/* Wake the new task.													*/
+
+    __print_debug("%s(): [%d] will switch out\n",__FUNCTION__,ptcbPosix_old->thread_prio);
+    if (CPU_TaskSwitchIn(ptcbPosix_old) == OS_FAlSE) {						/* Wait on its own word until it's scheduled again.			 			*/
+    	ERROR_CHECK(setcontext(&ptcbPosix_old->ctx_Thread));				/* It's deleted meanwhile, The thread goes back to wait for a new task.	*/
+    }
+
+#if (OS_CONFIG_TASK_BUDGET_EN == OS_CONFIG_ENABLE)
+    if (ptcbPosix_old->ctx_Rebuilt != 0U) {									/* Its job was aborted meanwhile, Restart the task on its new context.	*/
+    	ptcbPosix_old->ctx_Rebuilt = 0U;
+    	CPU_IntNesting = 1U;												/* The critical sections of the aborted job are left behind.			*/
+    	ERROR_CHECK(setcontext((ucontext_t*)ptcbPosix_old->ptcb->TASK_SP));	/* CPU_TaskStart() enables the interrupts.								*/
+    }
+#endif
 }
 
 void OS_CPU_InterruptContexSwitch (void)
@@ -504,9 +814,11 @@ void OS_CPU_FirstStart (void)
 
     CPU_InterruptDisable();													/* Disable CPU interrupts for the calling thread at this early setup. 	*/
 
+    __atomic_store_n(&CPU_RunningThread, ptcbPosix->thread, __ATOMIC_RELEASE);	/* Direct the ticks to the first task.								*/
+
     OS_Running	= OS_TRUE;													/* Active OS_Running state.												*/
 
-    ERROR_CHECK(sem_post(&ptcbPosix->sem_CtxSW));							/* Active the first task context switch by posting the semaphore value.	*/
+    CPU_HandoffPost(ptcbPosix);												/* Active the first task context switch.								*/
 
 
     														/*     The following code mimics CPU interrupts are enabled and the game of context switch has begun.  		*/
@@ -516,6 +828,69 @@ void OS_CPU_FirstStart (void)
     														/*     Never reaches here, since it has been received a TERM signal like from `kill` or `killall` CLI.		*/
 }
 
+/*
+ * Function:  OS_CPU_TimestampGet
+ * --------------------
+ * Read the monotonic clock of the host.
+ *
+ * Arguments    :   None.
+ *
+ * Returns      :   The monotonic time in nanoseconds.
+ */
+CPU_t64U OS_CPU_TimestampGet (void)
+{
+	struct timespec ts;
+
+	ERROR_CHECK(clock_gettime(CLOCK_MONOTONIC, &ts));
+
+	return (((CPU_t64U)ts.tv_sec * 1000000000ULL) + (CPU_t64U)ts.tv_nsec);
+}
+
+/*
+ * Function:  OS_CPU_TickLatenessGet
+ * --------------------
+ * Get the statistics of the tick lateness.
+ *
+ * Arguments    :   pLateness   is a pointer to the statistics to be filled.
+ *
+ * Returns      :   None.
+ */
+void OS_CPU_TickLatenessGet (CPU_TICK_LATENESS* pLateness)
+{
+	CPU_SR_ALLOC();
+
+	if (pLateness == OS_NULL(CPU_TICK_LATENESS))
+	{
+		return;
+	}
+
+	OS_CRTICAL_BEGIN();														/* Not switched out while holding the lock.								*/
+	ERROR_CHECK(pthread_mutex_lock(&CPU_TickLatenessLock));
+	*pLateness = CPU_TickLateness;
+	ERROR_CHECK(pthread_mutex_unlock(&CPU_TickLatenessLock));
+	OS_CRTICAL_END();
+}
+
+/*
+ * Function:  OS_CPU_TickLatenessReset
+ * --------------------
+ * Clear the statistics of the tick lateness.
+ *
+ * Arguments    :   None.
+ *
+ * Returns      :   None.
+ */
+void OS_CPU_TickLatenessReset (void)
+{
+	CPU_SR_ALLOC();
+
+	OS_CRTICAL_BEGIN();
+	ERROR_CHECK(pthread_mutex_lock(&CPU_TickLatenessLock));
+	memset(&CPU_TickLateness, 0, sizeof(CPU_TickLateness));
+	ERROR_CHECK(pthread_mutex_unlock(&CPU_TickLatenessLock));
+	OS_CRTICAL_END();
+}
+
 /*
 *******************************************************************************
 *                          		Local Functions	   							  *
@@ -523,53 +898,207 @@ void OS_CPU_FirstStart (void)
 */
 
 /*
- * Function:  OS_TaskPosixWrapper
+ * Function:  CPU_TickLatenessRecord
  * --------------------
- * This function works as a generic POSIX task wrapper for prettyOS tasks.
+ * Add a wake up of the timer thread to the tick lateness statistics.
  *
- * Arguments    : p_arg_tcb		is a pointer to the argument of type OS_TASK_TCB* which represent the prettyOS task internal structure.
+ * Arguments    : lateness		is the time in nanoseconds from the tick expiry till the wake up.
+ * 				  missed		is the number of later ticks which have expired too.
  *
- * Returns      : NULL.			If the prettyOS launched task has been returned.
+ * Returns      : None.
  */
-static void* OS_TaskPosixWrapper (void  *p_arg_tcb)
+static void CPU_TickLatenessRecord (CPU_t64U lateness, OS_TICK missed)
 {
-	OS_TCB_POSIX*	ptcbPosix;
-	OS_TASK_TCB*	ptcb;
-	int 			ret;
+	CPU_t32U	bucket;
 
-	__print_debug("[%u] is the  %s() with prio = %d \n",pthread_self(),__FUNCTION__,((OS_TASK_TCB*)p_arg_tcb)->TASK_priority);
+	bucket = 0U;
+	if (lateness > 0U)
+	{
+		bucket = 63U - (CPU_t32U)__builtin_clzll(lateness);				/* floor(log2(lateness))																*/
+		if (bucket >= CPU_CONFIG_TICK_LATENESS_BUCKETS)
+		{
+			bucket = CPU_CONFIG_TICK_LATENESS_BUCKETS - 1U;
+		}
+	}
+
+	ERROR_CHECK(pthread_mutex_lock(&CPU_TickLatenessLock));
+	if ((CPU_TickLateness.ticks == 0U) || (lateness < CPU_TickLateness.min))
+	{
+		CPU_TickLateness.min = lateness;
+	}
+	if (lateness > CPU_TickLateness.max)
+	{
+		CPU_TickLateness.max = lateness;
+	}
+	CPU_TickLateness.sum    += lateness;
+	CPU_TickLateness.missed += missed;
+	++CPU_TickLateness.ticks;
+	++CPU_TickLateness.hist[bucket];
+	ERROR_CHECK(pthread_mutex_unlock(&CPU_TickLatenessLock));
+}
 
-	ptcb		= (OS_TASK_TCB*)p_arg_tcb;
-	ptcbPosix	= (OS_TCB_POSIX*)ptcb->OSTCBExtension;		/* Retrieve the saved TCB POSIX structure.	 															*/
+/*
+ * Function:  CPU_HandoffPost
+ * --------------------
+ * Switch in the thread of a task. The system call is only made if the thread sleeps on its futex word.
+ *
+ * Arguments    : ptcbPosix		is the POSIX structure of the task to be switched in.
+ *
+ * Returns      : None.
+ */
+static void CPU_HandoffPost (OS_TCB_POSIX* ptcbPosix)
+{
+	if (__atomic_exchange_n(&ptcbPosix->futex_CtxSW, CPU_HANDOFF_GO, __ATOMIC_SEQ_CST) == CPU_HANDOFF_SLEEP)
+	{
+		syscall(SYS_futex, &ptcbPosix->futex_CtxSW, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+	}
+}
 
-#ifdef __DEBUG_CPU_PORT
-	ptcbPosix->thread_pid 	= sysconf(SYS_gettid);
-#if(OS_CONFIG_EDF_EN == OS_CONFIG_DISABLE)
-	ptcbPosix->thread_prio 	= ptcb->TASK_priority;
+/*
+ * Function:  CPU_HandoffWait
+ * --------------------
+ * Stop the calling thread till its task is switched in by CPU_HandoffPost().
+ *
+ * Arguments    : ptcbPosix		is the POSIX structure of the calling task.
+ *
+ * Returns      : None.
+ *
+ * Note(s)		: 1) It spins for CPU_CONFIG_POSIX_HANDOFF_SPIN checks first, Then it sleeps on the futex word.
+ * 				  2) A wake up by a signal (EINTR) or by a changed word (EAGAIN) just checks the word again.
+ */
+static void CPU_HandoffWait (OS_TCB_POSIX* ptcbPosix)
+{
+#if (CPU_CONFIG_POSIX_HANDOFF_SPIN > 0U)
+	CPU_t32U	spin;
 #endif
+	CPU_t32U	val;
+
+#if (CPU_CONFIG_POSIX_HANDOFF_SPIN > 0U)
+	for (spin = 0U; spin < CPU_CONFIG_POSIX_HANDOFF_SPIN; ++spin)
+	{
+		if (__atomic_load_n(&ptcbPosix->futex_CtxSW, __ATOMIC_ACQUIRE) == CPU_HANDOFF_GO)
+		{
+			__atomic_store_n(&ptcbPosix->futex_CtxSW, CPU_HANDOFF_WAIT, __ATOMIC_RELAXED);
+			return;
+		}
+	}
 #endif
 
-	ERROR_CHECK(sem_post(&ptcbPosix->sem_TaskCreated));		/* Ends the creation of the task's critical section.													*/
+	for (;;)
+	{
+		val = CPU_HANDOFF_WAIT;											/* Announce the sleep, Unless the task is already switched in.			*/
+		if (!__atomic_compare_exchange_n(&ptcbPosix->futex_CtxSW, &val, CPU_HANDOFF_SLEEP,
+										 OS_FAlSE, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST) && (val == CPU_HANDOFF_GO))
+		{
+			break;
+		}
+		syscall(SYS_futex, &ptcbPosix->futex_CtxSW, FUTEX_WAIT_PRIVATE, CPU_HANDOFF_SLEEP, NULL, NULL, 0);
+	}
 
-	CPU_InterruptDisable();									/* Disable Interrupts for the calling thread till OS starts !											*/
+	__atomic_store_n(&ptcbPosix->futex_CtxSW, CPU_HANDOFF_WAIT, __ATOMIC_RELAXED);
+}
 
-	ret = -1U;
-	while (ret != 0u) {
-		ret = sem_wait(&ptcbPosix->sem_CtxSW);              /* Wait until first context switch is triggered by OS_CPU_FirstStart().                          		*/
-		if (ret != 0 && errno != EINTR) {					/* Continue to wait even if you're interrupted by another system call errno	value.						*/
-			ERROR_CHECK(ret);
-		}
+/*
+ * Function:  CPU_TaskSwitchIn
+ * --------------------
+ * Wait till the task of the calling thread is switched in, Then continue to run it.
+ *
+ * Arguments    : ptcbPosix		is the POSIX structure of the calling thread.
+ *
+ * Returns      : OS_TRUE		if the task is switched in.
+ * 				  OS_FAlSE		if the task is deleted meanwhile, So the thread must go back to its start.
+ *
+ * Note(s)		: 1) Interrupts are disabled during this call. An IRQ which came meanwhile is serviced once the
+ * 					 switched in task enables them.
+ */
+static CPU_t08U CPU_TaskSwitchIn (OS_TCB_POSIX* ptcbPosix)
+{
+	CPU_HandoffWait(ptcbPosix);
+
+	if (__atomic_load_n(&ptcbPosix->futex_Restart, __ATOMIC_SEQ_CST) != 0U)	/* Woken up by OS_CPU_Hook_TaskDeleted() ?								*/
+	{
+		return (OS_FAlSE);
 	}
-    __print_debug("First Entrance: [%d] will enter\n",ptcbPosix->thread_prio);
+
+	return (OS_TRUE);
+}
+
+/*
+ * Function:  CPU_TaskStart
+ * --------------------
+ * The first code of a task on its stack, It's switched to by OS_TaskPosixWrapper().
+ *
+ * Arguments    : None.
+ *
+ * Returns      : None.			Never, The thread leaves the task stack when the task is deleted.
+ */
+static void CPU_TaskStart (void)
+{
+	OS_TASK_TCB*	ptcb;
+
+	ptcb = (OS_TASK_TCB*)OS_currentTask;
+    __print_debug("First Entrance: [%d] will enter\n",((OS_TCB_POSIX*)ptcb->OSTCBExtension)->thread_prio);
+
 	CPU_InterruptEnable();									/* Enable Interrupts for the calling thread for the first context switch.								*/
 															/* Call the real user task.																				*/
 	((void (*)(void *))ptcb->TASK_EntryAddr)(ptcb->TASK_EntryArg);
 #if(OS_CONFIG_EDF_EN == OS_CONFIG_DISABLE)
 	OS_TaskDelete(ptcb->TASK_priority);						/* The task can be ended after its context switch.
-																Internally, it calls OS_TaskDelete_CPU_Hook() which cleans pthread resources.						*/
+																It never returns, The thread leaves the task stack at the switch out.								*/
 #else
 	OS_TaskReturn();										/* This should perform what is necessary to return safely from an EDF Task.								*/
 #endif
+}
+
+/*
+ * Function:  OS_TaskPosixWrapper
+ * --------------------
+ * This function works as a generic POSIX task wrapper for prettyOS tasks. It's the body of every thread of the pool,
+ * Which runs the tasks bound to the thread one after the other, Each on its own stack.
+ *
+ * Arguments    : p_arg			is a pointer to the OS_TCB_POSIX of the thread.
+ *
+ * Returns      : NULL.			Never.
+ */
+static void* OS_TaskPosixWrapper (void  *p_arg)
+{
+	OS_TCB_POSIX*	ptcbPosix;
+	OS_TCB_POSIX*	ptcbPosix_next;
+
+	ptcbPosix	= (OS_TCB_POSIX*)p_arg;
+
+#ifdef __DEBUG_CPU_PORT
+	ptcbPosix->thread_pid 	= sysconf(SYS_gettid);
+#endif
+
+	CPU_InterruptDisable();									/* Disable Interrupts for the calling thread till its task is switched in.								*/
+
+#if (OS_CONFIG_CPU_SOFT_STK_OVERFLOW_DETECTION == OS_CONFIG_ENABLE)
+	CPU_StackGuardThreadInit();								/* The tasks of this thread handle their stack overflow on its alternate stack.							*/
+#endif
+
+	for (;;)
+	{
+		if (CPU_TaskSwitchIn(ptcbPosix) == OS_TRUE)			/* Wait until the first context switch to the task bound to this thread.								*/
+		{
+			ERROR_CHECK(swapcontext(&ptcbPosix->ctx_Thread,		/* Run the task on its stack, The thread comes back here when the task is deleted ...				*/
+									(ucontext_t*)ptcbPosix->ptcb->TASK_SP));
+		}
+		CPU_IntNesting = 1U;								/* ... With the interrupts still disabled, The critical sections of the task are left behind.			*/
+		ptcbPosix_next = ptcbPosix->pSwitchTo;
+		if (ptcbPosix_next != OS_NULL(OS_TCB_POSIX))		/* Deleted itself, Switch in the next task now the task stack is left.									*/
+		{
+			ptcbPosix->pSwitchTo = OS_NULL(OS_TCB_POSIX);
+			CPU_HandoffPost(ptcbPosix_next);
+		}
+
+		if (__atomic_load_n(&ptcbPosix->futex_Restart, __ATOMIC_SEQ_CST) != 0U)
+		{
+			__atomic_store_n(&ptcbPosix->futex_Restart, 0U, __ATOMIC_SEQ_CST);
+			syscall(SYS_futex, &ptcbPosix->futex_Restart, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);	/* Resume the deleting task.							*/
+		}
+	}
+
 	return NULL;
 }
 
@@ -582,9 +1111,15 @@ static void* OS_TaskPosixWrapper (void  *p_arg_tcb)
  *
  * Returns      : NULL.
  */
+#if (OS_CONFIG_TICKLESS_EN == OS_CONFIG_ENABLE)
 static void* CPU_TaskPosixTimerInterrupt (void  *p_arg)
 {
-    struct  timespec    tspec, tspec_rem;
+    struct  timespec    tspec;
+    CPU_t64U            start_ns;
+    CPU_t64U            expiry_ns;
+    CPU_t64U            elapsed;
+    OS_TICK             target;
+    OS_TICK             expiry;
     int                 res;
 
     (void)p_arg;																 /* Not used																		*/
@@ -593,41 +1128,92 @@ static void* CPU_TaskPosixTimerInterrupt (void  *p_arg)
 
     CPU_InterruptDisable();														 /* Disable CPU interrupts for this thread.											*/
 
-    tspec.tv_nsec = (1000*1000*1000)/OS_CONFIG_TICKS_PER_SEC;					 /* Regardless the CPU frequency, This simple formula gets the right periodic interval
-     	 	 	 	 	 	 	 	 	 	 	 	 	 	 	 	 	 	 	 	for this POSIX thread to sleep and fire the system timer interrupt handler at
-     	 	 	 	 	 	 	 	 	 	 	 	 	 	 	 	 	 	 	 	the end of the period.
-     	 	 	 	 	 	 	 	 	 	 	 	 	 	 	 	 	 	 	 	For OS_TICKS_PER_SEC = 100, gives a timer interrupt every 10 milliseconds.
-     	 	 	 	 	 	 	 	 	 	 	 	 	 	 	 	 	 	 	 	The math prove:
-     	 	 	 	 	 	 	 	 	 	 	 	 	 	 	 	 	 	 	 	Timer_Load_Value = F_CPU/tickRate, tickRate is OS_TICKS_PER_SEC
-     	 	 	 	 	 	 	 	 	 	 	 	 	 	 	 	 	 	 	 	fire_time = Timer_Load_Value/F_CPU = 1/tickRate seconds. = 10^9/tickRate ns.	*/
-    tspec.tv_sec  = 0U;
+    ERROR_CHECK(clock_gettime(CLOCK_MONOTONIC, &tspec));						 /* All the expiries are absolute times from this start time.						*/
+    start_ns = ((CPU_t64U)tspec.tv_sec * 1000000000ULL) + (CPU_t64U)tspec.tv_nsec;
+    elapsed  = 0U;
 
     do {
-    	tspec_rem = tspec;
+    	target = CPU_TickCount + 1U;											/* By default, fire at the next tick ...											*/
+    	expiry = __atomic_load_n(&CPU_TickNextExpiry, __ATOMIC_SEQ_CST);
+    	if ((CPU_t32S)(expiry - target) > 0) {									/* ... or at the next expiry if the idle task asked to suppress the ticks.			*/
+    		target = expiry;
+    	}
+
+    	elapsed  += (OS_TICK)(target - CPU_TickCount);
+    	expiry_ns = start_ns + (elapsed * (1000000000ULL / OS_CONFIG_TICKS_PER_SEC));
+    	tspec.tv_sec  = (time_t)(expiry_ns / 1000000000ULL);
+    	tspec.tv_nsec = (long)(expiry_ns % 1000000000ULL);
 
     	do {
-    		res = clock_nanosleep(CLOCK_MONOTONIC, 0u, &tspec_rem, &tspec_rem);	/* Wait for the specified time from now by using  CLOCK_MONOTONIC					*/
-    		/*
-    		 * Quoted from : https://man7.org/linux/man-pages/man2/clock_nanosleep.2.html
-    		 *
-    		 * "clock_nanosleep() suspends the execution of the calling thread until either at least the
-    		 * time specified by request has elapsed, or a signal is delivered that causes a signal handler
-    		 * to be called or that terminates the process.
-    		 *
-    		 * If the call is interrupted by a signal handler, clock_nanosleep() fails with the error EINTR.
-        	 * In addition, if remain is not NULL, and flags was not TIMER_ABSTIME, it returns the remaining
-        	 * unslept time in remain.  This value can then be used to call clock_nanosleep() again and complete a (relative) sleep."
-        	 *
-        	 * */
-
-    	} while (res == EINTR);													/* If you get interrupt by a system call, continue to wait for the remaining time.	*/
+    		res = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &tspec, NULL);	/* Sleep until the absolute expiry time, No drift if interrupted.				*/
+    	} while (res == EINTR);
+
+    	if (res != 0U)															/* Raise abort signal if unexpected return is found.								*/
+    	{
+    		raise(SIGABRT);
+    	}
+
+    	CPU_TickLatenessRecord(OS_CPU_TimestampGet() - expiry_ns, 0U);		/* A late wake up is caught up by the next expiry which is already past.			*/
+
+    	__atomic_add_fetch(&CPU_TickPending, (OS_TICK)(target - CPU_TickCount), __ATOMIC_SEQ_CST);
+    	__atomic_store_n(&CPU_TickCount, target, __ATOMIC_SEQ_CST);
+
+    	CPU_IRQ_TimerInterruptTrigger();										/* Trigger the required action for timer fires.										*/
+
+    } while (1);																/* Forever loop to acts as a multi shot timer.										*/
+
+    pthread_exit(NULL);															/* EXIT in case of unexpected behavior.												*/
+
+    return (NULL);																/* Should never return !															*/
+}
+#else
+static void* CPU_TaskPosixTimerInterrupt (void  *p_arg)
+{
+    struct  timespec    tspec;
+    CPU_t64U            start_ns;
+    CPU_t64U            expiry_ns;
+    CPU_t64U            now_ns;
+    CPU_t64U            tick;
+    OS_TICK             elapsed;
+    int                 res;
+
+    (void)p_arg;																 /* Not used																		*/
+
+    __print_debug("[%u] is the  %s() \n",pthread_self(),__FUNCTION__);
+
+    CPU_InterruptDisable();														 /* Disable CPU interrupts for this thread.											*/
+
+    start_ns = OS_CPU_TimestampGet();											 /* All the expiries are absolute times from this start time, So the time spent
+    																				between two sleeps (scheduling, signaling, ...) never accumulates as a drift.
+    																				For OS_TICKS_PER_SEC = 100, The n'th tick fires at start + n * 10 milliseconds.	*/
+    tick     = 1U;
 
+    do {
+    	expiry_ns     = start_ns + ((tick * 1000000000ULL) / OS_CONFIG_TICKS_PER_SEC);
+    	tspec.tv_sec  = (time_t)(expiry_ns / 1000000000ULL);
+    	tspec.tv_nsec = (long)(expiry_ns % 1000000000ULL);
+
+    	do {
+    		res = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &tspec, NULL);	/* Sleep until the absolute expiry time, Just sleep again if interrupted.		*/
+    	} while (res == EINTR);
 
     	if (res != 0U)															/* Raise abort signal if unexpected return is found.								*/
     	{
     		raise(SIGABRT);
     	}
 
+    	now_ns  = OS_CPU_TimestampGet();
+    	elapsed = 1U;
+    	while ((start_ns + (((tick + elapsed) * 1000000000ULL) / OS_CONFIG_TICKS_PER_SEC)) <= now_ns)
+    	{
+    		++elapsed;															/* The thread woke up too late, The next ticks have expired too.					*/
+    	}
+
+    	CPU_TickLatenessRecord(now_ns - expiry_ns, elapsed - 1U);
+    	tick += elapsed;
+
+    	__atomic_add_fetch(&CPU_TickPending, elapsed, __ATOMIC_SEQ_CST);		/* The missed ticks are announced with this one, Not lost.							*/
+
     	CPU_IRQ_TimerInterruptTrigger();										/* Trigger the required action for timer fires.										*/
 
     } while (1);																/* Forever loop to acts as a multi shot timer.										*/
@@ -636,3 +1222,6 @@ static void* CPU_TaskPosixTimerInterrupt (void  *p_arg)
 
     return (NULL);																/* Should never return !															*/
 }
+#endif
+
+#endif	/* CPU_CONFIG_POSIX_ENGINE == CPU_POSIX_ENGINE_PTHREAD */
@@ -0,0 +1,491 @@
+/*****************************************************************************
+MIT License
+
+Copyright (c) 2020 Yahia Farghaly Ashour
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+
+/*
+ * Author   : Yahia Farghaly Ashour
+ *
+ * Purpose  : POSIX Port, The task stacks which are shared by both execution engines.
+ *
+ *            - A task stack which is too small for the host is replaced by a host stack.
+ *            - If OS_CONFIG_CPU_SOFT_STK_OVERFLOW_DETECTION is enabled, The lowest page of each task stack is protected
+ *              by mprotect(). A task which overflows its stack faults on that page, And the SIGSEGV handler reports the
+ *              task to OS_StackOverflow_Detected(). Nothing is checked at the context switch.
+ *
+ * Language:  C
+ */
+
+/*
+*******************************************************************************
+*                               Includes Files                                *
+*******************************************************************************
+*/
+
+#ifndef _XOPEN_SOURCE
+	#define _XOPEN_SOURCE	600
+#endif
+
+#include  <stdio.h>
+#include  <stdint.h>
+#include  <stdlib.h>
+#include  <signal.h>
+#include  <unistd.h>
+#include  <sys/mman.h>
+#include "pretty_arch.h"
+#include "../../../../kernel/pretty_os.h"
+
+/*
+*******************************************************************************
+*                               Local Macros                                  *
+*******************************************************************************
+*/
+
+#define CPU_STACK_ALTSTACK_BYTES	(65536U)		/* The stack of the SIGSEGV handler, The overflow hooks run on it.				*/
+
+/*
+*******************************************************************************
+*                               Local Structures                              *
+*******************************************************************************
+*/
+
+typedef struct cpu_stack_map	CPU_STACK_MAP;
+
+struct cpu_stack_map
+{
+	CPU_tSTK*	pUserStack;							/* The stack base passed to OS_TaskCreate() which is too small for the host.	*/
+	void*		pHostStack;							/* Its replacement of CPU_CONFIG_TASK_STACK_MIN_BYTES, Kept for the next task.	*/
+};
+
+#if (OS_CONFIG_CPU_SOFT_STK_OVERFLOW_DETECTION == OS_CONFIG_ENABLE)
+
+typedef struct cpu_stack_guard	CPU_STACK_GUARD;
+
+struct cpu_stack_guard
+{
+	CPU_tSTK*		pUserStack;						/* The stack base passed to OS_TaskCreate(), NULL => A free entry.				*/
+	CPU_t08U*		pGuard;							/* The protected page at the bottom of the stack (or of its host stack).		*/
+	OS_TASK_TCB*	ptcb;							/* The task on the stack, Bound once it's created.								*/
+};
+
+#endif
+
+/*
+*******************************************************************************
+*                              Local Variables                                *
+*******************************************************************************
+*/
+
+static  CPU_STACK_MAP		CPU_StackMap [OS_CONFIG_TASK_COUNT];	/* The host stacks which replace the too small task stacks.				*/
+
+#if (OS_CONFIG_CPU_SOFT_STK_OVERFLOW_DETECTION == OS_CONFIG_ENABLE)
+static  CPU_STACK_GUARD		CPU_StackGuards [OS_CONFIG_TASK_COUNT];	/* The guard page of every task stack.									*/
+#endif
+
+/*
+*******************************************************************************
+*                           Local Function Prototypes                         *
+*******************************************************************************
+*/
+
+static uintptr_t CPU_PageSizeGet (void);
+
+#if (OS_CONFIG_CPU_SOFT_STK_OVERFLOW_DETECTION == OS_CONFIG_ENABLE)
+extern void OS_StackOverflow_Detected (void* ptcb);
+void        CPU_StackGuardThreadInit  (void);
+
+static void CPU_StackGuardHandler (int sig, siginfo_t* info, void* context);
+static void CPU_StackGuardRemove  (CPU_STACK_GUARD* pguard);
+#endif
+
+/*
+*******************************************************************************
+*                          		Local Functions	   							  *
+*******************************************************************************
+*/
+
+/*
+ * Function:  CPU_PageSizeGet
+ * --------------------
+ * Get the page size of the host.
+ *
+ * Arguments    : None.
+ *
+ * Returns      : The page size in bytes.
+ */
+static uintptr_t CPU_PageSizeGet (void)
+{
+	static uintptr_t	page;
+
+	if (page == 0U)
+	{
+		page = (uintptr_t)sysconf(_SC_PAGESIZE);
+	}
+
+	return (page);
+}
+
+#if (OS_CONFIG_CPU_SOFT_STK_OVERFLOW_DETECTION == OS_CONFIG_ENABLE)
+
+/*
+ * Function:  CPU_StackGuardHandler
+ * --------------------
+ * The SIGSEGV handler. A fault on the guard page of a task is reported as a stack overflow of the task.
+ *
+ * Arguments    : sig			is SIGSEGV.
+ * 				  info			holds the faulting address.
+ * 				  context		(not used)
+ *
+ * Returns      : None.			Never for a stack overflow.
+ *
+ * Note(s)		: 1) It runs on the alternate signal stack as the task stack is exhausted, With all the signals
+ * 					 blocked. So the ticks stop as on a target which stays in its fault handler.
+ * 				  2) Any other fault gets the default action of SIGSEGV when the faulting instruction is executed again.
+ */
+static void CPU_StackGuardHandler (int sig, siginfo_t* info, void* context)
+{
+	uintptr_t	addr;
+	uintptr_t	page;
+	CPU_t32U	idx;
+
+	(void)context;
+
+	addr = (uintptr_t)info->si_addr;
+	page = CPU_PageSizeGet();
+
+	for (idx = 0U; idx < OS_CONFIG_TASK_COUNT; ++idx)
+	{
+		if ((CPU_StackGuards[idx].ptcb != OS_NULL(OS_TASK_TCB))   &&
+			(addr >= (uintptr_t)CPU_StackGuards[idx].pGuard)      &&
+			(addr <  (uintptr_t)CPU_StackGuards[idx].pGuard + page))
+		{
+			OS_StackOverflow_Detected(CPU_StackGuards[idx].ptcb);		/* Never returns.														*/
+		}
+	}
+
+	signal(sig, SIG_DFL);												/* Not a stack overflow, Crash as usual.								*/
+}
+
+/*
+ * Function:  CPU_StackGuardRemove
+ * --------------------
+ * Make the guard page accessible again and free its entry.
+ *
+ * Arguments    : pguard		is the entry of the guard.
+ *
+ * Returns      : None.
+ */
+static void CPU_StackGuardRemove (CPU_STACK_GUARD* pguard)
+{
+	if (mprotect((void*)pguard->pGuard, (size_t)CPU_PageSizeGet(), PROT_READ | PROT_WRITE) != 0)
+	{
+		perror("mprotect()");
+		raise(SIGABRT);
+	}
+	pguard->pUserStack = OS_NULL(CPU_tSTK);
+	pguard->ptcb       = OS_NULL(OS_TASK_TCB);
+}
+
+#endif
+
+/*
+*******************************************************************************
+*                          		Port Functions	   							  *
+*******************************************************************************
+*/
+
+/*
+ * Function:  CPU_HostStackGet
+ * --------------------
+ * Get a stack of CPU_CONFIG_TASK_STACK_MIN_BYTES in place of a too small task stack.
+ *
+ * Arguments    : pStackBase	is the task stack passed to OS_TaskCreate().
+ *
+ * Returns      : The bottom of the host stack.
+ *
+ * Note(s)		: 1) The same host stack is returned for the same task stack, So the tasks which are created again
+ * 					 on the stack of a deleted task (or restarted after an overrun) don't allocate anymore.
+ * 				  2) The host stack is page aligned, So its guard page (if any) is its first page.
+ */
+void* CPU_HostStackGet (CPU_tSTK* pStackBase)
+{
+	CPU_STACK_MAP*	pmap;
+	void*			pHostStack;
+	CPU_t32U		idx;
+
+	pmap = OS_NULL(CPU_STACK_MAP);
+	for (idx = 0U; idx < OS_CONFIG_TASK_COUNT; ++idx)
+	{
+		if (CPU_StackMap[idx].pUserStack == pStackBase)
+		{
+			return (CPU_StackMap[idx].pHostStack);						/* Already replaced.																	*/
+		}
+		if ((pmap == OS_NULL(CPU_STACK_MAP)) && (CPU_StackMap[idx].pUserStack == OS_NULL(CPU_tSTK)))
+		{
+			pmap = &CPU_StackMap[idx];									/* The first free entry.																*/
+		}
+	}
+
+	pHostStack = OS_NULL(void);
+	if (posix_memalign(&pHostStack, (size_t)CPU_PageSizeGet(), CPU_CONFIG_TASK_STACK_MIN_BYTES) != 0)
+	{
+		printf("Cannot Allocate a host stack for the task\n");
+		raise(SIGABRT);
+	}
+
+	if (pmap != OS_NULL(CPU_STACK_MAP))									/* If the map is full, It's not kept and never freed.									*/
+	{
+		pmap->pUserStack = pStackBase;
+		pmap->pHostStack = pHostStack;
+	}
+
+	return (pHostStack);
+}
+
+#if (OS_CONFIG_TASK_STACK_USAGE_EN == OS_CONFIG_ENABLE)
+
+/*
+ * Function:  CPU_StackRegionSet
+ * --------------------
+ * Point the measured stack of a task to the stack which the task runs on, So the kernel paints and scans that one.
+ *
+ * Arguments    : ptcb			is the task being created.
+ *
+ * Returns      : None.
+ *
+ * Note(s)		: 1) It's called by OS_CPU_Hook_TaskCreated(), After the guard (if any) is bound to the task.
+ * 				  2) A too small task stack is replaced by its host stack, The guard page and the pages below it
+ * 					 are excluded as the task never runs on them.
+ */
+void CPU_StackRegionSet (OS_TASK_TCB* ptcb)
+{
+	uintptr_t	bottom;
+	uintptr_t	top;
+#if (OS_CONFIG_CPU_SOFT_STK_OVERFLOW_DETECTION == OS_CONFIG_ENABLE)
+	CPU_t32U	idx;
+#endif
+
+	bottom = (uintptr_t)ptcb->TASK_StkUsageBase;
+	top    = bottom + ptcb->TASK_StkUsageWords * sizeof(CPU_tSTK);
+	if (ptcb->TASK_StkUsageWords * sizeof(CPU_tSTK) < CPU_CONFIG_TASK_STACK_MIN_BYTES)
+	{
+		bottom = (uintptr_t)CPU_HostStackGet(ptcb->TASK_StkUsageBase);
+		top    = bottom + CPU_CONFIG_TASK_STACK_MIN_BYTES;
+	}
+
+#if (OS_CONFIG_CPU_SOFT_STK_OVERFLOW_DETECTION == OS_CONFIG_ENABLE)
+	for (idx = 0U; idx < OS_CONFIG_TASK_COUNT; ++idx)
+	{
+		if (CPU_StackGuards[idx].ptcb == ptcb)
+		{
+			bottom = (uintptr_t)CPU_StackGuards[idx].pGuard + CPU_PageSizeGet();
+			break;
+		}
+	}
+#endif
+
+	bottom = (bottom + sizeof(CPU_tSTK) - 1U) & ~(uintptr_t)(sizeof(CPU_tSTK) - 1U);
+	ptcb->TASK_StkUsageBase  = (CPU_tSTK*)bottom;
+	ptcb->TASK_StkUsageWords = (CPU_tSTK_SIZE)((top - bottom) / sizeof(CPU_tSTK));
+}
+
+#endif
+
+#if (OS_CONFIG_CPU_SOFT_STK_OVERFLOW_DETECTION == OS_CONFIG_ENABLE)
+
+/*
+ * Function:  CPU_StackGuardInit
+ * --------------------
+ * Install the SIGSEGV handler which detects the stack overflows, And the alternate signal stack of the calling thread.
+ *
+ * Arguments    : None.
+ *
+ * Returns      : None.
+ *
+ * Note(s)		: 1) It's called once by OS_CPU_Hook_Init().
+ */
+void CPU_StackGuardInit (void)
+{
+	struct sigaction	sa;
+
+	sa.sa_sigaction = CPU_StackGuardHandler;
+	sa.sa_flags     = SA_SIGINFO | SA_ONSTACK;
+	sigfillset(&sa.sa_mask);
+	if (sigaction(SIGSEGV, &sa, NULL) != 0)
+	{
+		perror("sigaction(SIGSEGV)");
+		raise(SIGABRT);
+	}
+
+	CPU_StackGuardThreadInit();
+}
+
+/*
+ * Function:  CPU_StackGuardThreadInit
+ * --------------------
+ * Give the calling thread an alternate signal stack, The SIGSEGV handler can't run on the overflowed task stack.
+ *
+ * Arguments    : None.
+ *
+ * Returns      : None.
+ *
+ * Note(s)		: 1) Every thread which runs tasks must call it once, Since the alternate stack is per thread.
+ */
+void CPU_StackGuardThreadInit (void)
+{
+	stack_t	ss;
+
+	ss.ss_sp    = malloc(CPU_STACK_ALTSTACK_BYTES);
+	ss.ss_size  = CPU_STACK_ALTSTACK_BYTES;
+	ss.ss_flags = 0;
+	if ((ss.ss_sp == NULL) || (sigaltstack(&ss, NULL) != 0))
+	{
+		perror("sigaltstack()");
+		raise(SIGABRT);
+	}
+}
+
+/*
+ * Function:  CPU_StackGuardSet
+ * --------------------
+ * Protect the lowest whole page of a task stack.
+ *
+ * Arguments    : pStackBase	is the task stack passed to OS_TaskCreate(), It identifies the guard.
+ * 				  pBottom		is the bottom of the stack which the task runs on (pStackBase or its host stack).
+ * 				  stackSize		is the size of that stack in bytes.
+ *
+ * Returns      : The new bottom of the stack above the guard page, Or pBottom if the stack gets no guard.
+ *
+ * Note(s)		: 1) The task has up to two pages less than stackSize, The ones below the guard aren't used.
+ * 				  2) A stack which is initialized again (e.g. a task created on the stack of a deleted one) keeps its entry.
+ * 				  3) The stack gets no guard if it's smaller than two pages or if all the entries are taken.
+ */
+CPU_t08U* CPU_StackGuardSet (CPU_tSTK* pStackBase, CPU_t08U* pBottom, CPU_tSTK_SIZE stackSize)
+{
+	CPU_STACK_GUARD*	pguard;
+	uintptr_t			page;
+	uintptr_t			guard;
+	CPU_t32U			idx;
+
+	page  = CPU_PageSizeGet();
+	guard = ((uintptr_t)pBottom + page - 1U) & ~(page - 1U);			/* The first page which is wholly in the stack.											*/
+	if (guard + 2U * page > (uintptr_t)pBottom + stackSize)
+	{
+		return (pBottom);
+	}
+
+	pguard = OS_NULL(CPU_STACK_GUARD);
+	for (idx = 0U; idx < OS_CONFIG_TASK_COUNT; ++idx)
+	{
+		if (CPU_StackGuards[idx].pUserStack == pStackBase)
+		{
+			pguard = &CPU_StackGuards[idx];								/* Initialized again, e.g. an aborted job.												*/
+			break;
+		}
+		if ((pguard == OS_NULL(CPU_STACK_GUARD)) && (CPU_StackGuards[idx].pUserStack == OS_NULL(CPU_tSTK)))
+		{
+			pguard = &CPU_StackGuards[idx];
+		}
+	}
+
+	if (pguard == OS_NULL(CPU_STACK_GUARD))
+	{
+		return (pBottom);
+	}
+
+	if (mprotect((void*)guard, (size_t)page, PROT_NONE) != 0)
+	{
+		perror("mprotect()");
+		raise(SIGABRT);
+	}
+
+	pguard->pUserStack = pStackBase;
+	pguard->pGuard     = (CPU_t08U*)guard;
+
+	return ((CPU_t08U*)(guard + page));
+}
+
+/*
+ * Function:  CPU_StackGuardBind
+ * --------------------
+ * Bind the guard of a task stack to the task, So an overflow is reported with its TCB.
+ *
+ * Arguments    : ptcb			is the task being created.
+ *
+ * Returns      : None.
+ *
+ * Note(s)		: 1) It's called by OS_CPU_Hook_TaskCreated(), After the task stack is initialized.
+ * 				  2) The other unbound guards are left by the creations which failed after the stack initialization,
+ * 					 So they are removed.
+ */
+void CPU_StackGuardBind (OS_TASK_TCB* ptcb)
+{
+	CPU_t32U	idx;
+
+	for (idx = 0U; idx < OS_CONFIG_TASK_COUNT; ++idx)
+	{
+		if (CPU_StackGuards[idx].pUserStack == (CPU_tSTK*)ptcb->TASK_SP_Limit)
+		{
+			CPU_StackGuards[idx].ptcb = ptcb;
+		}
+		else if ((CPU_StackGuards[idx].pUserStack != OS_NULL(CPU_tSTK)) &&
+				 (CPU_StackGuards[idx].ptcb == OS_NULL(OS_TASK_TCB)))
+		{
+			CPU_StackGuardRemove(&CPU_StackGuards[idx]);
+		}
+	}
+}
+
+/*
+ * Function:  CPU_StackGuardRelease
+ * --------------------
+ * Remove the guard of a task stack, So the application may use the stack memory for something else.
+ *
+ * Arguments    : ptcb			is the task being deleted.
+ *
+ * Returns      : None.
+ *
+ * Note(s)		: 1) It's called by OS_CPU_Hook_TaskDeleted().
+ */
+void CPU_StackGuardRelease (OS_TASK_TCB* ptcb)
+{
+	CPU_t32U	idx;
+
+	for (idx = 0U; idx < OS_CONFIG_TASK_COUNT; ++idx)
+	{
+		if (CPU_StackGuards[idx].ptcb == ptcb)
+		{
+			CPU_StackGuardRemove(&CPU_StackGuards[idx]);
+			return;
+		}
+	}
+}
+
+#if (OS_CONFIG_CPU_STACK_OVERFLOW == OS_CONFIG_ENABLE)
+void OS_CPU_Hook_StackOverflow_Detected (void)
+{
+	/* You may abort the process here.							*/
+}
+#endif
+
+#endif	/* OS_CONFIG_CPU_SOFT_STK_OVERFLOW_DETECTION == OS_CONFIG_ENABLE */
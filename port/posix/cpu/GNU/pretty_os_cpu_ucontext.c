@@ -0,0 +1,780 @@
+/*****************************************************************************
+MIT License
+
+Copyright (c) 2020 Yahia Farghaly Ashour
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+/*
+ * Author   : Yahia Farghaly Ashour
+ *
+ * Purpose  : POSIX Port, The single thread (ucontext) execution engine.
+ *
+ *            All the tasks run on the main thread of the process, Each one on the stack which is passed to OS_TaskCreate().
+ *            A context switch only exchanges the stack pointer and the callee-saved registers in user space, Like the
+ *            PendSV handler of a Cortex-M does. So it costs tens of nanoseconds and the tasks interleave the same way
+ *            on every run, Only the tick arrivals depend on the host.
+ *
+ *            - The tick is a POSIX timer which sends CPU_IRQ_SIG to the process every 1/OS_CONFIG_TICKS_PER_SEC.
+ *            - The interrupts are masked by a software flag (CPU_CRITICAL_METHOD_LOCAL). A tick which comes while the
+ *              interrupts are disabled is kept pending and serviced when they are enabled again, So the critical
+ *              sections are free of system calls.
+ *            - The tick ISR switches the task directly from the signal handler. The preempted task resumes inside the
+ *              handler and returns from it to where it was interrupted.
+ *
+ * Note(s)	: 1) Selected by CPU_CONFIG_POSIX_ENGINE = CPU_POSIX_ENGINE_UCONTEXT in pretty_arch.h, Else this file is empty.
+ *            2) The host library (stdio, malloc, ...) is not re-entrant with respect to the task preemption, As on a single
+ *               thread nothing serializes it. The tasks which share it should serialize its calls by OS_SchedLock()/OS_SchedUnlock()
+ *               or a mutex, The same as a shared UART driver on a real target.
+ *            3) OS_CONFIG_TICKLESS_EN is not supported by this engine.
+ *
+ * Language:  C
+ */
+
+/*
+*******************************************************************************
+*                               Includes Files                                *
+*******************************************************************************
+*/
+
+#ifndef _XOPEN_SOURCE
+	#define _XOPEN_SOURCE	600
+#endif
+
+#include  <stdio.h>
+#include  <stdint.h>
+#include  <stdlib.h>
+#include  <string.h>
+#include  <signal.h>
+#include  <time.h>
+#include  <errno.h>
+#include  <ucontext.h>
+#include "pretty_arch.h"
+#include "../../../../kernel/pretty_os.h"
+
+#if (CPU_CONFIG_POSIX_ENGINE == CPU_POSIX_ENGINE_UCONTEXT)
+
+#if (OS_CONFIG_TICKLESS_EN == OS_CONFIG_ENABLE)
+#error  "OS_CONFIG_TICKLESS_EN is not supported by the ucontext engine of the POSIX port"
+#endif
+
+/*
+*******************************************************************************
+*                               Extern Variables	                          *
+*******************************************************************************
+*/
+
+extern CPU_tWORD    volatile        OS_Running;
+extern OS_TASK_TCB* volatile        OS_currentTask;
+extern OS_TASK_TCB* volatile        OS_nextTask;
+
+/*
+*******************************************************************************
+*                          Extern Function Prototypes	                      *
+*******************************************************************************
+*/
+
+extern void OS_TaskReturn (void);
+extern void OS_TimerTick  (void);
+extern void OS_IntEnter   (void);
+extern void OS_IntExit    (void);
+
+extern void*     CPU_HostStackGet (CPU_tSTK* pStackBase);				/* See pretty_os_cpu_stack.c.	*/
+#if (OS_CONFIG_CPU_SOFT_STK_OVERFLOW_DETECTION == OS_CONFIG_ENABLE)
+extern void      CPU_StackGuardInit       (void);
+extern void      CPU_StackGuardThreadInit (void);
+extern CPU_t08U* CPU_StackGuardSet        (CPU_tSTK* pStackBase, CPU_t08U* pBottom, CPU_tSTK_SIZE stackSize);
+extern void      CPU_StackGuardBind       (OS_TASK_TCB* ptcb);
+extern void      CPU_StackGuardRelease    (OS_TASK_TCB* ptcb);
+#endif
+#if (OS_CONFIG_TASK_STACK_USAGE_EN == OS_CONFIG_ENABLE)
+extern void      CPU_StackRegionSet       (OS_TASK_TCB* ptcb);
+#endif
+
+/*
+*******************************************************************************
+*                               Local Macros                                  *
+*******************************************************************************
+*/
+
+													/* A common macro to terminate in case if error is returned.									*/
+#define ERROR_CHECK(func)      do {	int res = func; \
+									if (res != 0u) { \
+										printf("Error in call '%s' from %s(): %s\r\n", #func, __FUNCTION__, strerror(res)); \
+										perror("'errno' indicates "); \
+										raise(SIGABRT); \
+									} \
+								} while(0)
+
+#define CPU_IRQ_SIG        	  (SIGURG) 				/* Urgent data POSIX signal to be used as the tick IRQ, It's ignored by default.				*/
+
+#if (defined(__x86_64__) && (CPU_CONFIG_UCONTEXT_SWITCH_ASM == 1U))
+	#define CPU_SWITCH_ASM		(1U)				/* Switch by CPU_ContextSwap().																	*/
+#else
+	#define CPU_SWITCH_ASM		(0U)				/* Switch by swapcontext().																		*/
+#endif
+
+/*
+*******************************************************************************
+*                              Local Variables                                *
+*******************************************************************************
+*/
+
+static  sigset_t              		CPU_IRQ_SigSet;		/* The set which contains the signal we which to capture as a CPU IRQ.						*/
+static  timer_t						CPU_Timer;			/* The POSIX timer of the system tick.														*/
+
+static  volatile sig_atomic_t		CPU_IntDisabled = 1;/* The software interrupt mask, Interrupts are disabled till the first task runs.			*/
+static  volatile CPU_t32U			CPU_IntPending;		/* Number of ticks which came but are not serviced yet.										*/
+
+static  CPU_t64U					CPU_TickStart;		/* The absolute time of the tick number zero.												*/
+static  CPU_t64U					CPU_TickCount;		/* Number of ticks which came, Including the merged ones.									*/
+static  CPU_TICK_LATENESS			CPU_TickLateness;	/* Updated by the signal handler only.														*/
+
+#if (CPU_SWITCH_ASM == 1U)
+static  void*						CPU_MainSP;			/* The stack pointer of main() which is switched out by OS_CPU_FirstStart().				*/
+#else
+static  ucontext_t					CPU_MainContext;	/* The context of main() which is switched out by OS_CPU_FirstStart().						*/
+#endif
+
+/*
+*******************************************************************************
+*                           Local Function Prototypes                         *
+*******************************************************************************
+*/
+
+static void  CPU_IRQ_Handler  (int sig);
+static void  CPU_IRQ_Dispatch (void);
+static void  CPU_TickLatenessRecord (CPU_t64U lateness, CPU_t64U missed);
+static void  CPU_ContextSwitch(void);
+#if (CPU_SWITCH_ASM == 0U)
+static void  CPU_TaskContextMake (ucontext_t* puc, CPU_t08U* pBottom);
+#endif
+
+void  CPU_TaskStart (void);							/* Not static since it's called from the switch code.											*/
+
+#if (CPU_SWITCH_ASM == 1U)
+void  CPU_ContextSwap (void** ppSaveSP, void* pLoadSP);
+void  CPU_TaskEntry   (void);
+#endif
+
+/*
+*******************************************************************************
+*                              Context Switch Code                            *
+*******************************************************************************
+*/
+
+#if (CPU_SWITCH_ASM == 1U)
+/*
+ * Function:  CPU_ContextSwap
+ * --------------------------------
+ * Save the callee-saved registers of the caller on its stack, Store its stack pointer at *ppSaveSP,
+ * Then load pLoadSP and pop the registers of the switched-in task.
+ * The caller-saved registers are already saved by the compiler at the call, As for any function.
+ *
+ * Arguments:	ppSaveSP	is where to save the stack pointer of the switched-out task.
+ * 				pLoadSP		is the saved stack pointer of the switched-in task.
+ *
+ * Function:  CPU_TaskEntry
+ * --------------------------------
+ * The first return address of a task which is set by OS_CPU_TaskStackInit(). It calls CPU_TaskStart() on the
+ * task stack with the ABI stack alignment.
+ */
+__asm__ (
+	"	.text								\n"
+	"	.globl	CPU_ContextSwap				\n"
+	"	.type	CPU_ContextSwap, @function	\n"
+	"CPU_ContextSwap:						\n"
+	"	pushq	%rbp						\n"
+	"	pushq	%rbx						\n"
+	"	pushq	%r12						\n"
+	"	pushq	%r13						\n"
+	"	pushq	%r14						\n"
+	"	pushq	%r15						\n"
+	"	movq	%rsp, (%rdi)				\n"		/* Save SP of the switched-out task.						*/
+	"	movq	%rsi, %rsp					\n"		/* Load SP of the switched-in task.							*/
+	"	popq	%r15						\n"
+	"	popq	%r14						\n"
+	"	popq	%r13						\n"
+	"	popq	%r12						\n"
+	"	popq	%rbx						\n"
+	"	popq	%rbp						\n"
+	"	ret									\n"
+	"	.size	CPU_ContextSwap, .-CPU_ContextSwap	\n"
+	"										\n"
+	"	.globl	CPU_TaskEntry				\n"
+	"	.type	CPU_TaskEntry, @function	\n"
+	"CPU_TaskEntry:							\n"
+	"	call	CPU_TaskStart@PLT			\n"
+	"	ud2									\n"		/* CPU_TaskStart() never returns.							*/
+	"	.size	CPU_TaskEntry, .-CPU_TaskEntry	\n"
+);
+#endif
+
+/*
+*******************************************************************************
+*                         Critical Section Functions	   					  *
+*******************************************************************************
+*/
+
+/*
+ * Function:  CPU_InterruptInit
+ * --------------------------------
+ * Connect the tick signal to its handler.
+ *
+ * Note(s)	:	1)	SA_NODEFER keeps the signal deliverable after the handler switched to another task,
+ * 					Since the handler of the preempted task only returns when it's switched in again.
+ * 				2)	SA_RESTART resumes the system calls of the tasks which are interrupted by a tick.
+ */
+void CPU_InterruptInit (void)
+{
+    struct sigaction sig_action_trigger;
+
+    sigemptyset(&CPU_IRQ_SigSet);										/* Clear signal set.																	*/
+    sigaddset(&CPU_IRQ_SigSet, CPU_IRQ_SIG);							/* Add CPU IRQ Signal to the set.														*/
+
+    memset(&sig_action_trigger, 0, sizeof(sig_action_trigger));			/* Clear sigaction structure memory.													*/
+
+    ERROR_CHECK(sigemptyset(&sig_action_trigger.sa_mask));				/* Don't block other signals while handling.											*/
+
+    sig_action_trigger.sa_flags   = SA_NODEFER | SA_RESTART;
+    sig_action_trigger.sa_handler = CPU_IRQ_Handler;					/* Set the signal handler.																*/
+
+    ERROR_CHECK(sigaction(CPU_IRQ_SIG, &sig_action_trigger, NULL));		/* Connect signal occurrence to its sigaction struct.									*/
+}
+
+/*
+ * Function:  CPU_SR_Save
+ * --------------------------------
+ * Save the interrupt status and disable the interrupts.
+ *
+ * Returns	:	The interrupt status before the call, 1 if it was disabled.
+ */
+CPU_tSR CPU_SR_Save (void)
+{
+	CPU_tSR cpu_sr;
+
+	cpu_sr          = (CPU_tSR)CPU_IntDisabled;
+	CPU_IntDisabled = 1;
+	__atomic_signal_fence(__ATOMIC_SEQ_CST);							/* Keep the critical section code after the mask.										*/
+
+	return (cpu_sr);
+}
+
+/*
+ * Function:  CPU_SR_Restore
+ * --------------------------------
+ * Restore the interrupt status, And service the ticks which came while the interrupts were disabled.
+ *
+ * Arguments:	cpu_sr		is the interrupt status returned by CPU_SR_Save().
+ */
+void CPU_SR_Restore (CPU_tSR cpu_sr)
+{
+	__atomic_signal_fence(__ATOMIC_SEQ_CST);							/* Keep the critical section code before the unmask.									*/
+	CPU_IntDisabled = (sig_atomic_t)cpu_sr;
+	__atomic_signal_fence(__ATOMIC_SEQ_CST);
+
+	if ((cpu_sr == 0U) && (CPU_IntPending != 0U))						/* Any tick came while disabled ?														*/
+	{
+		CPU_IRQ_Dispatch();												/* ... Yes, Service it now as the hardware does at the unmask.							*/
+	}
+}
+
+/*
+ * Function:  CPU_IRQ_Handler
+ * --------------------------------
+ * CPU_IRQ_SIG signal handler.
+ *
+ * Arguments:	sig		is the signal number which invoked this handler ( i.e CPU_IRQ_SIG ).
+ *
+ */
+static void CPU_IRQ_Handler (int sig)
+{
+	int	errno_saved;
+	int	overrun;
+
+	(void)sig;
+
+	errno_saved = errno;												/* errno belongs to the interrupted task.												*/
+
+	overrun = timer_getoverrun(CPU_Timer);								/* The ticks which are merged into this signal are counted too.							*/
+	if (overrun < 0)
+	{
+		overrun = 0;
+	}
+	__atomic_add_fetch(&CPU_IntPending, (CPU_t32U)overrun + 1U, __ATOMIC_RELAXED);
+
+	CPU_TickCount += (CPU_t64U)overrun + 1U;							/* The lateness is measured from the expiry of the last merged tick.					*/
+	CPU_TickLatenessRecord(OS_CPU_TimestampGet() - (CPU_TickStart + ((CPU_TickCount * 1000000000ULL) / OS_CONFIG_TICKS_PER_SEC)),
+						   (CPU_t64U)overrun);
+
+	if (CPU_IntDisabled == 0)											/* Pend it if the interrupted code is in a critical section.							*/
+	{
+		CPU_IRQ_Dispatch();
+	}
+
+	errno = errno_saved;
+}
+
+/*
+ * Function:  CPU_TickLatenessRecord
+ * --------------------------------
+ * Add a tick to the tick lateness statistics. It's called from the signal handler.
+ *
+ * Arguments:	lateness	is the time in nanoseconds from the tick expiry till the signal handler.
+ * 				missed		is the number of the earlier ticks which are merged into this signal.
+ */
+static void CPU_TickLatenessRecord (CPU_t64U lateness, CPU_t64U missed)
+{
+	CPU_t32U	bucket;
+
+	if ((CPU_t64S)lateness < 0)											/* Expired, But the clock is read a bit before the timer's own.							*/
+	{
+		lateness = 0U;
+	}
+
+	bucket = 0U;
+	if (lateness > 0U)
+	{
+		bucket = 63U - (CPU_t32U)__builtin_clzll(lateness);				/* floor(log2(lateness))																*/
+		if (bucket >= CPU_CONFIG_TICK_LATENESS_BUCKETS)
+		{
+			bucket = CPU_CONFIG_TICK_LATENESS_BUCKETS - 1U;
+		}
+	}
+
+	if ((CPU_TickLateness.ticks == 0U) || (lateness < CPU_TickLateness.min))
+	{
+		CPU_TickLateness.min = lateness;
+	}
+	if (lateness > CPU_TickLateness.max)
+	{
+		CPU_TickLateness.max = lateness;
+	}
+	CPU_TickLateness.sum    += lateness;
+	CPU_TickLateness.missed += missed;
+	++CPU_TickLateness.ticks;
+	++CPU_TickLateness.hist[bucket];
+}
+
+/*
+ * Function:  CPU_IRQ_Dispatch
+ * --------------------------------
+ * Service the pending ticks with the interrupts disabled. It's called with the interrupts enabled.
+ *
+ * Note(s)	:	1)	The tick ISR may switch to another task, The loop continues when this task is switched in again.
+ */
+static void CPU_IRQ_Dispatch (void)
+{
+	do {
+		CPU_IntDisabled = 1;											/* The ISR can't be interrupted by itself, Like a single priority level.				*/
+		__atomic_signal_fence(__ATOMIC_SEQ_CST);
+
+		while (CPU_IntPending != 0U)
+		{
+			__atomic_sub_fetch(&CPU_IntPending, 1U, __ATOMIC_RELAXED);
+			OS_CPU_SystemTimerHandler();
+		}
+
+		__atomic_signal_fence(__ATOMIC_SEQ_CST);
+		CPU_IntDisabled = 0;
+		__atomic_signal_fence(__ATOMIC_SEQ_CST);
+	} while (CPU_IntPending != 0U);										/* A tick came just before the interrupts are enabled.									*/
+}
+
+/*
+*******************************************************************************
+*                           	Hook Functions	   							  *
+*******************************************************************************
+*/
+
+/*
+ * Function:  OS_CPU_Hook_Init
+ * --------------------------------
+ * This function is called at the beginning of OS_Init().
+ *
+ * Note(s)	:	1)	Interrupts should be disabled during this call.
+ *
+ */
+void OS_CPU_Hook_Init (void)
+{
+    CPU_InterruptInit();
+#if (OS_CONFIG_CPU_SOFT_STK_OVERFLOW_DETECTION == OS_CONFIG_ENABLE)
+    CPU_StackGuardInit();													/* The tasks run on the main thread, So it takes the alternate stack.	*/
+#endif
+}
+
+/*
+ * Function:  OS_CPU_Hook_TaskCreated
+ * --------------------------------
+ * This function is called when a task is created. The task context is already on its stack.
+ *
+ * Arguments:	ptcb	is a Pointer to the task TCB of the task being created.
+ */
+void OS_CPU_Hook_TaskCreated (OS_TASK_TCB*	ptcb)
+{
+	(void)ptcb;
+#if (OS_CONFIG_CPU_SOFT_STK_OVERFLOW_DETECTION == OS_CONFIG_ENABLE)
+	CPU_StackGuardBind(ptcb);
+#endif
+#if (OS_CONFIG_TASK_STACK_USAGE_EN == OS_CONFIG_ENABLE)
+	CPU_StackRegionSet(ptcb);							/* The kernel measures the stack which the task runs on.				*/
+#endif
+}
+
+/*
+ * Function:  OS_CPU_Hook_TaskDeleted
+ * --------------------------------
+ * This function is called when a task is deleted. Only its stack guard is released, The kernel never switches to it again.
+ *
+ * Arguments:	ptcb	is a Pointer to the task TCB of the task being deleted.
+ */
+void OS_CPU_Hook_TaskDeleted (OS_TASK_TCB*	ptcb)
+{
+#if (OS_CONFIG_CPU_SOFT_STK_OVERFLOW_DETECTION == OS_CONFIG_ENABLE)
+	CPU_StackGuardRelease(ptcb);
+#else
+	(void)ptcb;
+#endif
+}
+
+/*
+ * Function:  OS_CPU_Hook_Idle
+ * --------------------------------
+ * This function is called by the OS_IdleTask(). It halts the host thread till the next tick, Like a WFI instruction.
+ *
+ * Note(s)	:	1)	The signal is blocked around the check, So a tick which comes before the wait is not missed.
+ * 				2)	The time blocked in sigsuspend() is runtime of the idle task, Which the statistics task counts as idle.
+ */
+void OS_CPU_Hook_Idle (void)
+{
+	sigset_t	sig_set_old;
+
+	ERROR_CHECK(sigprocmask(SIG_BLOCK, &CPU_IRQ_SigSet, &sig_set_old));
+
+	if (CPU_IntPending == 0U)
+	{
+		sigsuspend(&sig_set_old);										/* Returns after the handler, Which may have run other tasks meanwhile.					*/
+	}
+
+	ERROR_CHECK(sigprocmask(SIG_SETMASK, &sig_set_old, NULL));
+}
+
+void OS_CPU_Hook_ContextSwitch (void)
+{
+
+}
+
+void OS_CPU_Hook_TimeTick (void)
+{
+
+}
+
+/*
+*******************************************************************************
+*                          OS_CPU_* Functions	   							  *
+*******************************************************************************
+*/
+
+/*
+ * Function:  OS_CPU_TaskStackInit
+ * --------------------
+ * Build the first context of the task on its stack, Such that switching to it calls CPU_TaskStart().
+ *
+ * Arguments:
+ *          TASK_Handler            is a function pointer to the task code.
+ *          params                  is a pointer to the user supplied data which is passed to the task.
+ *          pStackBase              is a pointer to the bottom of the task stack.
+ *          stackSize               is the task stack size in bytes.
+ *
+ * Returns: The saved stack pointer of the task (or its ucontext_t if the switch is done by swapcontext()).
+ *
+ * Notes:   1) The task entry and argument are read from the TCB at the first switch.
+ *          2) A stack smaller than CPU_CONFIG_TASK_STACK_MIN_BYTES is replaced by a host stack.
+ *          3) The lowest page of the stack is the guard page if OS_CONFIG_CPU_SOFT_STK_OVERFLOW_DETECTION is enabled.
+ */
+CPU_tSTK* OS_CPU_TaskStackInit(void (*TASK_Handler)(void* params),
+                             	 void *params,
+								 CPU_tSTK* pStackBase,
+								 CPU_tSTK_SIZE  stackSize)
+{
+	CPU_t08U*	pBottom;
+	uintptr_t	top;
+
+	(void)TASK_Handler;
+	(void)params;
+
+	pBottom = (CPU_t08U*)pStackBase;
+	if (stackSize < CPU_CONFIG_TASK_STACK_MIN_BYTES)
+	{
+		pBottom   = (CPU_t08U*)CPU_HostStackGet(pStackBase);
+		stackSize = CPU_CONFIG_TASK_STACK_MIN_BYTES;
+	}
+
+	top = ((uintptr_t)pBottom + stackSize) & ~(uintptr_t)0xFU;			/* The x86-64 and AArch64 ABIs require a 16 bytes aligned stack.						*/
+#if (OS_CONFIG_CPU_SOFT_STK_OVERFLOW_DETECTION == OS_CONFIG_ENABLE)
+	pBottom = CPU_StackGuardSet(pStackBase, pBottom, stackSize);		/* The task can't grow below the guard page.											*/
+#endif
+
+#if (CPU_SWITCH_ASM == 1U)
+	{
+		CPU_t64U* sp = (CPU_t64U*)top;
+
+		*(--sp) = (CPU_t64U)(uintptr_t)CPU_TaskEntry;					/* Return address of CPU_ContextSwap(). 												*/
+		*(--sp) = 0U;													/* RBP																					*/
+		*(--sp) = 0U;													/* RBX																					*/
+		*(--sp) = 0U;													/* R12																					*/
+		*(--sp) = 0U;													/* R13																					*/
+		*(--sp) = 0U;													/* R14																					*/
+		*(--sp) = 0U;													/* R15																					*/
+
+		return ((CPU_tSTK*)sp);
+	}
+#else
+	{
+		ucontext_t* puc = (ucontext_t*)((top - sizeof(ucontext_t)) & ~(uintptr_t)0xFU);	/* The context is kept at the top of the stack.						*/
+
+		CPU_TaskContextMake(puc, pBottom);
+
+		return ((CPU_tSTK*)puc);
+	}
+#endif
+}
+
+#if (CPU_SWITCH_ASM == 0U)
+/*
+ * Function:  CPU_TaskContextMake
+ * --------------------
+ * Make a context which calls CPU_TaskStart() on the stack from pBottom till the context itself.
+ *
+ * Arguments:
+ *          puc                     is a pointer to the context, It's kept at the top of the stack.
+ *          pBottom                 is a pointer to the lowest usable byte of the stack.
+ *
+ * Returns: None.
+ *
+ * Notes:   1) It's a separate function since getcontext() returns twice, The locals of its caller which are
+ *             assigned before the call might be clobbered.
+ */
+static void CPU_TaskContextMake (ucontext_t* puc, CPU_t08U* pBottom)
+{
+	ERROR_CHECK(getcontext(puc));
+	puc->uc_stack.ss_sp   = pBottom;
+	puc->uc_stack.ss_size = (size_t)((CPU_t08U*)puc - pBottom);
+	puc->uc_link          = NULL;
+	sigemptyset(&puc->uc_sigmask);
+	makecontext(puc, CPU_TaskStart, 0);
+}
+#endif
+
+/*
+ * Function:  OS_CPU_SystemTimerHandler
+ * --------------------
+ * Handle the system tick interrupt which is used for signaling the system tick
+ * to OS_TimerTick().
+ *
+ * Arguments    : None.
+ *
+ * Returns      : None.
+ */
+void OS_CPU_SystemTimerHandler  (void)
+{
+    CPU_SR_ALLOC();
+
+    OS_CRTICAL_BEGIN();
+
+    OS_IntEnter();          												/* Notify that we are entering an ISR.         		 					*/
+
+    OS_CRTICAL_END();
+
+    OS_TimerTick();         												/* Signal the tick to the OS_timerTick().       						*/
+
+    OS_IntExit();           												/* Notify that we are leaving the ISR.          						*/
+}
+
+/*
+ * Function:  OS_CPU_SystemTimerSetup
+ * --------------------
+ * Initialize the POSIX timer which sends the tick signal every 1/OS_CONFIG_TICKS_PER_SEC.
+ *
+ * Arguments    :   ticks   is the number of ticks count between two OS tick interrupts. (not used)
+ *
+ * Returns      :   None.
+ *
+ * Note(s)      :   1) The first expiry is an absolute time and the period is kept by the host kernel, So the ticks don't drift.
+ */
+void  OS_CPU_SystemTimerSetup (CPU_t32U ticks)
+{
+	struct sigevent		sig_event;
+	struct itimerspec	period;
+
+	(void)ticks;
+
+	memset(&sig_event, 0, sizeof(sig_event));
+	sig_event.sigev_notify = SIGEV_SIGNAL;
+	sig_event.sigev_signo  = CPU_IRQ_SIG;
+
+	ERROR_CHECK(timer_create(CLOCK_MONOTONIC, &sig_event, &CPU_Timer));
+
+	period.it_interval.tv_sec  = (time_t)(1U / OS_CONFIG_TICKS_PER_SEC);
+	period.it_interval.tv_nsec = (long)((1000000000ULL / OS_CONFIG_TICKS_PER_SEC) % 1000000000ULL);
+	CPU_TickStart              = OS_CPU_TimestampGet();
+	CPU_TickCount              = 0U;
+	period.it_value.tv_sec     = (time_t)((CPU_TickStart + (1000000000ULL / OS_CONFIG_TICKS_PER_SEC)) / 1000000000ULL);
+	period.it_value.tv_nsec    = (long)((CPU_TickStart + (1000000000ULL / OS_CONFIG_TICKS_PER_SEC)) % 1000000000ULL);
+
+	ERROR_CHECK(timer_settime(CPU_Timer, TIMER_ABSTIME, &period, NULL));
+}
+
+void OS_CPU_ContexSwitch (void)
+{
+	CPU_ContextSwitch();
+}
+
+void OS_CPU_InterruptContexSwitch (void)
+{
+    if(OS_nextTask != OS_currentTask)       								/* No context switch is required if the current task is the highest.    */
+    {
+    	CPU_ContextSwitch();												/* The preempted task resumes in its signal handler.					*/
+    }
+}
+
+void OS_CPU_FirstStart (void)
+{
+    OS_CPU_Hook_ContextSwitch();											/* Call Task Context Switch Hook.										*/
+
+    OS_currentTask = OS_nextTask;											/* Since it's the first Context Switch, OS_currentTask should be NULL.	*/
+
+    OS_Running	= OS_TRUE;													/* Active OS_Running state.												*/
+
+#if (CPU_SWITCH_ASM == 1U)
+    CPU_ContextSwap(&CPU_MainSP, OS_currentTask->TASK_SP);					/* main() is never switched in again.									*/
+#else
+    ERROR_CHECK(swapcontext(&CPU_MainContext, (ucontext_t*)OS_currentTask->TASK_SP));
+#endif
+}
+
+/*
+ * Function:  OS_CPU_TimestampGet
+ * --------------------
+ * Read the monotonic clock of the host.
+ *
+ * Arguments    :   None.
+ *
+ * Returns      :   The monotonic time in nanoseconds.
+ */
+CPU_t64U OS_CPU_TimestampGet (void)
+{
+	struct timespec ts;
+
+	ERROR_CHECK(clock_gettime(CLOCK_MONOTONIC, &ts));
+
+	return (((CPU_t64U)ts.tv_sec * 1000000000ULL) + (CPU_t64U)ts.tv_nsec);
+}
+
+/*
+ * Function:  OS_CPU_TickLatenessGet
+ * --------------------
+ * Get the statistics of the tick lateness.
+ *
+ * Arguments    :   pLateness   is a pointer to the statistics to be filled.
+ *
+ * Returns      :   None.
+ */
+void OS_CPU_TickLatenessGet (CPU_TICK_LATENESS* pLateness)
+{
+	sigset_t	old;
+
+	if (pLateness == OS_NULL(CPU_TICK_LATENESS))
+	{
+		return;
+	}
+
+	ERROR_CHECK(sigprocmask(SIG_BLOCK, &CPU_IRQ_SigSet, &old));			/* Not torn by a tick in the middle of the copy.						*/
+	*pLateness = CPU_TickLateness;
+	ERROR_CHECK(sigprocmask(SIG_SETMASK, &old, NULL));
+}
+
+/*
+ * Function:  OS_CPU_TickLatenessReset
+ * --------------------
+ * Clear the statistics of the tick lateness.
+ *
+ * Arguments    :   None.
+ *
+ * Returns      :   None.
+ */
+void OS_CPU_TickLatenessReset (void)
+{
+	sigset_t	old;
+
+	ERROR_CHECK(sigprocmask(SIG_BLOCK, &CPU_IRQ_SigSet, &old));
+	memset(&CPU_TickLateness, 0, sizeof(CPU_TickLateness));
+	ERROR_CHECK(sigprocmask(SIG_SETMASK, &old, NULL));
+}
+
+/*
+*******************************************************************************
+*                          		Local Functions	   							  *
+*******************************************************************************
+*/
+
+/*
+ * Function:  CPU_ContextSwitch
+ * --------------------
+ * Switch from OS_currentTask to OS_nextTask. It's called with the interrupts disabled, And returns when
+ * the switched-out task is switched in again. Then it enables the interrupts as part of its critical section end.
+ */
+static void CPU_ContextSwitch (void)
+{
+	OS_TASK_TCB*	ptcb_old;
+
+	OS_CPU_Hook_ContextSwitch();											/* Call Task Context Switch Hook.										*/
+
+	ptcb_old       = OS_currentTask;
+	OS_currentTask = OS_nextTask;											/* Set the next scheduled task to be the current.				 		*/
+
+#if (CPU_SWITCH_ASM == 1U)
+	CPU_ContextSwap(&ptcb_old->TASK_SP, OS_currentTask->TASK_SP);
+#else
+	ERROR_CHECK(swapcontext((ucontext_t*)ptcb_old->TASK_SP, (ucontext_t*)OS_currentTask->TASK_SP));
+#endif
+}
+
+/*
+ * Function:  CPU_TaskStart
+ * --------------------
+ * The first code of every task, It runs on the task stack after its first switch.
+ *
+ * Note(s)	:	1)	A task starts with the interrupts enabled.
+ */
+void CPU_TaskStart (void)
+{
+	OS_TASK_TCB*	ptcb;
+
+	ptcb = (OS_TASK_TCB*)OS_currentTask;
+
+	CPU_SR_Restore(0U);														/* Enable the interrupts, The ticks which came meanwhile are serviced.	*/
+
+	((void (*)(void *))ptcb->TASK_EntryAddr)(ptcb->TASK_EntryArg);			/* Call the real user task.												*/
+
+	OS_TaskReturn();														/* The task is deleted, Or it yields forever for EDF.					*/
+}
+
+#endif	/* CPU_CONFIG_POSIX_ENGINE == CPU_POSIX_ENGINE_UCONTEXT */
@@ -0,0 +1,285 @@
+/*****************************************************************************
+MIT License
+
+Copyright (c) 2020 Yahia Farghaly Ashour
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+/*
+ * Author   : Yahia Farghaly Ashour
+ *
+ * Purpose  : POSIX Port, Export of the kernel trace records to the Chrome/Perfetto trace JSON format.
+ *
+ * Note(s)	: 1) The format reference:
+ *            		- https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU
+ *
+ * Language:  C
+ */
+
+/*
+*******************************************************************************
+*                               Includes Files                                *
+*******************************************************************************
+*/
+#include  <stdio.h>
+#include "pretty_arch.h"
+#include "../../../../kernel/pretty_os.h"
+
+#if (OS_CONFIG_TRACE_EN == OS_CONFIG_ENABLE)
+
+/*
+*******************************************************************************
+*                               Local Macros                                  *
+*******************************************************************************
+*/
+
+#define TRACE_JSON_PID			(1U)
+#define TRACE_JSON_TID_ISR		(OS_TRACE_TASK_NONE)		/* The track of the ISRs and ticks.				*/
+
+/*
+*******************************************************************************
+*                               Local Variables                               *
+*******************************************************************************
+*/
+
+static OS_TRACE_RECORD	TraceRecords [OS_CONFIG_TRACE_RECORDS];
+static CPU_t64U			TraceStamps  [OS_CONFIG_TRACE_RECORDS];
+static CPU_t08U			TraceTaskNamed [(OS_TRACE_TASK_NONE + 1U) / 8U];
+
+/*
+*******************************************************************************
+*                          		Local Functions	   							  *
+*******************************************************************************
+*/
+
+/*
+ * Function:  TraceEventName
+ * --------------------
+ * Get the display name of a trace event.
+ *
+ * Arguments    : event		is one of OS_TRACE_EV_xxx.
+ *
+ * Returns      : The event name.
+ */
+static const char* TraceEventName (CPU_t08U event)
+{
+	switch(event)
+	{
+		case OS_TRACE_EV_TASK_SWITCH:	return "Switch";
+		case OS_TRACE_EV_TASK_READY:	return "Ready";
+		case OS_TRACE_EV_TICK:			return "Tick";
+		case OS_TRACE_EV_INT_ENTER:		return "ISR";
+		case OS_TRACE_EV_INT_EXIT:		return "ISR";
+		case OS_TRACE_EV_SEM_PEND:		return "SemPend";
+		case OS_TRACE_EV_SEM_POST:		return "SemPost";
+		case OS_TRACE_EV_MUTEX_PEND:	return "MutexPend";
+		case OS_TRACE_EV_MUTEX_POST:	return "MutexPost";
+		case OS_TRACE_EV_MAILBOX_PEND:	return "MailBoxPend";
+		case OS_TRACE_EV_MAILBOX_POST:	return "MailBoxPost";
+		case OS_TRACE_EV_FLAG_PEND:		return "FlagPend";
+		case OS_TRACE_EV_FLAG_POST:		return "FlagPost";
+		case OS_TRACE_EV_MEMORY_GET:	return "MemoryGet";
+		case OS_TRACE_EV_MEMORY_PUT:	return "MemoryPut";
+		default:						return "Unknown";
+	}
+}
+
+/*
+ * Function:  TraceTimePrint
+ * --------------------
+ * Print a time in nanoseconds as the microseconds of the JSON format.
+ *
+ * Arguments    : pFile		is the output file.
+ *
+ * 				  ns		is the time in nanoseconds.
+ *
+ * Returns      : None.
+ */
+static void TraceTimePrint (FILE* pFile, CPU_t64U ns)
+{
+	fprintf(pFile, "%llu.%03llu", ns / 1000ULL, ns % 1000ULL);
+}
+
+/*
+ * Function:  TraceTrackName
+ * --------------------
+ * Write the metadata event naming the track of a task, Once per task.
+ *
+ * Arguments    : pFile		is the output file.
+ *
+ * 				  task		is the task id of a trace record.
+ *
+ * Returns      : None.
+ */
+static void TraceTrackName (FILE* pFile, CPU_t16U task)
+{
+	if(TraceTaskNamed[task / 8U] & (1U << (task % 8U)))
+	{
+		return;
+	}
+	TraceTaskNamed[task / 8U] |= (CPU_t08U)(1U << (task % 8U));
+
+	if(task == TRACE_JSON_TID_ISR)
+	{
+		fprintf(pFile, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%u,\"tid\":%u,\"args\":{\"name\":\"Interrupts\"}}",
+				TRACE_JSON_PID, task);
+	}
+	else
+	{
+		fprintf(pFile, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%u,\"tid\":%u,\"args\":{\"name\":\"Task %u\"}}",
+				TRACE_JSON_PID, task, task);
+		fprintf(pFile, ",\n{\"name\":\"thread_sort_index\",\"ph\":\"M\",\"pid\":%u,\"tid\":%u,\"args\":{\"sort_index\":%u}}",
+				TRACE_JSON_PID, task, task);
+	}
+}
+
+/*
+ * Function:  TraceSlicePrint
+ * --------------------
+ * Write the running slice of a task.
+ *
+ * Arguments    : pFile		is the output file.
+ *
+ * 				  task		is the task id of the switch record which started the slice.
+ *
+ * 				  from		is the start time of the slice relative to the oldest record.
+ *
+ * 				  to		is the end time of the slice relative to the oldest record.
+ *
+ * Returns      : None.
+ */
+static void TraceSlicePrint (FILE* pFile, CPU_t16U task, CPU_t64U from, CPU_t64U to)
+{
+	TraceTrackName(pFile, task);
+	fprintf(pFile, ",\n{\"name\":\"Task %u\",\"ph\":\"X\",\"pid\":%u,\"tid\":%u,\"ts\":", task, TRACE_JSON_PID, task);
+	TraceTimePrint(pFile, from);
+	fprintf(pFile, ",\"dur\":");
+	TraceTimePrint(pFile, to - from);
+	fprintf(pFile, "}");
+}
+
+/*
+*******************************************************************************
+*                          	Functions Implementation                          *
+*******************************************************************************
+*/
+
+/*
+ * Function:  OS_CPU_TraceExport
+ * --------------------
+ * Write the records of the trace buffer as a Chrome/Perfetto trace JSON file.
+ *
+ * Arguments    :   pPath   is the path of the JSON file to be written.
+ *
+ * Returns      :   The number of the exported records, -1 if the file can't be written.
+ *
+ * Note(s)      :   1) The timestamps are in nanoseconds (OS_CPU_TimestampGet()), The oldest record is at time 0.
+ *                  2) The running slice of a task starts at its switch record and ends at the next one. The task
+ *                     running before the oldest switch record is unknown, So no slice is drawn for it.
+ */
+CPU_t32S OS_CPU_TraceExport (const char* pPath)
+{
+	FILE*				pFile;
+	OS_TRACE_RECORD*	prec;
+	CPU_t32U			count;
+	CPU_t32U			idx;
+	CPU_t64U			newest;
+	CPU_t64U			start         = 0U;
+	CPU_t64U			running_since = 0U;
+	CPU_t16U			running       = OS_TRACE_TASK_NONE;
+	CPU_t16U			tid;
+
+	count = OS_TraceDump(TraceRecords, OS_CONFIG_TRACE_RECORDS, &newest);
+
+	pFile = fopen(pPath, "w");
+	if(pFile == NULL)
+	{
+		return (-1);
+	}
+
+	if(count > 0U)														/* Rebuild the times backwards from the newest record.		*/
+	{
+		TraceStamps[count - 1U] = newest;
+		for(idx = count - 1U; idx > 0U; --idx)
+		{
+			TraceStamps[idx - 1U] = TraceStamps[idx] - TraceRecords[idx].tsDelta;
+		}
+		start = TraceStamps[0];
+	}
+
+	for(idx = 0U; idx < sizeof(TraceTaskNamed); ++idx)
+	{
+		TraceTaskNamed[idx] = 0U;
+	}
+
+	fprintf(pFile, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+	fprintf(pFile, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%u,\"args\":{\"name\":\"PrettyOS\"}}", TRACE_JSON_PID);
+
+	for(idx = 0U; idx < count; ++idx)
+	{
+		prec = &TraceRecords[idx];
+
+		switch(prec->event)
+		{
+			case OS_TRACE_EV_TASK_SWITCH:								/* Close the slice of the previous task.				*/
+				if(running != OS_TRACE_TASK_NONE)
+				{
+					TraceSlicePrint(pFile, running, running_since - start, TraceStamps[idx] - start);
+				}
+				running       = prec->task;
+				running_since = TraceStamps[idx];
+				break;
+
+			case OS_TRACE_EV_INT_ENTER:
+			case OS_TRACE_EV_INT_EXIT:
+				TraceTrackName(pFile, TRACE_JSON_TID_ISR);
+				fprintf(pFile, ",\n{\"name\":\"ISR\",\"ph\":\"%s\",\"pid\":%u,\"tid\":%u,\"ts\":",
+						(prec->event == OS_TRACE_EV_INT_ENTER) ? "B" : "E", TRACE_JSON_PID, TRACE_JSON_TID_ISR);
+				TraceTimePrint(pFile, TraceStamps[idx] - start);
+				fprintf(pFile, ",\"args\":{\"nesting\":%u}}", prec->intNesting);
+				break;
+
+			default:													/* An instant event on the track of its task.			*/
+				tid = (prec->event == OS_TRACE_EV_TICK) ? TRACE_JSON_TID_ISR : prec->task;
+				TraceTrackName(pFile, tid);
+				fprintf(pFile, ",\n{\"name\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"pid\":%u,\"tid\":%u,\"ts\":",
+						TraceEventName(prec->event), TRACE_JSON_PID, tid);
+				TraceTimePrint(pFile, TraceStamps[idx] - start);
+				fprintf(pFile, ",\"args\":{\"obj\":\"%p\",\"nesting\":%u}}", prec->pObj, prec->intNesting);
+				break;
+		}
+	}
+
+	if(running != OS_TRACE_TASK_NONE)									/* The last task runs till the newest record.			*/
+	{
+		TraceSlicePrint(pFile, running, running_since - start, TraceStamps[count - 1U] - start);
+	}
+
+	fprintf(pFile, "\n]}\n");
+
+	if(fclose(pFile) != 0)
+	{
+		return (-1);
+	}
+
+	return ((CPU_t32S)count);
+}
+
+#endif